@@ -3,6 +3,7 @@
 #include <future>
 #include <cstdlib>
 #include <gladiapp/gladiapp_rest.hpp>
+#include <gladiapp/gladiapp_job_watcher.hpp>
 #include "../common/apiKeyLoader.hpp"
 
 int main(int ac, char **av)
@@ -67,17 +68,10 @@ int main(int ac, char **av)
         {
             spdlog::info("Transcription job created, ID: {}", transcriptionJobResponse.id);
 
-            std::string status = "";
+            gladiapp::v2::JobWatcher jobWatcher(client);
+            auto transcriptionResult = jobWatcher.watch(transcriptionJobResponse.id, response.audio_metadata.audio_duration).get();
 
-            while (status != "done" && status != "error")
-            {
-                gladiapp::v2::response::TranscriptionResult result = client.getResult(transcriptionJobResponse.id);
-                spdlog::info("Transcription result: {}", result.status);
-                status = result.status;
-                std::this_thread::sleep_for(std::chrono::seconds(5));
-            }
-
-            spdlog::info("Transcription job completed with status: {}", status);
+            spdlog::info("Transcription job completed with status: {}", transcriptionResult.status);
 
             spdlog::info("getting transcription results...");
             gladiapp::v2::request::ListResultsQuery query;
@@ -204,19 +204,14 @@ int main(int ac, char **av)
                 spdlog::error("Callback - Final Transcript: Session ID: {}, message: {}.", finalTranscript.session_id, finalTranscript.error.has_value() ? finalTranscript.error->message.value() : "Unknown error");
             } });
 
-        // Send audio data in chunks
-        constexpr size_t chunkSize = 8000; // e.g., (16khz * 2 bytes / 4) 250ms of audio
-        spdlog::info("Sending audio data in chunks of {} bytes...", chunkSize);
-        // Simulate real-time sending by adding a small delay between chunks
-        for (size_t offset = 0; offset < audioData.size(); offset += chunkSize)
+        // Stream the audio at real-time rate, as a live source would
+        spdlog::info("Streaming {} bytes of audio data...", audioData.size());
+        std::promise<bool> streamed;
+        if (!session->streamAudio(std::move(audioData), {}, [&streamed](bool completed)
+                                  { streamed.set_value(completed); }) ||
+            !streamed.get_future().get())
         {
-            size_t currentChunkSize = std::min(chunkSize, audioData.size() - offset);
-            if (!session->sendAudioBinary(audioData.data() + offset, static_cast<int>(currentChunkSize)))
-            {
-                spdlog::error("Failed to send audio chunk.");
-                break;
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100)); // simulate real-time sending
+            spdlog::error("Failed to send audio chunk.");
         }
         spdlog::info("Finished sending audio data. Waiting for processing to complete...");
         spdlog::info("Sending stop signal to indicate end of audio stream.");
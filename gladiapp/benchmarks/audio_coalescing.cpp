@@ -0,0 +1,102 @@
+/**
+ * Frames per second and CPU per stream of live audio sent as 10 ms chunks, every chunk as its own frame and
+ * then coalesced (AudioCoalescer deadlines on the shared timer wheel, frames handed to a send queue whose
+ * writer only counts them).
+ * Usage: audio_coalescing [streams=100] [seconds=3] [targetMs=100] [maxLatencyMs=20]
+ */
+#include "impl/audio_coalescer.hpp"
+#include "impl/ws_send_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace gladiapp::v2::ws;
+
+namespace
+{
+    constexpr std::size_t CHUNK_MS = 10;
+    constexpr std::size_t BYTES_PER_SECOND = 32000;
+
+    struct Stream
+    {
+        std::unique_ptr<WebsocketSendQueue> queue;
+        std::shared_ptr<AudioCoalescer> coalescer;
+    };
+
+    void run(const char *label, std::size_t streamCount, std::size_t seconds, const CoalescingOptions &coalescing)
+    {
+        std::atomic<std::uint64_t> frames{0};
+        SendQueueOptions queueOptions;
+        queueOptions.capacity = 64;
+
+        std::vector<Stream> streams(streamCount);
+        for (auto &stream : streams)
+        {
+            stream.queue = std::make_unique<WebsocketSendQueue>(queueOptions, [&frames](const WebsocketSendQueue::Frame &)
+                                                                {
+                                                                    ++frames;
+                                                                    return true;
+                                                                });
+            stream.queue->start();
+            if (coalescing.targetMs > 0)
+            {
+                WebsocketSendQueue *queue = stream.queue.get();
+                stream.coalescer = std::make_shared<AudioCoalescer>(coalescing, TimerWheel::shared(), [queue](const uint8_t *data, std::size_t size)
+                                                                    { return queue->enqueue(WebsocketSendQueue::Frame{std::string(reinterpret_cast<const char *>(data), size), CURLWS_BINARY, AudioBuffer{}}); });
+                stream.coalescer->setBytesPerSecond(BYTES_PER_SECOND);
+            }
+        }
+
+        const std::vector<uint8_t> chunk(BYTES_PER_SECOND * CHUNK_MS / 1000, 0x55);
+        const std::size_t ticks = seconds * 1000 / CHUNK_MS;
+        const std::clock_t cpuStart = std::clock();
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t tick = 0; tick < ticks; ++tick)
+        {
+            std::this_thread::sleep_until(start + std::chrono::milliseconds(tick * CHUNK_MS));
+            for (auto &stream : streams)
+            {
+                if (stream.coalescer != nullptr)
+                {
+                    stream.coalescer->add(chunk.data(), chunk.size());
+                }
+                else
+                {
+                    stream.queue->enqueue(WebsocketSendQueue::Frame{std::string(chunk.begin(), chunk.end()), CURLWS_BINARY, AudioBuffer{}});
+                }
+            }
+        }
+        for (auto &stream : streams)
+        {
+            if (stream.coalescer != nullptr)
+            {
+                stream.coalescer->close();
+            }
+            stream.queue->stop();
+        }
+        const double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("%-12s %8.0f frames/s  %6.3f ms CPU per stream-second  (%zu streams, %.2f s)\n", label,
+                    static_cast<double>(frames) / wallSeconds, cpuSeconds * 1000.0 / static_cast<double>(streamCount) / wallSeconds,
+                    streamCount, wallSeconds);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::size_t streams = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    const std::size_t seconds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 3;
+    CoalescingOptions coalescing;
+    coalescing.targetMs = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 100;
+    coalescing.maxLatencyMs = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 20;
+
+    run("uncoalesced", streams, seconds, CoalescingOptions{});
+    run("coalesced", streams, seconds, coalescing);
+    return 0;
+}
@@ -0,0 +1,52 @@
+/**
+ * Throughput of the base64 encoders (AVX2, SSSE3, scalar, those this CPU has) on audio chunk sizes, as sent
+ * by sendAudioJson().
+ * Usage: base64_encode [iterations=200000]
+ */
+#include "impl/base64_encoder.hpp"
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace gladiapp::v2;
+
+int main(int argc, char **argv)
+{
+    const std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    // 10 ms, 100 ms and 1 s of 16 kHz PCM16
+    const std::size_t sizes[] = {320, 3200, 32000};
+
+    for (const char *name : {"scalar", "ssse3", "avx2"})
+    {
+        base64_util::EncodeFunction encode = base64_util::encoderFor(name);
+        if (encode == nullptr)
+        {
+            std::printf("%-7s not available\n", name);
+            continue;
+        }
+        for (std::size_t size : sizes)
+        {
+            std::vector<std::uint8_t> input(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                input[i] = static_cast<std::uint8_t>(i * 131 + 7);
+            }
+            std::vector<char> out(base64_util::encodedLength(size));
+            // fewer rounds for the larger chunks, about the same number of bytes each
+            const std::size_t rounds = std::max<std::size_t>(iterations * 320 / size, 1);
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t round = 0; round < rounds; ++round)
+            {
+                encode(input.data(), size, out.data());
+                // keep the encoding from being optimized away
+                input[round % size] ^= static_cast<std::uint8_t>(out[round % out.size()]);
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::printf("%-7s %6zu bytes  %8.1f ns/chunk  %8.1f MB/s\n", name, size, seconds * 1e9 / static_cast<double>(rounds),
+                        static_cast<double>(size) * static_cast<double>(rounds) / seconds / 1e6);
+        }
+    }
+    return 0;
+}
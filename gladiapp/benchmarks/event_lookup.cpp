@@ -0,0 +1,139 @@
+/**
+ * Cost of resolving the "type" of received live messages: the event table lookup used by the session against
+ * the former copy of the type string followed by an if/else chain of string compares, on a mix close to a live
+ * session (60% transcript, 20% audio_chunk, then speech_start/speech_end and the session events).
+ * Usage: event_lookup [iterations=200000]
+ */
+#include "impl/ws_event_table.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace gladiapp::v2::ws;
+
+namespace
+{
+    /**
+     * The lookup as the session did it before the event table, in the same order.
+     */
+    events::EventType eventTypeFromChain(const nlohmann::json &json)
+    {
+        std::string type = json["type"];
+        if (type == events::AUDIO_CHUNK)
+            return events::EventType::AUDIO_CHUNK;
+        else if (type == events::STOP_RECORDING)
+            return events::EventType::STOP_RECORDING;
+        else if (type == events::SPEECH_START)
+            return events::EventType::SPEECH_START;
+        else if (type == events::SPEECH_END)
+            return events::EventType::SPEECH_END;
+        else if (type == events::TRANSCRIPT)
+            return events::EventType::TRANSCRIPT;
+        else if (type == events::TRANSLATION)
+            return events::EventType::TRANSLATION;
+        else if (type == events::NAMED_ENTITY_RECOGNITION)
+            return events::EventType::NAMED_ENTITY_RECOGNITION;
+        else if (type == events::SENTIMENT_ANALYSIS)
+            return events::EventType::SENTIMENT_ANALYSIS;
+        else if (type == events::POST_TRANSCRIPTION)
+            return events::EventType::POST_TRANSCRIPTION;
+        else if (type == events::FINAL_TRANSCRIPTION)
+            return events::EventType::FINAL_TRANSCRIPTION;
+        else if (type == events::CHAPTERIZATION)
+            return events::EventType::CHAPTERIZATION;
+        else if (type == events::SUMMARIZATION)
+            return events::EventType::SUMMARIZATION;
+        else if (type == events::START_SESSION)
+            return events::EventType::START_SESSION;
+        else if (type == events::END_SESSION)
+            return events::EventType::END_SESSION;
+        else if (type == events::START_RECORDING)
+            return events::EventType::START_RECORDING;
+        else if (type == events::END_RECORDING)
+            return events::EventType::END_RECORDING;
+        return events::EventType::UNKNOWN;
+    }
+
+    events::EventType eventTypeFromTable(const nlohmann::json &json)
+    {
+        auto typeField = json.find("type");
+        return events::eventTypeFromName(typeField->get_ref<const std::string &>());
+    }
+
+    /**
+     * 100 messages in a fixed pseudo-random order, so that the branches do not follow a short pattern.
+     */
+    std::vector<nlohmann::json> recordedMix()
+    {
+        const std::pair<const char *, int> counts[] = {
+            {events::TRANSCRIPT, 60},
+            {events::AUDIO_CHUNK, 20},
+            {events::SPEECH_START, 7},
+            {events::SPEECH_END, 7},
+            {events::START_SESSION, 1},
+            {events::START_RECORDING, 1},
+            {events::STOP_RECORDING, 1},
+            {events::END_RECORDING, 1},
+            {events::POST_TRANSCRIPTION, 1},
+            {events::END_SESSION, 1},
+        };
+        std::vector<nlohmann::json> messages;
+        for (const auto &[type, count] : counts)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                messages.push_back({{"session_id", "4a39145c-2844-4557-8f34-34883f7be7d9"},
+                                    {"created_at", "2021-09-01T12:00:00.123Z"},
+                                    {"type", type},
+                                    {"data", nlohmann::json::object()}});
+            }
+        }
+        unsigned state = 12345;
+        for (std::size_t i = messages.size() - 1; i > 0; --i)
+        {
+            state = state * 1103515245u + 12345u;
+            std::swap(messages[i], messages[(state >> 16) % (i + 1)]);
+        }
+        return messages;
+    }
+
+    template <typename Lookup>
+    void measure(const char *name, const std::vector<nlohmann::json> &messages, std::size_t iterations, Lookup lookup)
+    {
+        unsigned checksum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t round = 0; round < iterations; ++round)
+        {
+            for (const auto &message : messages)
+            {
+                checksum += static_cast<unsigned>(lookup(message));
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-22s %6.1f ns/msg  (checksum %u)\n", name,
+                    seconds * 1e9 / static_cast<double>(iterations * messages.size()), checksum);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const std::vector<nlohmann::json> messages = recordedMix();
+
+    for (const auto &message : messages)
+    {
+        if (eventTypeFromChain(message) != eventTypeFromTable(message))
+        {
+            std::fprintf(stderr, "lookups disagree on %s\n", message["type"].get<std::string>().c_str());
+            return 1;
+        }
+    }
+    measure("copy + if/else chain", messages, iterations, eventTypeFromChain);
+    measure("event table", messages, iterations, eventTypeFromTable);
+    return 0;
+}
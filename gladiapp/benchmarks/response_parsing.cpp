@@ -0,0 +1,220 @@
+/**
+ * Parsing of a transcription list from a single JSON document against the former round trip, where every
+ * nested object (file, result, metadata, transcription, utterance, word, subtitle) was dumped back to a string
+ * and parsed again by its own fromJson. The list is built from the fixture, its first utterance repeated to
+ * the requested number of words per result.
+ * Usage: response_parsing <path to transcription_result.json> [words per result=10000] [results=3] [iterations=10]
+ */
+#include "gladiapp_rest_response.hpp"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace gladiapp::v2::response;
+
+namespace
+{
+    using Result = TranscriptionResult::TranscriptionObject::Result;
+    using Utterance = Result::Utterance;
+
+    constexpr std::size_t WORDS_PER_UTTERANCE = 10;
+
+    /**
+     * Moves the member out of the node, so that the node can be handed to fromJsonDocument without it.
+     */
+    nlohmann::json take(nlohmann::json &json, const char *key)
+    {
+        if (!json.contains(key))
+        {
+            return nullptr;
+        }
+        nlohmann::json member = std::move(json[key]);
+        json.erase(key);
+        return member;
+    }
+
+    // the former parsers, one parse per nesting level
+
+    Utterance roundTripUtterance(const std::string &jsonString)
+    {
+        auto json = nlohmann::json::parse(jsonString);
+        auto words = take(json, "words");
+        Utterance utterance = Utterance::fromJsonDocument(json);
+        if (words.is_array())
+        {
+            for (const auto &wordJson : words)
+            {
+                utterance.words.push_back(Utterance::Word::fromJson(wordJson.dump()));
+            }
+        }
+        return utterance;
+    }
+
+    Result roundTripTranscription(const std::string &jsonString)
+    {
+        auto json = nlohmann::json::parse(jsonString);
+        auto utterances = take(json, "utterances");
+        auto subtitles = take(json, "subtitles");
+        Result result = Result::fromJsonDocument(json);
+        if (utterances.is_array())
+        {
+            for (const auto &utteranceJson : utterances)
+            {
+                result.utterances.push_back(roundTripUtterance(utteranceJson.dump()));
+            }
+        }
+        if (subtitles.is_array())
+        {
+            for (const auto &subtitleJson : subtitles)
+            {
+                result.subtitles.push_back(Result::Subtitle::fromJson(subtitleJson.dump()));
+            }
+        }
+        return result;
+    }
+
+    TranscriptionResult::TranscriptionObject roundTripObject(const std::string &jsonString)
+    {
+        auto json = nlohmann::json::parse(jsonString);
+        TranscriptionResult::TranscriptionObject object;
+        if (json.contains("metadata"))
+        {
+            object.metadata = Metadata::fromJson(json["metadata"].dump());
+        }
+        if (json.contains("transcription"))
+        {
+            object.result = roundTripTranscription(json["transcription"].dump());
+        }
+        return object;
+    }
+
+    TranscriptionResult roundTripResult(const std::string &jsonString)
+    {
+        auto json = nlohmann::json::parse(jsonString);
+        auto file = take(json, "file");
+        auto resultJson = take(json, "result");
+        TranscriptionResult result = TranscriptionResult::fromJsonDocument(json);
+        if (file.is_object())
+        {
+            result.file = TranscriptionFile::fromJson(file.dump());
+        }
+        if (resultJson.is_object())
+        {
+            result.result = roundTripObject(resultJson.dump());
+        }
+        return result;
+    }
+
+    TranscriptionListResults roundTripList(const std::string &jsonString)
+    {
+        auto json = nlohmann::json::parse(jsonString);
+        auto items = take(json, "items");
+        TranscriptionListResults results = TranscriptionListResults::fromJsonDocument(json);
+        for (const auto &item : items)
+        {
+            results.items.push_back(roundTripResult(item.dump()));
+        }
+        return results;
+    }
+
+    std::string buildList(const nlohmann::json &fixture, std::size_t wordsPerResult, std::size_t resultCount)
+    {
+        nlohmann::json item = fixture;
+        auto &transcription = item["result"]["transcription"];
+        const nlohmann::json firstUtterance = transcription["utterances"][0];
+        const auto &words = firstUtterance["words"];
+        nlohmann::json utterances = nlohmann::json::array();
+        for (std::size_t written = 0; written < wordsPerResult; written += WORDS_PER_UTTERANCE)
+        {
+            nlohmann::json utterance = firstUtterance;
+            utterance["words"] = nlohmann::json::array();
+            for (std::size_t i = written; i < written + WORDS_PER_UTTERANCE && i < wordsPerResult; ++i)
+            {
+                utterance["words"].push_back(words[i % words.size()]);
+            }
+            utterances.push_back(std::move(utterance));
+        }
+        transcription["utterances"] = std::move(utterances);
+
+        nlohmann::json list = {{"first", "https://api.gladia.io/v2/pre-recorded?offset=0&limit=20"},
+                               {"current", "https://api.gladia.io/v2/pre-recorded?offset=0&limit=20"},
+                               {"next", nullptr},
+                               {"items", nlohmann::json::array()}};
+        for (std::size_t i = 0; i < resultCount; ++i)
+        {
+            list["items"].push_back(item);
+        }
+        return list.dump();
+    }
+
+    std::size_t wordCount(const TranscriptionListResults &results)
+    {
+        std::size_t count = 0;
+        for (const auto &item : results.items)
+        {
+            for (const auto &utterance : item.result.result.utterances)
+            {
+                count += utterance.words.size();
+            }
+        }
+        return count;
+    }
+
+    template <typename Parse>
+    void measure(const char *name, const std::string &body, std::size_t iterations, Parse parse)
+    {
+        std::size_t words = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            words += wordCount(parse(body));
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-26s %8.2f ms/call  (%zu words)\n", name, seconds * 1e3 / static_cast<double>(iterations), words / iterations);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <path to transcription_result.json> [words per result] [results] [iterations]\n", argv[0]);
+        return 2;
+    }
+    std::ifstream file(argv[1]);
+    if (!file)
+    {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 2;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    const std::size_t wordsPerResult = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10000;
+    const std::size_t resultCount = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 3;
+    const std::size_t iterations = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 10;
+
+    const std::string body = buildList(nlohmann::json::parse(content.str()), wordsPerResult, resultCount);
+    std::printf("%zu results of %zu words, %.2f MB\n", resultCount, wordsPerResult, static_cast<double>(body.size()) / 1e6);
+
+    const auto reference = roundTripList(body);
+    const auto single = TranscriptionListResults::fromJsonDocument(nlohmann::json::parse(body));
+    if (wordCount(reference) != wordCount(single) || single.items.size() != resultCount ||
+        single.items.front().result.result.full_transcript != reference.items.front().result.result.full_transcript)
+    {
+        std::fprintf(stderr, "the two parsers disagree\n");
+        return 1;
+    }
+
+    measure("dump/parse round trip", body, iterations, roundTripList);
+    measure("single document", body, iterations, [](const std::string &json)
+            { return TranscriptionListResults::fromJsonDocument(nlohmann::json::parse(json)); });
+#ifdef GLADIAPP_USE_SIMDJSON
+    measure("fromJson (simdjson)", body, iterations, TranscriptionListResults::fromJson);
+#endif
+    return 0;
+}
@@ -14,6 +14,9 @@ namespace gladiapp {
             constexpr const char* PRERECORDED_ENDPOINT = "/v2/pre-recorded";
             constexpr const char* UPLOAD_ENDPOINT = "/v2/upload";
             constexpr const char* LIVE_ENDPOINT = "/v2/live";
+            // regional hosts serving the live sessions' WebSocket URLs
+            constexpr const char* LIVE_HOST_US_WEST = "api.us-west-1.gladia.io";
+            constexpr const char* LIVE_HOST_EU_WEST = "api.eu-west-1.gladia.io";
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gladiapp_export.h"
+#include "gladiapp_ws_request.hpp"
+
+namespace gladiapp
+{
+    namespace v2
+    {
+        namespace audio
+        {
+            /**
+             * Encoding of the audio a live session expects, as negotiated in its InitializeSessionRequest.
+             */
+            struct AudioFormat
+            {
+                enum class Encoding
+                {
+                    PCM,
+                    ALAW,
+                    ULAW
+                };
+                Encoding encoding = Encoding::PCM;
+                /** Bits per sample for PCM (8, 16, 24 or 32), A-law and µ-law are always 8. */
+                int bitDepth = 16;
+                int sampleRate = 16000;
+                int channels = 1;
+
+                static AudioFormat fromSessionRequest(const ws::request::InitializeSessionRequest &request);
+
+                /** Size of one sample of one channel in the encoded stream. */
+                std::size_t bytesPerSample() const;
+
+                std::size_t bytesPerSecond() const;
+            };
+
+            // forward declaration of the actual implementation
+            class AudioConverterImpl;
+
+            /**
+             * Converts captured audio to the format of a live session: float or 16-bit samples are
+             * downmixed to mono (when the session has one channel), resampled with a polyphase filter,
+             * quantized and encoded (little-endian PCM, A-law or µ-law). The resampler keeps its state
+             * between calls so a stream can be converted chunk by chunk. Not thread-safe.
+             * The filter and quantization loops use AVX2 or NEON when available.
+             */
+            class GLADIAPP_EXPORT AudioConverter
+            {
+            public:
+                AudioConverter(const AudioConverter &) = delete;
+                AudioConverter &operator=(const AudioConverter &) = delete;
+
+                /**
+                 * @param inputSampleRate Sample rate of the captured audio, e.g. 48000.
+                 * @param inputChannels Number of interleaved channels of the captured audio.
+                 * @param outputFormat Format of the session, its channel count must be 1 or inputChannels.
+                 * @throws std::invalid_argument for unsupported rates, channel layouts or bit depths.
+                 */
+                AudioConverter(int inputSampleRate, int inputChannels, const AudioFormat &outputFormat);
+                ~AudioConverter();
+
+                /**
+                 * Converts interleaved samples in [-1, 1] and appends the encoded bytes to output.
+                 * @return number of bytes appended, which may be 0 while the resampler fills up.
+                 */
+                std::size_t convert(const float *samples, std::size_t frameCount, std::vector<uint8_t> &output);
+
+                /**
+                 * Same for interleaved 16-bit samples.
+                 */
+                std::size_t convert(const int16_t *samples, std::size_t frameCount, std::vector<uint8_t> &output);
+
+                /**
+                 * Drops the resampler history, e.g. before converting an unrelated stream.
+                 */
+                void reset();
+
+                int inputSampleRate() const;
+                int inputChannels() const;
+                const AudioFormat &outputFormat() const;
+
+                /**
+                 * Name of the vector kernels selected for this CPU ("avx2", "neon" or "scalar").
+                 */
+                static const char *kernelName();
+
+            private:
+                std::unique_ptr<AudioConverterImpl> _impl;
+            };
+        }
+    }
+}
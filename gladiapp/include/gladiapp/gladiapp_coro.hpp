@@ -0,0 +1,600 @@
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "gladiapp_coro.hpp requires C++20 coroutines, see the GLADIAPP_ENABLE_COROUTINES CMake option"
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "gladiapp_error.hpp"
+#include "gladiapp_job_watcher.hpp"
+#include "gladiapp_rest.hpp"
+#include "gladiapp_rest_response.hpp"
+#include "gladiapp_ws.hpp"
+
+/**
+ * C++20 awaitables over the asynchronous API: REST requests run on the client's transfer thread, job watches on
+ * the watcher thread and live events come from the session's event stream, so that any number of them can be
+ * awaited without a thread each.
+ *
+ * A coroutine resumes on the thread completing the operation awaited, as a callback would run there: the code up
+ * to its next co_await must not block, and must not call syncWait().
+ */
+namespace gladiapp
+{
+    namespace v2
+    {
+        namespace coro
+        {
+            template <typename T = void>
+            class Task;
+
+            namespace detail
+            {
+                struct TaskPromiseBase
+                {
+                    struct FinalAwaiter
+                    {
+                        bool await_ready() const noexcept
+                        {
+                            return false;
+                        }
+
+                        template <typename Promise>
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+                        {
+                            return handle.promise().continuation;
+                        }
+
+                        void await_resume() const noexcept
+                        {
+                        }
+                    };
+
+                    std::suspend_always initial_suspend() const noexcept
+                    {
+                        return {};
+                    }
+
+                    FinalAwaiter final_suspend() const noexcept
+                    {
+                        return {};
+                    }
+
+                    void unhandled_exception() noexcept
+                    {
+                        exception = std::current_exception();
+                    }
+
+                    std::coroutine_handle<> continuation = std::noop_coroutine();
+                    std::exception_ptr exception;
+                };
+
+                template <typename T>
+                struct TaskPromise : TaskPromiseBase
+                {
+                    Task<T> get_return_object() noexcept;
+
+                    template <typename U>
+                    void return_value(U &&result)
+                    {
+                        value.emplace(std::forward<U>(result));
+                    }
+
+                    T result()
+                    {
+                        if (exception)
+                        {
+                            std::rethrow_exception(exception);
+                        }
+                        return std::move(*value);
+                    }
+
+                    std::optional<T> value;
+                };
+
+                template <>
+                struct TaskPromise<void> : TaskPromiseBase
+                {
+                    Task<void> get_return_object() noexcept;
+
+                    void return_void() const noexcept
+                    {
+                    }
+
+                    void result()
+                    {
+                        if (exception)
+                        {
+                            std::rethrow_exception(exception);
+                        }
+                    }
+                };
+
+                /**
+                 * Coroutine started right away and destroyed once it returns, nobody awaits it.
+                 */
+                struct DetachedTask
+                {
+                    struct promise_type
+                    {
+                        DetachedTask get_return_object() const noexcept
+                        {
+                            return {};
+                        }
+
+                        std::suspend_never initial_suspend() const noexcept
+                        {
+                            return {};
+                        }
+
+                        std::suspend_never final_suspend() const noexcept
+                        {
+                            return {};
+                        }
+
+                        void return_void() const noexcept
+                        {
+                        }
+
+                        void unhandled_exception() const noexcept
+                        {
+                            std::terminate();
+                        }
+                    };
+                };
+
+                /**
+                 * Resumes the awaiting coroutine from the callback completing an operation, which may be invoked
+                 * before the operation is even started, e.g. when the transfer engine is shutting down.
+                 */
+                class Resumption
+                {
+                protected:
+                    /**
+                     * Starts the operation; false if it already completed, the coroutine then goes on.
+                     */
+                    template <typename Start>
+                    bool suspend(std::coroutine_handle<> handle, Start &&start)
+                    {
+                        _handle = handle;
+                        start();
+                        // the awaiter may be gone as soon as the exchange is done
+                        return _state.exchange(State::SUSPENDED, std::memory_order_acq_rel) != State::COMPLETED;
+                    }
+
+                    void resume()
+                    {
+                        if (_state.exchange(State::COMPLETED, std::memory_order_acq_rel) == State::SUSPENDED)
+                        {
+                            _handle.resume();
+                        }
+                    }
+
+                private:
+                    enum class State
+                    {
+                        STARTING,
+                        SUSPENDED,
+                        COMPLETED
+                    };
+
+                    std::coroutine_handle<> _handle;
+                    std::atomic<State> _state{State::STARTING};
+                };
+
+                /**
+                 * Awaitable over a callback-based call: start(*this) issues it with complete() as its callback.
+                 */
+                template <typename T, typename Start>
+                class Operation : private Resumption
+                {
+                public:
+                    Operation(Start start, response::TranscriptionError *transcriptionError)
+                        : _start(std::move(start)), _transcriptionError(transcriptionError)
+                    {
+                    }
+
+                    bool await_ready() const noexcept
+                    {
+                        return false;
+                    }
+
+                    bool await_suspend(std::coroutine_handle<> handle)
+                    {
+                        return suspend(handle, [this]()
+                                       { _start(*this); });
+                    }
+
+                    T await_resume()
+                    {
+                        if (_transcriptionError != nullptr)
+                        {
+                            *_transcriptionError = std::move(_error);
+                        }
+                        if constexpr (!std::is_void_v<T>)
+                        {
+                            return std::move(_value);
+                        }
+                    }
+
+                    template <typename... Value>
+                    void complete(const response::TranscriptionError &error, Value &&...value)
+                    {
+                        if constexpr (!std::is_void_v<T>)
+                        {
+                            _value = T(std::forward<Value>(value)...);
+                        }
+                        _error = error;
+                        resume();
+                    }
+
+                private:
+                    using Storage = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+                    Start _start;
+                    response::TranscriptionError *_transcriptionError;
+                    Storage _value{};
+                    response::TranscriptionError _error;
+                };
+
+                template <typename T, typename Start>
+                Operation<T, Start> makeOperation(Start start, response::TranscriptionError *transcriptionError)
+                {
+                    return Operation<T, Start>(std::move(start), transcriptionError);
+                }
+            }
+
+            /**
+             * Lazily started coroutine producing a T: it runs once co_awaited, and resumes its awaiter when done.
+             * Exceptions escaping it are rethrown to the awaiter.
+             */
+            template <typename T>
+            class Task
+            {
+            public:
+                using promise_type = detail::TaskPromise<T>;
+
+                Task(Task &&other) noexcept
+                    : _handle(std::exchange(other._handle, {}))
+                {
+                }
+
+                Task &operator=(Task &&other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        if (_handle)
+                        {
+                            _handle.destroy();
+                        }
+                        _handle = std::exchange(other._handle, {});
+                    }
+                    return *this;
+                }
+
+                Task(const Task &) = delete;
+                Task &operator=(const Task &) = delete;
+
+                ~Task()
+                {
+                    if (_handle)
+                    {
+                        _handle.destroy();
+                    }
+                }
+
+                auto operator co_await() noexcept
+                {
+                    struct Awaiter
+                    {
+                        std::coroutine_handle<promise_type> handle;
+
+                        bool await_ready() const noexcept
+                        {
+                            return handle.done();
+                        }
+
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept
+                        {
+                            handle.promise().continuation = awaiting;
+                            return handle;
+                        }
+
+                        T await_resume() const
+                        {
+                            return handle.promise().result();
+                        }
+                    };
+                    return Awaiter{_handle};
+                }
+
+            private:
+                friend promise_type;
+
+                explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+                    : _handle(handle)
+                {
+                }
+
+                std::coroutine_handle<promise_type> _handle;
+            };
+
+            template <typename T>
+            Task<T> detail::TaskPromise<T>::get_return_object() noexcept
+            {
+                return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+            }
+
+            inline Task<void> detail::TaskPromise<void>::get_return_object() noexcept
+            {
+                return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+            }
+
+            /**
+             * Runs a task to completion, blocking the calling thread: the entry point of the coroutines from
+             * synchronous code. Rethrows the task's exception.
+             */
+            template <typename T>
+            T syncWait(Task<T> task)
+            {
+                std::mutex mutex;
+                std::condition_variable condition;
+                bool done = false;
+                std::optional<std::conditional_t<std::is_void_v<T>, std::monostate, T>> result;
+                std::exception_ptr exception;
+
+                auto run = [&]() -> detail::DetachedTask
+                {
+                    try
+                    {
+                        if constexpr (std::is_void_v<T>)
+                        {
+                            co_await task;
+                            result.emplace();
+                        }
+                        else
+                        {
+                            result.emplace(co_await task);
+                        }
+                    }
+                    catch (...)
+                    {
+                        exception = std::current_exception();
+                    }
+                    // notified under the lock: the waiter destroys the condition as soon as it sees done
+                    std::lock_guard<std::mutex> lock(mutex);
+                    done = true;
+                    condition.notify_one();
+                };
+                run();
+
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&done]()
+                               { return done; });
+                if (exception)
+                {
+                    std::rethrow_exception(exception);
+                }
+                if constexpr (!std::is_void_v<T>)
+                {
+                    return std::move(*result);
+                }
+            }
+
+            /**
+             * Runs the tasks concurrently, e.g. one per file to upload, and returns their results in the same
+             * order once all of them are done. The first exception thrown by one of them is rethrown.
+             */
+            template <typename T>
+            Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks)
+            {
+                struct State
+                {
+                    // one count per task, plus one released by the awaiting coroutine once suspended
+                    std::atomic<std::size_t> remaining{0};
+                    std::coroutine_handle<> awaiting;
+                    std::vector<std::optional<T>> results;
+                    std::mutex exceptionMutex;
+                    std::exception_ptr exception;
+
+                    void release()
+                    {
+                        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        {
+                            awaiting.resume();
+                        }
+                    }
+                };
+
+                struct Awaiter
+                {
+                    std::vector<Task<T>> &tasks;
+                    State &state;
+
+                    static detail::DetachedTask run(Task<T> &task, State &state, std::size_t index)
+                    {
+                        try
+                        {
+                            state.results[index].emplace(co_await task);
+                        }
+                        catch (...)
+                        {
+                            std::lock_guard<std::mutex> lock(state.exceptionMutex);
+                            if (!state.exception)
+                            {
+                                state.exception = std::current_exception();
+                            }
+                        }
+                        state.release();
+                    }
+
+                    bool await_ready() const noexcept
+                    {
+                        return tasks.empty();
+                    }
+
+                    bool await_suspend(std::coroutine_handle<> handle)
+                    {
+                        state.awaiting = handle;
+                        state.remaining = tasks.size() + 1;
+                        for (std::size_t i = 0; i < tasks.size(); ++i)
+                        {
+                            run(tasks[i], state, i);
+                        }
+                        return state.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+                    }
+
+                    void await_resume() const noexcept
+                    {
+                    }
+                };
+
+                State state;
+                state.results.resize(tasks.size());
+                co_await Awaiter{tasks, state};
+                if (state.exception)
+                {
+                    std::rethrow_exception(state.exception);
+                }
+                std::vector<T> results;
+                results.reserve(tasks.size());
+                for (auto &result : state.results)
+                {
+                    results.push_back(std::move(*result));
+                }
+                co_return results;
+            }
+
+            /**
+             * REST requests, resumed on the client's transfer thread. Like the synchronous calls, failures are
+             * reported through transcriptionError (when given) rather than thrown.
+             */
+            inline auto upload(const GladiaRestClient &client, const std::string &filePath,
+                               response::TranscriptionError *transcriptionError = nullptr)
+            {
+                auto start = [&client, filePath](auto &operation)
+                {
+                    client.uploadAsync(filePath, [&operation](const response::UploadResponse &response, const response::TranscriptionError &error)
+                                       { operation.complete(error, response); });
+                };
+                return detail::makeOperation<response::UploadResponse>(std::move(start), transcriptionError);
+            }
+
+            inline auto preRecorded(const GladiaRestClient &client, const request::TranscriptionRequest &transcriptionRequest,
+                                    response::TranscriptionError *transcriptionError = nullptr)
+            {
+                auto start = [&client, transcriptionRequest](auto &operation)
+                {
+                    client.preRecordedAsync(transcriptionRequest, [&operation](const response::TranscriptionJobResponse &response, const response::TranscriptionError &error)
+                                            { operation.complete(error, response); });
+                };
+                return detail::makeOperation<response::TranscriptionJobResponse>(std::move(start), transcriptionError);
+            }
+
+            inline auto getResult(const GladiaRestClient &client, const std::string &id,
+                                  response::TranscriptionError *transcriptionError = nullptr)
+            {
+                auto start = [&client, id](auto &operation)
+                {
+                    client.getResultAsync(id, [&operation](const response::TranscriptionResult &result, const response::TranscriptionError &error)
+                                          { operation.complete(error, result); });
+                };
+                return detail::makeOperation<response::TranscriptionResult>(std::move(start), transcriptionError);
+            }
+
+            inline auto getResults(const GladiaRestClient &client, const request::ListResultsQuery &query,
+                                   response::TranscriptionError *transcriptionError = nullptr)
+            {
+                auto start = [&client, query](auto &operation)
+                {
+                    client.getResultsAsync(query, [&operation](const response::TranscriptionListResults &results, const response::TranscriptionError &error)
+                                           { operation.complete(error, results); });
+                };
+                return detail::makeOperation<response::TranscriptionListResults>(std::move(start), transcriptionError);
+            }
+
+            inline auto deleteResult(const GladiaRestClient &client, const std::string &id,
+                                     response::TranscriptionError *transcriptionError = nullptr)
+            {
+                auto start = [&client, id](auto &operation)
+                {
+                    client.deleteResultAsync(id, [&operation](const response::TranscriptionError &error)
+                                             { operation.complete(error); });
+                };
+                return detail::makeOperation<void>(std::move(start), transcriptionError);
+            }
+
+            /**
+             * Completion of a watched job (see JobWatcher::watch()), resumed on the watcher thread. The watcher
+             * must outlive the awaiting coroutine: a job unwatched, or a watcher destroyed first, never resumes it.
+             */
+            inline auto whenDone(JobWatcher &watcher, const std::string &id, double audioDuration = 0.0,
+                                 response::TranscriptionError *transcriptionError = nullptr)
+            {
+                auto start = [&watcher, id, audioDuration](auto &operation)
+                {
+                    watcher.watch(id, audioDuration, [&operation](const response::TranscriptionResult &result, const response::TranscriptionError &error)
+                                  { operation.complete(error, result); });
+                };
+                return detail::makeOperation<response::TranscriptionResult>(std::move(start), transcriptionError);
+            }
+
+            /**
+             * Next event of a live session whose event stream is enabled (see
+             * GladiaWebsocketClientSession::takeNextEvent()): a queued one right away, otherwise resumed on the
+             * thread dispatching the next one. The stream ends with a DISCONNECTED connection event.
+             */
+            class NextEvent : private detail::Resumption
+            {
+            public:
+                explicit NextEvent(ws::GladiaWebsocketClientSession &session)
+                    : _session(session)
+                {
+                }
+
+                bool await_ready()
+                {
+                    return _session.poll(&_event, 1) == 1;
+                }
+
+                bool await_suspend(std::coroutine_handle<> handle)
+                {
+                    auto start = [this]()
+                    {
+                        _session.takeNextEvent([this](ws::LiveEvent &&event)
+                                               {
+                                                   _event = std::move(event);
+                                                   resume(); });
+                    };
+                    return suspend(handle, start);
+                }
+
+                ws::LiveEvent await_resume()
+                {
+                    return std::move(_event);
+                }
+
+            private:
+                ws::GladiaWebsocketClientSession &_session;
+                ws::LiveEvent _event;
+            };
+
+            inline NextEvent nextEvent(ws::GladiaWebsocketClientSession &session)
+            {
+                return NextEvent(session);
+            }
+        }
+    }
+}
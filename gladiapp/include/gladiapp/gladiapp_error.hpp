@@ -27,6 +27,7 @@ namespace gladiapp
                 void reset();
 
                 static TranscriptionError fromJson(const std::string &jsonString);
+                static TranscriptionError fromJsonDocument(const nlohmann::json &json);
 
                 std::string toString() const;
             };
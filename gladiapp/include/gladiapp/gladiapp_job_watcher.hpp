@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "gladiapp_export.h"
+#include "gladiapp_error.hpp"
+#include "gladiapp_rest.hpp"
+#include "gladiapp_rest_response.hpp"
+
+namespace gladiapp
+{
+    namespace v2
+    {
+        /**
+         * Polling settings of a JobWatcher.
+         */
+        struct JobWatcherOptions
+        {
+            /** Shortest and longest delay between two checks of the same job. */
+            std::chrono::milliseconds minInterval{1000};
+            std::chrono::milliseconds maxInterval{30000};
+
+            /** Growth factor of a job's polling interval after each check that finds it unfinished. */
+            double backoffFactor = 1.5;
+
+            /**
+             * Expected processing time as a fraction of the audio duration. The first check of a job
+             * is scheduled after audioDuration * expectedProcessingRatio (clamped to the intervals above).
+             */
+            double expectedProcessingRatio = 0.1;
+
+            /**
+             * When at least this many jobs are due at once, one listing of the queued/processing jobs
+             * replaces their individual status requests; only the jobs missing from it are fetched.
+             */
+            std::size_t batchThreshold = 4;
+
+            /** Page size and maximum number of pages of that listing. */
+            int batchPageSize = 100;
+            int batchMaxPages = 5;
+        };
+
+        /**
+         * Counters of a JobWatcher.
+         */
+        struct JobWatcherStats
+        {
+            std::uint64_t resultRequests = 0;
+            std::uint64_t listRequests = 0;
+            std::uint64_t completedJobs = 0;
+        };
+
+        // forward declaration of the actual implementation
+        class JobWatcherImpl;
+
+        /**
+         * Waits for pre-recorded transcription jobs to complete.
+         * A single thread tracks every watched job with an adaptive per-job polling interval, and
+         * refreshes many jobs with one getResults listing when several of them are due together.
+         * The client must outlive the watcher.
+         */
+        class GLADIAPP_EXPORT JobWatcher
+        {
+        public:
+            JobWatcher() = delete;
+            JobWatcher(const JobWatcher &) = delete;
+            JobWatcher &operator=(const JobWatcher &) = delete;
+
+            explicit JobWatcher(const GladiaRestClient &client, const JobWatcherOptions &options = JobWatcherOptions());
+            ~JobWatcher();
+
+            /**
+             * Invoked on the watcher thread once the job is done or failed.
+             * error.status_code is set when the status request itself was rejected (e.g. unknown id).
+             * Timeouts (408), rate limiting (429) and server errors (5xx) are retried with the job's backoff.
+             */
+            using CompletionCallback = std::function<void(const response::TranscriptionResult &result,
+                                                          const response::TranscriptionError &error)>;
+
+            /**
+             * Starts watching a job.
+             * @param id The ID of the transcription job.
+             * @param audioDuration Duration of the audio in seconds if known (e.g. UploadResponse::audio_metadata),
+             *        used to schedule the first check; refined from TranscriptionFile::duration once seen.
+             * @param callback Optional completion callback.
+             * @return A future holding the final result (status "done" or "error"). It throws if the
+             *         job could not be queried or the watcher was destroyed first.
+             */
+            std::future<response::TranscriptionResult> watch(const std::string &id,
+                                                             double audioDuration = 0.0,
+                                                             const CompletionCallback &callback = nullptr);
+
+            /**
+             * Stops watching a job; its future then reports std::future_errc::broken_promise.
+             */
+            bool unwatch(const std::string &id);
+
+            /**
+             * Completes a watched job from a result obtained elsewhere, e.g. a WebhookReceiver callback,
+             * without waiting for its next check.
+             * @return true if the job was watched and the result is final ("done" or "error").
+             */
+            bool notifyResult(const response::TranscriptionResult &result);
+
+            /**
+             * Number of jobs still being watched.
+             */
+            std::size_t pendingJobs() const;
+
+            JobWatcherStats getStats() const;
+
+        private:
+            std::unique_ptr<JobWatcherImpl> _jobWatcherImpl;
+        };
+    }
+}
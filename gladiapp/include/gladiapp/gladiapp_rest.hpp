@@ -4,9 +4,12 @@
 #include <vector>
 #include <nlohmann/json.hpp>
 #include <memory>
+#include <future>
+#include <functional>
 
 #include "gladiapp_export.h"
 #include "gladiapp_error.hpp"
+#include "gladiapp_transport.hpp"
 
 #include "gladiapp_rest_request.hpp"
 #include "gladiapp_rest_response.hpp"
@@ -35,8 +38,30 @@ namespace gladiapp
              *        store (e.g. Android with mbedTLS).
              */
             GladiaRestClient(const std::string &apiKey, const std::string &caFilePath = {});
+
+            /**
+             * @param apiKey Gladia API key.
+             * @param caFilePath Optional path to a CA bundle (PEM) file for TLS verification.
+             * @param options Transport settings (HTTP version, connection pool size, concurrency cap of the
+             *        asynchronous engine). With HttpVersion::HTTP_2 the blocking calls are also routed through
+             *        the event loop so that concurrent callers share one multiplexed connection.
+             */
+            GladiaRestClient(const std::string &apiKey, const std::string &caFilePath, const TransportOptions &options);
             ~GladiaRestClient();
 
+            /**
+             * Completion callbacks of the asynchronous API.
+             * They run on the client's event loop thread and must return quickly.
+             * On failure the error's status_code is set from the server's answer, or is 0 with a
+             * message when the request could not be performed at all.
+             */
+            using UploadCallback = std::function<void(const response::UploadResponse &, const response::TranscriptionError &)>;
+            using PreRecordedCallback = std::function<void(const response::TranscriptionJobResponse &, const response::TranscriptionError &)>;
+            using ResultCallback = std::function<void(const response::TranscriptionResult &, const response::TranscriptionError &)>;
+            using ResultsCallback = std::function<void(const response::TranscriptionListResults &, const response::TranscriptionError &)>;
+            using DeleteCallback = std::function<void(const response::TranscriptionError &)>;
+            using ResultItemCallback = std::function<void(const response::TranscriptionResult &)>;
+
             /**
              * Uploads an audio file for processing.
              * @param filePath The path to the audio file to upload.
@@ -67,6 +92,16 @@ namespace gladiapp
             response::TranscriptionListResults getResults(const request::ListResultsQuery &query,
                                                           response::TranscriptionError *transcriptionError = nullptr) const;
 
+            /**
+             * Retrieves a page of results, parsing each item as soon as its bytes have arrived.
+             * @param onItem Receives every item in order; the items are then not kept in the returned listing,
+             *        so memory stays bounded by one item whatever the page size.
+             * @return The pagination fields of the page.
+             */
+            response::TranscriptionListResults getResultsStreaming(const request::ListResultsQuery &query,
+                                                                   const ResultItemCallback &onItem,
+                                                                   response::TranscriptionError *transcriptionError = nullptr) const;
+
             /**
              * Deletes a transcription job.
              * @param id The ID of the transcription job.
@@ -74,6 +109,44 @@ namespace gladiapp
             void deleteResult(const std::string &id,
                               response::TranscriptionError *transcriptionError = nullptr) const;
 
+            /**
+             * Asynchronous API.
+             * All transfers are driven by a single curl_multi event loop thread owned by the client,
+             * which is started on the first asynchronous call. At most TransportOptions::maxConcurrentTransfers
+             * run at once, the others are queued.
+             * The future variants fill transcriptionError (when given) before the future becomes ready,
+             * the future throws if the request could not be performed.
+             */
+            std::future<response::UploadResponse> uploadAsync(const std::string &filePath,
+                                                              response::TranscriptionError *transcriptionError = nullptr) const;
+            void uploadAsync(const std::string &filePath, const UploadCallback &callback) const;
+
+            std::future<response::TranscriptionJobResponse> preRecordedAsync(const request::TranscriptionRequest &transcriptionRequest,
+                                                                             response::TranscriptionError *transcriptionError = nullptr) const;
+            void preRecordedAsync(const request::TranscriptionRequest &transcriptionRequest, const PreRecordedCallback &callback) const;
+
+            std::future<response::TranscriptionResult> getResultAsync(const std::string &id,
+                                                                      response::TranscriptionError *transcriptionError = nullptr) const;
+            void getResultAsync(const std::string &id, const ResultCallback &callback) const;
+
+            std::future<response::TranscriptionListResults> getResultsAsync(const request::ListResultsQuery &query,
+                                                                            response::TranscriptionError *transcriptionError = nullptr) const;
+            void getResultsAsync(const request::ListResultsQuery &query, const ResultsCallback &callback) const;
+
+            std::future<void> deleteResultAsync(const std::string &id,
+                                                response::TranscriptionError *transcriptionError = nullptr) const;
+            void deleteResultAsync(const std::string &id, const DeleteCallback &callback) const;
+
+            /**
+             * Changes the maximum number of concurrent asynchronous transfers.
+             */
+            void setMaxConcurrentTransfers(size_t maxConcurrentTransfers);
+
+            /**
+             * Returns the counters of the client's connection pool (handle and connection reuse).
+             */
+            ConnectionPoolStats getConnectionPoolStats() const;
+
         private:
             std::unique_ptr<GladiaRestClientImpl> _restClientImpl;
         };
@@ -38,6 +38,8 @@ namespace gladiapp
 
                     static AudioMetadata fromJson(const std::string &jsonString);
 
+                    static AudioMetadata fromJsonDocument(const nlohmann::json &json);
+
                     std::string toString() const;
                 };
 
@@ -45,6 +47,8 @@ namespace gladiapp
 
                 static UploadResponse fromJson(const std::string &jsonString);
 
+                static UploadResponse fromJsonDocument(const nlohmann::json &json);
+
                 std::string toString() const;
             };
 
@@ -59,6 +63,8 @@ namespace gladiapp
 
                 static TranscriptionJobResponse fromJson(const std::string &jsonString);
 
+                static TranscriptionJobResponse fromJsonDocument(const nlohmann::json &json);
+
                 std::string toString() const;
             };
 
@@ -74,6 +80,8 @@ namespace gladiapp
 
                 static SentenceError fromJson(const std::string &jsonString);
 
+                static SentenceError fromJsonDocument(const nlohmann::json &json);
+
                 std::string toString() const;
             };
 
@@ -92,6 +100,8 @@ namespace gladiapp
 
                 static TranscriptionFile fromJson(const std::string &jsonString);
 
+                static TranscriptionFile fromJsonDocument(const nlohmann::json &json);
+
                 std::string toString() const;
             };
 
@@ -107,6 +117,8 @@ namespace gladiapp
                 double transcription_time;
 
                 static Metadata fromJson(const std::string &jsonString);
+
+                static Metadata fromJsonDocument(const nlohmann::json &json);
             };
 
             /**
@@ -162,6 +174,8 @@ namespace gladiapp
 
                                 static Word fromJson(const std::string &jsonString);
 
+                                static Word fromJsonDocument(const nlohmann::json &json);
+
                                 std::string toString() const;
                             };
 
@@ -171,6 +185,8 @@ namespace gladiapp
 
                             static Utterance fromJson(const std::string &jsonString);
 
+                            static Utterance fromJsonDocument(const nlohmann::json &json);
+
                             std::string toString() const;
                         };
                         std::vector<Utterance> utterances;
@@ -180,15 +196,20 @@ namespace gladiapp
                             std::string format;
                             std::string subtitles;
                             static Subtitle fromJson(const std::string &jsonString);
+                            static Subtitle fromJsonDocument(const nlohmann::json &json);
                         };
                         std::vector<Subtitle> subtitles;
 
                         static Result fromJson(const std::string &jsonString);
+
+                        static Result fromJsonDocument(const nlohmann::json &json);
                     };
 
                     Result result;
 
                     static TranscriptionObject fromJson(const std::string &jsonString);
+
+                    static TranscriptionObject fromJsonDocument(const nlohmann::json &json);
                 };
                 TranscriptionObject result;
 
@@ -201,9 +222,13 @@ namespace gladiapp
                     std::optional<std::string> error;
 
                     static Moderation fromJson(const std::string &jsonString);
+
+                    static Moderation fromJsonDocument(const nlohmann::json &json);
                 };
 
                 static TranscriptionResult fromJson(const std::string &jsonString);
+
+                static TranscriptionResult fromJsonDocument(const nlohmann::json &json);
             };
 
             /**
@@ -217,6 +242,7 @@ namespace gladiapp
                 std::optional<std::string> next;
                 std::vector<TranscriptionResult> items;
                 static TranscriptionListResults fromJson(const std::string &jsonString);
+                static TranscriptionListResults fromJsonDocument(const nlohmann::json &json);
             };
         }
     }
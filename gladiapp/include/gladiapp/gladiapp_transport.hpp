@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gladiapp
+{
+    namespace v2
+    {
+        /**
+         * Counters of a client's pooled HTTP handles, used to monitor connection reuse.
+         */
+        struct ConnectionPoolStats
+        {
+            /** Number of completed transfers. */
+            std::uint64_t requests = 0;
+            /** Number of curl easy handles created by the pool. */
+            std::uint64_t handlesCreated = 0;
+            /** Number of transfers served by an idle pooled handle. */
+            std::uint64_t handlesReused = 0;
+            /** Number of new TCP/TLS connections opened by the transfers. */
+            std::uint64_t connectionsCreated = 0;
+            /** Number of transfers that went over an already open connection. */
+            std::uint64_t connectionsReused = 0;
+        };
+
+        /**
+         * Tuning knobs of a client's HTTP transport.
+         */
+        struct TransportOptions
+        {
+            enum class HttpVersion
+            {
+                /** Whatever libcurl picks by default (h2 through ALPN when it is built with HTTP/2 support). */
+                DEFAULT,
+                /** One request per connection at a time, connections are kept alive and reused. */
+                HTTP_1_1,
+                /**
+                 * HTTP/2 negotiated through ALPN: concurrent requests are multiplexed over a shared
+                 * connection, falling back to HTTP/1.1 keep-alive when the server does not offer h2.
+                 */
+                HTTP_2
+            };
+            HttpVersion httpVersion = HttpVersion::DEFAULT;
+
+            /**
+             * Maximum number of transfers driven at once by the asynchronous engine.
+             * Extra asynchronous requests wait in a queue until a slot frees up.
+             */
+            std::size_t maxConcurrentTransfers = 64;
+
+            /**
+             * Maximum number of idle handles (and their connections) kept by the connection pool.
+             */
+            std::size_t maxIdleConnections = 16;
+        };
+    }
+}
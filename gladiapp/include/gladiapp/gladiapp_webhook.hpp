@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "gladiapp_export.h"
+#include "gladiapp_rest_response.hpp"
+
+namespace gladiapp
+{
+    namespace v2
+    {
+        /**
+         * Listening settings of a WebhookReceiver.
+         */
+        struct WebhookReceiverOptions
+        {
+            /**
+             * IPv4 address to bind. The default only accepts local connections (e.g. from a reverse proxy),
+             * "0.0.0.0" exposes the receiver on every interface.
+             */
+            std::string bindAddress = "127.0.0.1";
+            /** Port to bind, 0 lets the system pick one (see WebhookReceiver::port()). */
+            std::uint16_t port = 0;
+            /** Path the callbacks are posted to, as set in TranscriptionRequest::CallbackConfig::url. */
+            std::string path = "/";
+            /**
+             * Shared secret every callback must carry, either as an extra path segment (path + "/" + secret,
+             * see WebhookReceiver::callbackPath()) or in an X-Webhook-Secret header. Required: start() fails
+             * without one. Requests without it are rejected before their body is read.
+             */
+            std::string secret;
+            /** Larger request bodies are rejected with 413; raise it for the results of very long recordings. */
+            std::size_t maxBodySize = 4 * 1024 * 1024;
+            /** Time a connection has to send its request and read the answer before it is closed. */
+            std::chrono::milliseconds connectionTimeout{10000};
+            /** Connections served at once, further ones are closed as soon as they are accepted. */
+            std::size_t maxConnections = 64;
+            /** Results received before anyone expects them are kept up to this count, oldest first out. */
+            std::size_t maxUnclaimedResults = 256;
+        };
+
+        // forward declaration of the actual implementation
+        class WebhookReceiverImpl;
+
+        /**
+         * Embedded HTTP listener receiving the pre-recorded results Gladia posts to
+         * TranscriptionRequest::CallbackConfig::url, an alternative to polling getResult.
+         * A single thread serves every connection through epoll (Linux only, start() fails elsewhere).
+         * Can be exercised locally with:
+         *   curl -X POST http://127.0.0.1:<port>/<secret> -d '{"id":"<job id>","event":"transcription.success","payload":{...}}'
+         */
+        class GLADIAPP_EXPORT WebhookReceiver
+        {
+        public:
+            WebhookReceiver(const WebhookReceiver &) = delete;
+            WebhookReceiver &operator=(const WebhookReceiver &) = delete;
+
+            explicit WebhookReceiver(const WebhookReceiverOptions &options = WebhookReceiverOptions());
+            ~WebhookReceiver();
+
+            /**
+             * Invoked on the listener thread for every received result, claimed or not.
+             * Typically forwards to JobWatcher::notifyResult.
+             */
+            using ResultCallback = std::function<void(const response::TranscriptionResult &result)>;
+
+            /**
+             * Binds the socket and starts the listener thread.
+             * @return false if the socket could not be bound (the reason is logged).
+             */
+            bool start();
+
+            /**
+             * Stops the listener; futures still expected report std::future_errc::broken_promise.
+             */
+            void stop();
+
+            /**
+             * Port actually bound, 0 before start().
+             */
+            std::uint16_t port() const;
+
+            /**
+             * Path including the secret segment, to append to the public URL set in
+             * TranscriptionRequest::CallbackConfig::url.
+             */
+            std::string callbackPath() const;
+
+            /**
+             * Returns a future completed when the result of the given job is posted.
+             * A result received before the call completes the future immediately.
+             */
+            std::future<response::TranscriptionResult> expect(const std::string &id);
+
+            void setOnResultCallback(const ResultCallback &callback);
+
+        private:
+            std::unique_ptr<WebhookReceiverImpl> _webhookReceiverImpl;
+        };
+    }
+}
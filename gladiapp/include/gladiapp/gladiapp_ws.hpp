@@ -7,11 +7,17 @@
 #include <functional>
 #include <vector>
 #include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <variant>
 #include <nlohmann/json.hpp>
 #include "gladiapp_error.hpp"
+#include "gladiapp_transport.hpp"
 #include "json_optional.hpp"
 #include "gladiapp_ws_request.hpp"
 #include "gladiapp_ws_response.hpp"
+#include "gladiapp_audio.hpp"
 
 namespace gladiapp
 {
@@ -24,6 +30,9 @@ namespace gladiapp
              */
             namespace events
             {
+                // Index of an event type, defined with the dispatch table
+                enum class EventType : std::uint8_t;
+
                 /**
                  * acknowledgment types
                  */
@@ -57,9 +66,417 @@ namespace gladiapp
                 constexpr const char *END_RECORDING = "end_recording";
             };
 
+            /**
+             * Outgoing frame queue of a session, letting audio capture threads enqueue frames
+             * while a writer thread performs the socket writes.
+             */
+            struct SendQueueOptions
+            {
+                enum class OverflowPolicy
+                {
+                    /** The sender waits until the writer frees a slot. */
+                    BLOCK,
+                    /** The oldest queued frame is discarded to make room. */
+                    DROP_OLDEST,
+                    /** The send call returns false, the frame is not queued. */
+                    FAIL
+                };
+
+                /**
+                 * Maximum number of queued frames. 0 sends synchronously on the caller's thread, unless the
+                 * session coalesces audio or streams it with streamAudio() (64 frames then).
+                 */
+                std::size_t capacity = 0;
+                OverflowPolicy overflowPolicy = OverflowPolicy::BLOCK;
+                /**
+                 * Queue depth firing the high-water-mark callback, 0 for three quarters of the capacity.
+                 * It fires again once the queue has drained below half of this depth.
+                 */
+                std::size_t highWaterMark = 0;
+            };
+
+            /**
+             * Counters of a session's send queue.
+             */
+            struct SendQueueStats
+            {
+                /** Number of frames waiting for the writer. */
+                std::size_t depth = 0;
+                /** Number of frames written to the socket. */
+                std::uint64_t sentFrames = 0;
+                /** Number of frames discarded by the DROP_OLDEST policy. */
+                std::uint64_t droppedFrames = 0;
+                /** Number of frames refused by the FAIL policy, or by a full queue on the timer thread. */
+                std::uint64_t rejectedFrames = 0;
+            };
+
+            /**
+             * Coalescing of small audio chunks into fewer WebSocket frames, trading frames (and their
+             * framing, masking and send calls) for latency.
+             */
+            struct CoalescingOptions
+            {
+                /**
+                 * Audio gathered into one frame, 0 sends every chunk as its own frame.
+                 * Frames are written by the session's send queue, created if SendQueueOptions::capacity is 0.
+                 */
+                std::size_t targetMs = 0;
+                /** Longest time a chunk waits for its frame to fill up. */
+                std::size_t maxLatencyMs = 20;
+            };
+
+            /**
+             * Reconnection of a session whose connection drops, to the same session URL instead of a new session.
+             * Binary audio written to the socket is kept until the server acknowledges it (audio_chunk
+             * acknowledgments, on by default in messages_config) and the unacknowledged part is sent again
+             * once reconnected. Audio sent as JSON is counted in the acknowledged byte offsets but not kept, it
+             * is lost if the connection drops before its acknowledgment.
+             */
+            struct ReconnectOptions
+            {
+                bool enabled = false;
+                /** Attempts before the session gives up and reports the disconnection, 0 retries forever. */
+                std::size_t maxAttempts = 8;
+                /** Wait before the first attempt, doubled after each failed one up to maxBackoffMs. */
+                std::size_t initialBackoffMs = 200;
+                std::size_t maxBackoffMs = 5000;
+                /** Unacknowledged audio kept for replay, older audio is lost if the connection drops. */
+                std::size_t replayBufferMs = 10000;
+            };
+
+            /**
+             * Counters of a session's reconnections.
+             */
+            struct ReconnectStats
+            {
+                std::uint64_t reconnections = 0;
+                /** Audio bytes sent again after reconnecting. */
+                std::uint64_t replayedBytes = 0;
+                /** Unacknowledged audio bytes that had left the replay buffer, or were sent as JSON, when a connection dropped. */
+                std::uint64_t lostBytes = 0;
+            };
+
+            /**
+             * Thread running a session's event callbacks. By default they run on the thread draining the socket,
+             * so a slow callback delays the reading of the next frames. The other modes hand each event over to
+             * a worker: a session's events still run one at a time, in the order they were received.
+             */
+            struct CallbackExecutorOptions
+            {
+                enum class Mode
+                {
+                    /** On the session's reception thread or reactor I/O thread. */
+                    INLINE,
+                    /** On a callback thread of the session's own. */
+                    SESSION,
+                    /**
+                     * On a pool of `threads` workers shared by the client's sessions, an idle worker taking
+                     * over the sessions waiting behind a busy one.
+                     */
+                    SHARED
+                };
+
+                enum class OverflowPolicy
+                {
+                    /** The thread draining the socket waits until the callbacks catch up. */
+                    BLOCK,
+                    /** The oldest pending message is discarded to make room. */
+                    DROP_OLDEST
+                };
+
+                Mode mode = Mode::INLINE;
+                /** Workers of the SHARED pool. */
+                std::size_t threads = 2;
+                /**
+                 * Messages a session may have waiting for its callbacks. Connection events (connected,
+                 * disconnected, errors) are always queued.
+                 */
+                std::size_t capacity = 1024;
+                OverflowPolicy overflowPolicy = OverflowPolicy::BLOCK;
+            };
+
+            /**
+             * Counters of a callback executor, of one session or of the client's shared pool. Queue latency is
+             * the time an event waited between its reception and its callback.
+             */
+            struct CallbackExecutorStats
+            {
+                /** Number of events waiting for a worker. */
+                std::size_t depth = 0;
+                std::size_t maxDepth = 0;
+                std::uint64_t executedEvents = 0;
+                /** Messages discarded by the DROP_OLDEST policy or pending when the session stopped. */
+                std::uint64_t droppedEvents = 0;
+                /** Batches of a session run by a worker other than the one it was queued on. */
+                std::uint64_t stolenBatches = 0;
+                double meanQueueLatencyMs = 0.0;
+                double maxQueueLatencyMs = 0.0;
+            };
+
+            /**
+             * Client-side voice activity gate, dropping the silent parts of the audio sent by a session.
+             * Every 10 ms frame is classified by its level and zero-crossing rate; silence is withheld except
+             * for a pre-roll before speech, a hangover after it and a keep-alive frame now and then.
+             */
+            struct VoiceActivityGateOptions
+            {
+                bool enabled = false;
+                /**
+                 * Level (dBFS) under which a frame counts as silence. 0 derives it from the session's
+                 * pre_processing.speech_threshold, well under the level the server would take for speech.
+                 */
+                double thresholdDb = 0.0;
+                /** Silence sent ahead of resuming speech, so that the server sees its onset. */
+                std::size_t preRollMs = 200;
+                /** Silence still sent after speech, so that word endings and endpointing are kept. */
+                std::size_t hangoverMs = 300;
+                /** One silent frame is sent every keepAliveMs of withheld audio, 0 withholds all of it. */
+                std::size_t keepAliveMs = 1000;
+            };
+
+            /**
+             * Counters of a session's voice activity gate.
+             */
+            struct VoiceActivityGateStats
+            {
+                std::uint64_t sentBytes = 0;
+                std::uint64_t suppressedBytes = 0;
+                /**
+                 * Duration of the withheld audio: the server's timeline runs that much behind the capture,
+                 * GladiaWebsocketClientSession::toCaptureTime() maps its timestamps back.
+                 */
+                double suppressedSeconds = 0.0;
+            };
+
+            /**
+             * Pull-based delivery of a session's events: they are queued for GladiaWebsocketClientSession::poll()
+             * as well as handed to the callbacks set, so that consumers can drain them in batches on threads
+             * of their own.
+             */
+            struct EventStreamOptions
+            {
+                enum class OverflowPolicy
+                {
+                    /** The thread dispatching the events waits until the consumer polls. */
+                    BLOCK,
+                    /** The oldest queued event is discarded to make room. */
+                    DROP_OLDEST
+                };
+
+                bool enabled = false;
+                /** Events held until polled. */
+                std::size_t capacity = 1024;
+                OverflowPolicy overflowPolicy = OverflowPolicy::BLOCK;
+                /**
+                 * Types of the events streamed (events::TRANSCRIPT, ...), empty for all of them. Connection
+                 * events are always streamed.
+                 */
+                std::vector<std::string> eventTypes;
+            };
+
+            /**
+             * Counters of a session's event stream.
+             */
+            struct EventStreamStats
+            {
+                /** Number of events waiting to be polled. */
+                std::size_t depth = 0;
+                std::uint64_t queuedEvents = 0;
+                /** Number of events discarded by the DROP_OLDEST policy. */
+                std::uint64_t droppedEvents = 0;
+            };
+
+            /**
+             * Change of a session's connection, as delivered by the event stream.
+             */
+            struct ConnectionEvent
+            {
+                enum class Kind
+                {
+                    CONNECTED,
+                    DISCONNECTED,
+                    ERROR
+                };
+
+                Kind kind = Kind::CONNECTED;
+                /** Reason of the disconnection or error message. */
+                std::string message;
+            };
+
+            /**
+             * Event of the stream, one alternative per event structure. Speech and lifecycle events tell their
+             * kind by their type field (speech_start, end_session...).
+             */
+            using LiveEvent = std::variant<ConnectionEvent,
+                                           response::LifecycleEvent,
+                                           response::SpeechEvent,
+                                           response::Transcript,
+                                           response::Translation,
+                                           response::NamedEntityRecognition,
+                                           response::SentimentAnalysis,
+                                           response::PostTranscript,
+                                           response::FinalTranscript,
+                                           response::Chapterization,
+                                           response::Summarization,
+                                           response::AudioChunkAcknowledgment,
+                                           response::StopRecordingAcknowledgment>;
+
+            /**
+             * Pacing of pre-recorded audio streamed by GladiaWebsocketClientSession::streamAudio().
+             */
+            struct AudioPacingOptions
+            {
+                /** 1 streams at real-time rate, N streams N times faster. */
+                double speed = 1.0;
+                /** Duration of audio per chunk. */
+                std::size_t chunkMs = 100;
+            };
+
+            /**
+             * Time spent starting a session, phase by phase, in milliseconds. DNS, TCP and TLS are the
+             * durations of each handshake step, 0 when a cached entry or connection made it unnecessary.
+             */
+            struct SessionStartTiming
+            {
+                /** POST /v2/live, until the session URL is known. */
+                double initRequestMs = 0.0;
+
+                /**
+                 * Warm-up of the region's WebSocket host run alongside the POST, see
+                 * WebsocketClientOptions::pipelinedConnect: DNS and TCP connection for the WebSocket.
+                 */
+                bool warmedUp = false;
+                /** True when the session URL is on the host warmed up. */
+                bool warmUpHit = false;
+                double warmUpDnsMs = 0.0;
+                double warmUpTcpMs = 0.0;
+                double warmUpMs = 0.0;
+                /**
+                 * TLS handshake of the request filling the TLS session cache, made until a session of the region
+                 * has connected. 0 when it had not completed with the POST.
+                 */
+                double warmUpTlsMs = 0.0;
+                /** Time connect() still waited for the WebSocket's TCP connection once the POST was answered. */
+                double warmUpWaitMs = 0.0;
+
+                /** True when the WebSocket used the TCP connection opened by the warm-up, wsTcpMs is then 0. */
+                bool wsPreconnected = false;
+                /** WebSocket connection opened by connectAndStart(), the HTTP upgrade included. */
+                double wsDnsMs = 0.0;
+                double wsTcpMs = 0.0;
+                double wsTlsMs = 0.0;
+                double wsUpgradeMs = 0.0;
+                double wsConnectMs = 0.0;
+            };
+
+            /**
+             * Options of a WebSocket client and the sessions it creates.
+             */
+            struct WebsocketClientOptions
+            {
+                /**
+                 * 0: each session receives on its own thread.
+                 * N > 0: the sessions of the client share a reactor of N I/O threads (epoll, Linux only),
+                 * for processes running many concurrent live sessions. Callbacks then run on these threads,
+                 * a slow callback delays the other sessions served by the same thread unless callbackExecutor
+                 * moves them to workers.
+                 */
+                std::size_t reactorThreads = 0;
+
+                SendQueueOptions sendQueue;
+
+                /**
+                 * Size in bytes of the buffers handed out by GladiaWebsocketClientSession::acquireAudioBuffer().
+                 */
+                std::size_t audioBufferSize = 8192;
+                /**
+                 * Maximum number of released audio buffers a session keeps for reuse,
+                 * raised to the send queue capacity so that a full queue is recycled whole.
+                 */
+                std::size_t audioBufferPoolSize = 32;
+
+                CoalescingOptions coalescing;
+
+                VoiceActivityGateOptions voiceActivityGate;
+
+                ReconnectOptions reconnect;
+
+                CallbackExecutorOptions callbackExecutor;
+
+                EventStreamOptions eventStream;
+
+                /**
+                 * connect() resolves and handshakes the region's WebSocket host while the POST creating the
+                 * session is in flight, so that connectAndStart() finds its address cached, reuses a TCP
+                 * connection opened meanwhile and resumes the TLS session. The host is the one of the region's
+                 * last session URL, its default one at first.
+                 */
+                bool pipelinedConnect = false;
+            };
+
             // Forward declaration for the WebSocket client session
             class GladiaWebsocketClientSession;
 
+            // Forward declaration of the reactor shared by the sessions
+            class WebsocketReactor;
+
+            // Forward declaration of the pacer of pre-recorded audio
+            class AudioPacer;
+
+            // Forward declaration of the voice activity gate
+            class VoiceActivityGate;
+
+            // Forward declaration of the queue behind the event stream
+            class LiveEventStream;
+
+            // Forward declarations for the audio buffer pool
+            class AudioBufferPool;
+            class GladiaWebsocketClientSessionImpl;
+
+            /**
+             * Audio chunk storage lent by a session (acquireAudioBuffer()) and given back with submit().
+             * The storage returns to the session's pool once the frame is written, or when the buffer is
+             * destroyed without being submitted. Move-only.
+             */
+            class GLADIAPP_EXPORT AudioBuffer
+            {
+            public:
+                AudioBuffer();
+                AudioBuffer(AudioBuffer &&other) noexcept;
+                AudioBuffer &operator=(AudioBuffer &&other) noexcept;
+                AudioBuffer(const AudioBuffer &) = delete;
+                AudioBuffer &operator=(const AudioBuffer &) = delete;
+                ~AudioBuffer();
+
+                uint8_t *data();
+                const uint8_t *data() const;
+
+                /**
+                 * Number of bytes to send, the full capacity when acquired.
+                 */
+                std::size_t size() const;
+                std::size_t capacity() const;
+
+                /**
+                 * Sets the number of bytes to send. Growing past the capacity allocates.
+                 */
+                void resize(std::size_t size);
+
+                /**
+                 * False for a default-constructed or moved-from buffer.
+                 */
+                explicit operator bool() const;
+
+            private:
+                friend class GladiaWebsocketClientSessionImpl;
+
+                AudioBuffer(std::unique_ptr<std::vector<uint8_t>> storage, std::shared_ptr<AudioBufferPool> pool);
+                void release();
+
+                std::unique_ptr<std::vector<uint8_t>> _storage;
+                std::shared_ptr<AudioBufferPool> _pool;
+            };
+
             // Forward declaration for the implementation details
             class GladiaWebsocketClientImpl;
 
@@ -80,6 +497,7 @@ namespace gladiapp
                  *        store (e.g. Android with mbedTLS).
                  */
                 GladiaWebsocketClient(const std::string &apiKey, const std::string &caFilePath = {});
+                GladiaWebsocketClient(const std::string &apiKey, const std::string &caFilePath, const WebsocketClientOptions &options);
                 ~GladiaWebsocketClient();
 
                 GladiaWebsocketClientSession *connect(const request::InitializeSessionRequest &initRequest,
@@ -97,6 +515,17 @@ namespace gladiapp
                 bool deleteResult(const std::string &id,
                                   gladiapp::v2::response::TranscriptionError *transcriptionError = nullptr) const;
 
+                /**
+                 * Returns the counters of the client's connection pool used by the REST calls.
+                 */
+                ConnectionPoolStats getConnectionPoolStats() const;
+
+                /**
+                 * Returns the counters of the callback pool shared by the sessions, all zero unless
+                 * WebsocketClientOptions::callbackExecutor is in SHARED mode.
+                 */
+                CallbackExecutorStats getCallbackExecutorStats() const;
+
             private:
                 std::unique_ptr<GladiaWebsocketClientImpl> _wsClientImpl;
                 std::string _caFilePath;
@@ -117,6 +546,13 @@ namespace gladiapp
 
                 GladiaWebsocketClientSession(const response::InitializeSessionResponse &initResponse,
                                             const std::string &caFilePath = {});
+                /**
+                 * @param reactor Reactor receiving the session's frames instead of a dedicated thread.
+                 */
+                GladiaWebsocketClientSession(const response::InitializeSessionResponse &initResponse,
+                                            const std::string &caFilePath,
+                                            std::shared_ptr<WebsocketReactor> reactor,
+                                            const WebsocketClientOptions &options = {});
                 ~GladiaWebsocketClientSession();
 
                 /**
@@ -149,6 +585,142 @@ namespace gladiapp
                  */
                 bool sendAudioJson(const uint8_t *audioData, int size) const;
 
+                /**
+                 * Lends a pooled audio buffer of WebsocketClientOptions::audioBufferSize bytes to fill and submit.
+                 */
+                AudioBuffer acquireAudioBuffer() const;
+
+                /**
+                 * Sends the buffer as binary audio without copying it; it is recycled once written.
+                 * With a send queue the call only enqueues the buffer.
+                 */
+                bool submit(AudioBuffer &&buffer) const;
+
+                /**
+                 * Sets the format sendAudioFloat() converts to; GladiaWebsocketClient::connect() sets it from the session request.
+                 */
+                void setAudioFormat(const audio::AudioFormat &format);
+                const audio::AudioFormat &getAudioFormat() const;
+
+                /**
+                 * Converts interleaved float samples (downmix, resampling, encoding) to the session's audio format
+                 * and sends them as binary audio. Calls must come from one thread at a time.
+                 * Returns true without sending anything while the resampler needs more input.
+                 */
+                bool sendAudioFloat(const float *samples, std::size_t frameCount, int sampleRate, int channels);
+
+                /**
+                 * Called when paced audio has been streamed (completed is true) or could not be sent.
+                 * Runs on the shared timer thread.
+                 */
+                using OnStreamFinishedCallback = std::function<void(bool completed)>;
+
+                /**
+                 * Streams pre-recorded audio in the session format as binary chunks at real-time rate (or
+                 * AudioPacingOptions::speed times faster), the rate being derived from the session's
+                 * sample_rate, bit_depth and channels. The chunks are queued by a timer thread shared by all
+                 * sessions and written by the session's send queue, created with 64 frames if the session has
+                 * none, so that slow sockets do not delay the other streams. A chunk finding the queue full
+                 * ends the stream (completed is false).
+                 * Replaces any stream in progress.
+                 */
+                bool streamAudio(std::vector<uint8_t> audio, const AudioPacingOptions &options = {},
+                                 const OnStreamFinishedCallback &onFinished = nullptr);
+
+                /**
+                 * Same for a raw audio or WAV file, read as it is streamed.
+                 */
+                bool streamAudioFile(const std::string &filePath, const AudioPacingOptions &options = {},
+                                     const OnStreamFinishedCallback &onFinished = nullptr);
+
+                /**
+                 * Stops the stream in progress, the finished callback is not called.
+                 */
+                void stopStreaming();
+
+                bool isStreaming() const;
+
+                /**
+                 * Gates the audio sent from now on (binary, JSON, submitted buffers and sendAudioFloat()) on voice
+                 * activity, for the current audio format. GladiaWebsocketClient::connect() enables it when
+                 * WebsocketClientOptions::voiceActivityGate is.
+                 */
+                void enableVoiceActivityGate(const VoiceActivityGateOptions &options);
+
+                /**
+                 * Returns the counters of the voice activity gate, all zero when it is disabled.
+                 */
+                VoiceActivityGateStats getVoiceActivityGateStats() const;
+
+                /**
+                 * Maps a timestamp of the server (seconds of audio it received) to seconds of captured audio,
+                 * adding the silence the voice activity gate withheld before it.
+                 */
+                double toCaptureTime(double sessionSeconds) const;
+
+                /**
+                 * Returns the counters of the send queue, all zero when frames are sent synchronously.
+                 */
+                SendQueueStats getSendQueueStats() const;
+
+                /**
+                 * Send queue callback, called on the sending thread when the queue depth reaches the high-water mark.
+                 */
+                using OnSendQueueHighWaterCallback = std::function<void(std::size_t depth)>;
+
+                void setOnSendQueueHighWaterCallback(const OnSendQueueHighWaterCallback &callback);
+
+                /**
+                 * Returns the counters of the reconnections, all zero when WebsocketClientOptions::reconnect is disabled.
+                 */
+                ReconnectStats getReconnectStats() const;
+
+                /**
+                 * Returns the time spent creating and connecting the session, the WebSocket phases being zero
+                 * until connectAndStart() has succeeded.
+                 */
+                SessionStartTiming getStartTiming() const;
+
+                /**
+                 * Returns the counters of the session's events handed over to the callback executor, all zero
+                 * when callbacks run inline.
+                 */
+                CallbackExecutorStats getCallbackExecutorStats() const;
+
+                /**
+                 * Queues the session's events for poll(), next to the callbacks. To be called before
+                 * connectAndStart(); GladiaWebsocketClient::connect() enables it when
+                 * WebsocketClientOptions::eventStream is.
+                 * @return false if the session is already connected.
+                 */
+                bool enableEventStream(const EventStreamOptions &options = {});
+
+                /**
+                 * Moves up to maxEvents queued events into events, oldest first, without waiting.
+                 * Safe to call from several threads.
+                 * @return the number of events moved, 0 when the stream is empty or disabled.
+                 */
+                std::size_t poll(LiveEvent *events, std::size_t maxEvents);
+
+                /**
+                 * Waits until the stream holds an event or the timeout expires.
+                 * @return true if events are queued; poll() may still find none when another consumer took them.
+                 */
+                bool waitFor(std::chrono::milliseconds timeout);
+
+                /**
+                 * Hands the oldest queued event to onEvent, right away if there is one, otherwise from the thread
+                 * dispatching the next one, which then skips the queue. Each call takes one event; the awaitable
+                 * coro::nextEvent() builds on it. onEvent receives a DISCONNECTED connection event when the stream
+                 * is disabled, or closed by the session's destruction.
+                 */
+                void takeNextEvent(std::function<void(LiveEvent &&event)> onEvent);
+
+                /**
+                 * Returns the counters of the event stream, all zero when it is disabled.
+                 */
+                EventStreamStats getEventStreamStats() const;
+
                 /**
                  * Connectivity callbacks
                  */
@@ -157,6 +729,11 @@ namespace gladiapp
 
                 void setOnConnectedCallback(const OnConnectivityCallback &callback);
                 void setOnDisconnectedCallback(const OnConnectivityCallback &callback);
+                /**
+                 * Called once a dropped connection is restored and the unacknowledged audio replayed.
+                 * With reconnection enabled the disconnected callback is only called when the session gives up.
+                 */
+                void setOnReconnectedCallback(const OnConnectivityCallback &callback);
                 void setOnErrorCallback(const OnErrorCallback &callback);
 
                 /**
@@ -211,13 +788,28 @@ namespace gladiapp
                 void setOnEndRecordingCallback(const OnEndRecordingCallback &callback);
 
             private:
+                // hands the session its DNS and TLS caches, and the timing and warm-up connection of connect()
+                friend class GladiaWebsocketClient;
+
                 std::unique_ptr<GladiaWebsocketClientSessionImpl> _wsClientSessionImpl;
                 /**
                  * Callback functions
                  */
                 OnConnectivityCallback _onConnectedCallback;
                 OnConnectivityCallback _onDisconnectedCallback;
+                OnConnectivityCallback _onReconnectedCallback;
                 OnErrorCallback _onErrorCallback;
+                OnSendQueueHighWaterCallback _onSendQueueHighWaterCallback;
+
+                /**
+                 * Client-side audio conversion
+                 */
+                audio::AudioFormat _audioFormat;
+                std::unique_ptr<audio::AudioConverter> _audioConverter;
+                std::vector<uint8_t> _convertedAudio;
+                std::shared_ptr<AudioPacer> _audioPacer;
+                VoiceActivityGateOptions _voiceActivityGateOptions;
+                std::unique_ptr<VoiceActivityGate> _voiceActivityGate;
 
                 /**
                  * Speech event callbacks
@@ -251,8 +843,30 @@ namespace gladiapp
                 OnStartRecordingCallback _onStartRecordingCallback;
                 OnEndRecordingCallback _onEndRecordingCallback;
 
+                bool sendAudioJsonChunk(const uint8_t *audioData, int size) const;
+                bool startPacer(const AudioPacingOptions &options, const OnStreamFinishedCallback &onFinished,
+                                const std::function<void(AudioPacer &)> &startSource);
+
                 // Process incoming WebSocket messages
                 void processDataMessage(const std::string &message) const;
+                // false for the events nobody listens to, which are dropped before being parsed
+                bool acceptsMessage(const std::string &message) const;
+                void dispatchMessage(const std::string &message) const;
+
+                /**
+                 * One bit per event type with a callback set, messages of the other types are not parsed
+                 */
+                std::atomic<std::uint32_t> _subscribedEvents{0};
+                void updateSubscription(events::EventType eventType, bool subscribed);
+                bool isSubscribed(events::EventType eventType) const;
+
+                /**
+                 * Pull-based delivery, with one bit per event type streamed
+                 */
+                std::unique_ptr<LiveEventStream> _eventStream;
+                std::uint32_t _streamedEvents = 0;
+                bool isStreamed(events::EventType eventType) const;
+                void streamConnectionEvent(ConnectionEvent::Kind kind, const std::string &message) const;
 
                 response::InitializeSessionResponse _sessionInfo;
             };
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "gladiapp_export.h"
+#include "gladiapp_error.hpp"
+#include "gladiapp_ws.hpp"
+
+namespace gladiapp
+{
+    namespace v2
+    {
+        namespace ws
+        {
+            /**
+             * Settings of a LiveSessionPool.
+             */
+            struct LiveSessionPoolOptions
+            {
+                /** Connected sessions kept ready for each session configuration. */
+                std::size_t sessionsPerConfig = 2;
+
+                /**
+                 * Time a ready session may wait for a caller. Older ones are stopped and replaced, before the
+                 * server gives up on a connection that sends no audio.
+                 */
+                std::chrono::milliseconds maxIdle{20000};
+
+                /** Delay before refilling a configuration again after a failed session creation. */
+                std::chrono::milliseconds retryDelay{1000};
+            };
+
+            /**
+             * Counters of a LiveSessionPool. Handout times are the time spent in acquire().
+             */
+            struct LiveSessionPoolStats
+            {
+                /** Sessions handed out ready. */
+                std::uint64_t warmHandouts = 0;
+                /** Sessions created on demand because none was ready. */
+                std::uint64_t coldHandouts = 0;
+                /** acquire() calls that could not create a session. */
+                std::uint64_t failedHandouts = 0;
+                /** Ready sessions replaced after maxIdle or closed by the server while waiting. */
+                std::uint64_t expiredSessions = 0;
+                std::uint64_t failedRefills = 0;
+                std::size_t readySessions = 0;
+
+                double meanWarmHandoutMs = 0.0;
+                double maxWarmHandoutMs = 0.0;
+                double meanColdHandoutMs = 0.0;
+                double maxColdHandoutMs = 0.0;
+            };
+
+            // forward declaration of the actual implementation
+            class LiveSessionPoolImpl;
+
+            /**
+             * Keeps live sessions initialized (POST /v2/live) and connected ahead of time, so that a stream
+             * can start sending audio as soon as it asks for a session. A background thread refills each
+             * configuration up to LiveSessionPoolOptions::sessionsPerConfig and replaces expired sessions.
+             * The client must outlive the pool.
+             */
+            class GLADIAPP_EXPORT LiveSessionPool
+            {
+            public:
+                LiveSessionPool() = delete;
+                LiveSessionPool(const LiveSessionPool &) = delete;
+                LiveSessionPool &operator=(const LiveSessionPool &) = delete;
+
+                explicit LiveSessionPool(const GladiaWebsocketClient &client, const LiveSessionPoolOptions &options = LiveSessionPoolOptions());
+                /**
+                 * Stops the sessions still ready.
+                 */
+                ~LiveSessionPool();
+
+                /**
+                 * Starts keeping sessions of this configuration ready.
+                 */
+                void prewarm(const request::InitializeSessionRequest &initRequest);
+
+                /**
+                 * Hands out a connected session of this configuration, a ready one when there is one, a new one
+                 * otherwise. Only configurations passed to prewarm() are kept ready. Events the server sent before
+                 * the handout (e.g. start_session) are not delivered: set the callbacks before sending audio.
+                 * @return null if no session could be created, error then holds the server's error if any.
+                 */
+                std::unique_ptr<GladiaWebsocketClientSession> acquire(const request::InitializeSessionRequest &initRequest,
+                                                                      gladiapp::v2::response::TranscriptionError *error = nullptr);
+
+                LiveSessionPoolStats getStats() const;
+
+            private:
+                std::unique_ptr<LiveSessionPoolImpl> _sessionPoolImpl;
+            };
+        }
+    }
+}
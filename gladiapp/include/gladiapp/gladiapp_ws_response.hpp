@@ -588,6 +588,7 @@ namespace gladiapp
                     Result result;
                     
                     static LiveTranscriptionResult fromJson(const nlohmann::json &json);
+                    static LiveTranscriptionResult fromJsonString(const std::string &jsonString);
                 };
             }
         }
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "mpmc_queue.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gladiapp::v2::ws
+{
+    /**
+     * Free list of the storage behind the AudioBuffers of a session. Buffers come back here when they are
+     * destroyed, after their frame has been written, so steady streaming allocates nothing per chunk.
+     * Shared with the buffers it hands out, which may outlive the session.
+     */
+    class AudioBufferPool
+    {
+    public:
+        using Storage = std::vector<std::uint8_t>;
+
+        AudioBufferPool(std::size_t bufferSize, std::size_t maxPooledBuffers)
+            : _bufferSize(bufferSize == 0 ? 1 : bufferSize), _freeList(maxPooledBuffers == 0 ? 1 : maxPooledBuffers)
+        {
+        }
+
+        /**
+         * Returns a pooled storage resized to the buffer size, or a new one when none is free.
+         */
+        std::unique_ptr<Storage> take()
+        {
+            std::unique_ptr<Storage> storage;
+            if (!_freeList.tryPop(storage) || storage == nullptr)
+            {
+                storage = std::make_unique<Storage>();
+                storage->reserve(_bufferSize);
+            }
+            storage->resize(_bufferSize);
+            return storage;
+        }
+
+        /**
+         * Keeps the storage for reuse, or frees it when the pool already holds enough.
+         */
+        void give(std::unique_ptr<Storage> storage)
+        {
+            _freeList.tryPush(std::move(storage));
+        }
+
+        std::size_t bufferSize() const
+        {
+            return _bufferSize;
+        }
+
+    private:
+        const std::size_t _bufferSize;
+        concurrent_util::BoundedMpmcQueue<std::unique_ptr<Storage>> _freeList;
+    };
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "../gladiapp_ws.hpp"
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace gladiapp::v2::ws
+{
+    /**
+     * Gathers small audio chunks into frames of CoalescingOptions::targetMs, sending a partial frame once
+     * its first chunk has waited maxLatencyMs (deadline on the shared timer wheel). Chunks at least as
+     * large as the target go out as they are when nothing is pending.
+     * The send function must not write to the socket itself: the session hands the frames to its send queue.
+     */
+    class AudioCoalescer : public std::enable_shared_from_this<AudioCoalescer>
+    {
+    public:
+        using SendFunction = std::function<bool(const uint8_t *data, std::size_t size)>;
+
+        AudioCoalescer(const CoalescingOptions &options, std::shared_ptr<TimerWheel> wheel, SendFunction send)
+            : _options(options), _wheel(std::move(wheel)), _send(std::move(send))
+        {
+            setBytesPerSecond(audio::AudioFormat().bytesPerSecond());
+        }
+
+        /**
+         * Sets the byte rate of the session's audio, which turns targetMs into a frame size.
+         */
+        void setBytesPerSecond(std::size_t bytesPerSecond)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _targetBytes = std::max<std::size_t>(bytesPerSecond * _options.targetMs / 1000, 1);
+            _pending.reserve(_targetBytes);
+        }
+
+        /**
+         * @return false if a frame could not be sent.
+         */
+        bool add(const uint8_t *data, std::size_t size)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_closed)
+            {
+                return _send(data, size);
+            }
+            if (_pending.empty() && size >= _targetBytes)
+            {
+                return _send(data, size);
+            }
+            bool firstChunk = _pending.empty();
+            _pending.insert(_pending.end(), data, data + size);
+            if (_pending.size() >= _targetBytes)
+            {
+                return flushLocked();
+            }
+            if (firstChunk)
+            {
+                _timer = scheduleDeadline(++_generation, TimerWheel::Clock::now() + std::chrono::milliseconds(_options.maxLatencyMs));
+            }
+            return true;
+        }
+
+        /**
+         * Sends the pending chunks now, ahead of a frame that must follow them.
+         */
+        bool flush()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return flushLocked();
+        }
+
+        /**
+         * Flushes and sends every later chunk as is. Waits for a flush in progress on the timer thread.
+         */
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            flushLocked();
+            _closed = true;
+        }
+
+    private:
+        TimerWheel::TimerId scheduleDeadline(std::uint64_t generation, TimerWheel::Clock::time_point deadline)
+        {
+            std::weak_ptr<AudioCoalescer> weakSelf = weak_from_this();
+            return _wheel->schedule(deadline, [weakSelf, generation]()
+                                    {
+                                        if (auto self = weakSelf.lock())
+                                        {
+                                            self->onDeadline(generation);
+                                        }
+                                    });
+        }
+
+        /**
+         * Runs on the timer thread: the frame is only handed to the session's send queue, and a sender
+         * holding the lock (possibly waiting for queue space) is not waited for, the deadline comes back
+         * on the next tick instead.
+         */
+        void onDeadline(std::uint64_t generation)
+        {
+            std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                // a flush meanwhile clears _timer, the retry then finds nothing to send
+                scheduleDeadline(generation, TimerWheel::Clock::now() + TimerWheel::TICK);
+                return;
+            }
+            if (_timer == 0 || generation != _generation)
+            {
+                // the frame filled up meanwhile
+                return;
+            }
+            _timer = 0;
+            if (!flushLocked())
+            {
+                spdlog::error("Error sending coalesced audio data");
+            }
+        }
+
+        bool flushLocked()
+        {
+            if (_timer != 0)
+            {
+                _wheel->cancel(_timer);
+                _timer = 0;
+            }
+            if (_pending.empty())
+            {
+                return true;
+            }
+            bool sent = _send(_pending.data(), _pending.size());
+            _pending.clear();
+            return sent;
+        }
+
+    private:
+        const CoalescingOptions _options;
+        std::shared_ptr<TimerWheel> _wheel;
+        SendFunction _send;
+
+        std::mutex _mutex;
+        std::size_t _targetBytes = 1;
+        std::vector<uint8_t> _pending;
+        TimerWheel::TimerId _timer = 0;
+        // deadline the armed timer belongs to, a timer that could not be cancelled finds a newer one
+        std::uint64_t _generation = 0;
+        bool _closed = false;
+    };
+}
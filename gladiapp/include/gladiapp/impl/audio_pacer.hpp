@@ -0,0 +1,183 @@
+#pragma once
+
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gladiapp::v2::ws
+{
+    /**
+     * Streams pre-recorded audio (a buffer or an open file) in fixed-size chunks at real-time rate, or
+     * a multiple of it. Chunk k is due at start + k * interval, so late ticks do not accumulate drift.
+     * Chunks are sent from the timer wheel thread, the send function must only queue them.
+     */
+    class AudioPacer : public std::enable_shared_from_this<AudioPacer>
+    {
+    public:
+        using SendFunction = std::function<bool(const uint8_t *data, std::size_t size)>;
+        using FinishedFunction = std::function<void(bool completed)>;
+
+        /**
+         * @param chunkBytes Size of every chunk but the last one.
+         * @param chunkInterval Time between two chunks.
+         */
+        AudioPacer(std::shared_ptr<TimerWheel> wheel, std::size_t chunkBytes, std::chrono::duration<double> chunkInterval,
+                   SendFunction send, FinishedFunction finished)
+            : _wheel(std::move(wheel)),
+              _chunkBytes(std::max<std::size_t>(chunkBytes, 1)),
+              _chunkInterval(chunkInterval),
+              _send(std::move(send)),
+              _finished(std::move(finished))
+        {
+        }
+
+        ~AudioPacer()
+        {
+            stop();
+        }
+
+        void start(std::vector<uint8_t> audio)
+        {
+            _audio = std::move(audio);
+            begin();
+        }
+
+        /**
+         * @param file Stream positioned on the first audio byte.
+         */
+        void start(std::unique_ptr<std::istream> file)
+        {
+            _file = std::move(file);
+            begin();
+        }
+
+        /**
+         * Cancels the chunks not sent yet, the finished function is not called. Waits for a chunk being sent,
+         * unless called from the send or finished function itself.
+         */
+        void stop()
+        {
+            if (_tickThread.load() == std::this_thread::get_id())
+            {
+                _stopped = true;
+                return;
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopped = true;
+            if (_timer != 0)
+            {
+                _wheel->cancel(_timer);
+                _timer = 0;
+            }
+        }
+
+        bool isRunning() const
+        {
+            return !_stopped;
+        }
+
+    private:
+        void begin()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _start = TimerWheel::Clock::now();
+            _stopped = false;
+            scheduleChunk();
+        }
+
+        void scheduleChunk()
+        {
+            auto offset = std::chrono::duration_cast<TimerWheel::Clock::duration>(_chunkInterval * static_cast<double>(_chunkIndex));
+            std::weak_ptr<AudioPacer> weakSelf = weak_from_this();
+            _timer = _wheel->schedule(_start + offset, [weakSelf]()
+                                      {
+                                          if (auto self = weakSelf.lock())
+                                          {
+                                              self->sendChunk();
+                                          } });
+        }
+
+        void sendChunk()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _timer = 0;
+            if (_stopped)
+            {
+                return;
+            }
+            _tickThread = std::this_thread::get_id();
+            const uint8_t *data = nullptr;
+            std::size_t size = readChunk(data);
+            bool sent = size == 0 || _send(data, size);
+            bool exhausted = _file != nullptr ? !(*_file) || _file->peek() == std::char_traits<char>::eof()
+                                              : _offset >= _audio.size();
+            if (sent && !exhausted && !_stopped)
+            {
+                ++_chunkIndex;
+                scheduleChunk();
+                _tickThread = std::thread::id();
+                return;
+            }
+            bool notify = !_stopped;
+            _stopped = true;
+            FinishedFunction finished = notify ? _finished : nullptr;
+            lock.unlock();
+            if (finished)
+            {
+                try
+                {
+                    finished(sent);
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::error("Error in audio pacing finished callback: {}", e.what());
+                }
+            }
+            _tickThread = std::thread::id();
+        }
+
+        std::size_t readChunk(const uint8_t *&data)
+        {
+            if (_file != nullptr)
+            {
+                _chunk.resize(_chunkBytes);
+                _file->read(reinterpret_cast<char *>(_chunk.data()), static_cast<std::streamsize>(_chunkBytes));
+                data = _chunk.data();
+                return static_cast<std::size_t>(_file->gcount());
+            }
+            std::size_t size = std::min(_chunkBytes, _audio.size() - _offset);
+            data = _audio.data() + _offset;
+            _offset += size;
+            return size;
+        }
+
+    private:
+        std::shared_ptr<TimerWheel> _wheel;
+        const std::size_t _chunkBytes;
+        const std::chrono::duration<double> _chunkInterval;
+        SendFunction _send;
+        FinishedFunction _finished;
+
+        std::mutex _mutex;
+        std::atomic<bool> _stopped{true};
+        std::atomic<std::thread::id> _tickThread{};
+        TimerWheel::TimerId _timer = 0;
+        TimerWheel::Clock::time_point _start;
+        std::uint64_t _chunkIndex = 0;
+
+        // source, a buffer or a file
+        std::vector<uint8_t> _audio;
+        std::size_t _offset = 0;
+        std::unique_ptr<std::istream> _file;
+        std::vector<uint8_t> _chunk;
+    };
+}
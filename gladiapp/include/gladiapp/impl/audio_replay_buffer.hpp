@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace gladiapp::v2::ws
+{
+    /**
+     * Ring of the last audio bytes written to the socket, kept until the server acknowledges them
+     * (audio_chunk byte ranges) so that they can be sent again on a new connection. Offsets count the
+     * bytes of the session's audio stream from its start, as the server does, including audio sent as JSON:
+     * those bytes are skipped rather than kept, and count as lost if a connection drops before they are
+     * acknowledged.
+     */
+    class AudioReplayBuffer
+    {
+    public:
+        explicit AudioReplayBuffer(std::size_t capacity)
+        {
+            setCapacity(capacity);
+        }
+
+        /**
+         * Resizes the ring, keeping its most recent bytes.
+         */
+        void setCapacity(std::size_t capacity)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_size > capacity)
+            {
+                dropOldest(_size - capacity);
+            }
+            std::vector<uint8_t> kept(_size);
+            copyOut(0, kept.data(), kept.size());
+            _ring.assign(capacity, 0);
+            std::copy(kept.begin(), kept.end(), _ring.begin());
+            _head = 0;
+        }
+
+        void append(const void *data, std::size_t size)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const auto *bytes = static_cast<const uint8_t *>(data);
+            const std::size_t capacity = _ring.size();
+            if (size >= capacity)
+            {
+                _gaps.clear();
+                _end += size;
+                _begin = _end - capacity;
+                std::copy(bytes + (size - capacity), bytes + size, _ring.begin());
+                _head = 0;
+                _size = capacity;
+                return;
+            }
+            // the oldest bytes make room, acknowledged or not
+            if (_size + size > capacity)
+            {
+                dropOldest(_size + size - capacity);
+            }
+            const std::size_t tail = (_head + _size) % capacity;
+            const std::size_t first = std::min(size, capacity - tail);
+            std::memcpy(_ring.data() + tail, bytes, first);
+            std::memcpy(_ring.data(), bytes + first, size - first);
+            _size += size;
+            _end += size;
+        }
+
+        /**
+         * Counts audio bytes sent in a form that cannot be replayed (JSON), so that the offsets of the bytes
+         * appended next match the server's.
+         */
+        void skip(std::size_t size)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (size == 0)
+            {
+                return;
+            }
+            if (!_gaps.empty() && _gaps.back().offset + _gaps.back().size == _end)
+            {
+                _gaps.back().size += size;
+            }
+            else
+            {
+                _gaps.push_back(Gap{_end, size});
+            }
+            _end += size;
+        }
+
+        /**
+         * Releases the bytes before the end of an acknowledged range.
+         */
+        void acknowledge(std::uint64_t end)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            end = std::min(end, _end);
+            if (end <= _acknowledged)
+            {
+                return;
+            }
+            _acknowledged = end;
+            while (_begin < end)
+            {
+                if (!_gaps.empty() && _gaps.front().offset == _begin)
+                {
+                    Gap &gap = _gaps.front();
+                    const std::uint64_t released = std::min(gap.size, end - _begin);
+                    _begin += released;
+                    gap.offset += released;
+                    gap.size -= released;
+                    if (gap.size == 0)
+                    {
+                        _gaps.pop_front();
+                    }
+                    continue;
+                }
+                const std::uint64_t stop = _gaps.empty() ? end : std::min(end, _gaps.front().offset);
+                releaseStored(static_cast<std::size_t>(stop - _begin));
+            }
+        }
+
+        /**
+         * Hands the unacknowledged bytes still held to send(const uint8_t *data, std::size_t size), in frames
+         * of at most frameBytes, and counts the unacknowledged bytes the ring no longer held, or never held,
+         * as lost. The server numbers the replayed bytes from its last acknowledgment, so do the offsets.
+         * @return false if a send failed.
+         */
+        template <typename Send>
+        bool replay(std::size_t frameBytes, Send &&send)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _lostBytes += _begin - _acknowledged;
+            for (const Gap &gap : _gaps)
+            {
+                _lostBytes += gap.size;
+            }
+            _gaps.clear();
+            _begin = _acknowledged;
+            _end = _begin + _size;
+            std::vector<uint8_t> frame;
+            for (std::size_t offset = 0; offset < _size; offset += frameBytes)
+            {
+                frame.resize(std::min(frameBytes, _size - offset));
+                copyOut(offset, frame.data(), frame.size());
+                if (!send(frame.data(), frame.size()))
+                {
+                    return false;
+                }
+                _replayedBytes += frame.size();
+            }
+            return true;
+        }
+
+        std::uint64_t replayedBytes() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _replayedBytes;
+        }
+
+        std::uint64_t lostBytes() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _lostBytes;
+        }
+
+    private:
+        struct Gap
+        {
+            std::uint64_t offset;
+            std::uint64_t size;
+        };
+
+        /**
+         * Releases bytes held from the front of the ring, the stream offset moving past them.
+         */
+        void releaseStored(std::size_t size)
+        {
+            _head = _ring.empty() ? 0 : (_head + size) % _ring.size();
+            _size -= size;
+            _begin += size;
+        }
+
+        /**
+         * Drops the oldest bytes held, with the skipped ranges among or before them.
+         */
+        void dropOldest(std::size_t size)
+        {
+            while (size > 0)
+            {
+                if (!_gaps.empty() && _gaps.front().offset == _begin)
+                {
+                    _begin += _gaps.front().size;
+                    _gaps.pop_front();
+                    continue;
+                }
+                const std::size_t run = _gaps.empty() ? size : static_cast<std::size_t>(std::min<std::uint64_t>(size, _gaps.front().offset - _begin));
+                releaseStored(run);
+                size -= run;
+            }
+        }
+
+        /**
+         * Copies bytes held, from an offset relative to the oldest one.
+         */
+        void copyOut(std::size_t offset, uint8_t *destination, std::size_t size) const
+        {
+            if (size == 0)
+            {
+                return;
+            }
+            const std::size_t start = (_head + offset) % _ring.size();
+            const std::size_t first = std::min(size, _ring.size() - start);
+            std::memcpy(destination, _ring.data() + start, first);
+            std::memcpy(destination + first, _ring.data(), size - first);
+        }
+
+    private:
+        mutable std::mutex _mutex;
+        std::vector<uint8_t> _ring;
+        std::size_t _head = 0;
+        std::size_t _size = 0;
+        // stream offsets of the oldest byte still tracked and past the last byte appended or skipped; the
+        // bytes held and the skipped ranges cover [_begin, _end)
+        std::uint64_t _begin = 0;
+        std::uint64_t _end = 0;
+        std::deque<Gap> _gaps;
+        std::uint64_t _acknowledged = 0;
+        std::uint64_t _replayedBytes = 0;
+        std::uint64_t _lostBytes = 0;
+    };
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gladiapp::v2::base64_util
+{
+    /**
+     * Length of the padded base64 encoding of size bytes.
+     */
+    constexpr std::size_t encodedLength(std::size_t size)
+    {
+        return (size + 2) / 3 * 4;
+    }
+
+    /**
+     * Encodes size bytes into out, which must hold encodedLength(size) characters (no terminator is written).
+     * Uses AVX2 or SSSE3 when the CPU supports them, picked once at runtime, the scalar encoder otherwise.
+     */
+    void encode(const std::uint8_t *data, std::size_t size, char *out);
+
+    /**
+     * Name of the encoder selected for this CPU ("avx2", "ssse3" or "scalar").
+     */
+    const char *encoderName();
+
+    using EncodeFunction = void (*)(const std::uint8_t *data, std::size_t size, char *out);
+
+    /**
+     * A given encoder ("avx2", "ssse3" or "scalar"), nullptr when this CPU or build lacks it.
+     * For the tests and benchmarks comparing them, encode() picks the fastest.
+     */
+    EncodeFunction encoderFor(const char *name);
+}
@@ -0,0 +1,416 @@
+#pragma once
+
+#include "../gladiapp_ws.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace gladiapp::v2::ws
+{
+    /**
+     * Worker threads running the event callbacks of live sessions. Each session posts to its own strand,
+     * which runs the session's tasks one at a time in posting order. A strand with pending tasks sits in
+     * one worker's deque; the worker runs a batch of it and queues it again behind the others if more
+     * arrived meanwhile, while an idle worker steals strands from the back of the busy workers' deques.
+     */
+    class CallbackExecutor : public std::enable_shared_from_this<CallbackExecutor>
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Task = std::function<void()>;
+
+        class Strand : public std::enable_shared_from_this<Strand>
+        {
+        public:
+            Strand(std::shared_ptr<CallbackExecutor> executor, const CallbackExecutorOptions &options)
+                : _executor(std::move(executor)), _options(options)
+            {
+                _options.capacity = std::max<std::size_t>(_options.capacity, 1);
+            }
+
+            /**
+             * Queues a task, from the thread draining the socket. Droppable tasks (messages) follow the
+             * overflow policy, the others are always queued.
+             * @return false once the strand is closed.
+             */
+            bool post(Task task, bool droppable)
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (droppable && _entries.size() >= _options.capacity)
+                {
+                    if (_options.overflowPolicy == CallbackExecutorOptions::OverflowPolicy::BLOCK)
+                    {
+                        _condition.wait(lock, [this]()
+                                        { return _closed || _entries.size() < _options.capacity; });
+                    }
+                    else
+                    {
+                        dropOldestMessage();
+                    }
+                }
+                if (_closed)
+                {
+                    return false;
+                }
+                _entries.push_back(Entry{std::move(task), Clock::now(), droppable});
+                _stats.maxDepth = std::max(_stats.maxDepth, _entries.size());
+                _executor->recordQueued();
+                if (_scheduled)
+                {
+                    return true;
+                }
+                _scheduled = true;
+                lock.unlock();
+                _executor->schedule(shared_from_this());
+                return true;
+            }
+
+            /**
+             * Waits until the tasks queued so far have run. Returns at once when called from one of them.
+             */
+            void drain()
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (_running && _runningOn == std::this_thread::get_id())
+                {
+                    return;
+                }
+                _condition.wait(lock, [this]()
+                                { return _closed || (_entries.empty() && !_running); });
+            }
+
+            /**
+             * Discards the pending tasks and refuses the later ones, then waits for the running task unless
+             * called from it.
+             */
+            void close()
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _closed = true;
+                _stats.droppedEvents += _entries.size();
+                _executor->recordDropped(_entries.size());
+                _entries.clear();
+                _condition.notify_all();
+                if (_runningOn != std::this_thread::get_id())
+                {
+                    _condition.wait(lock, [this]()
+                                    { return !_running; });
+                }
+            }
+
+            void reopen()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _closed = false;
+            }
+
+            CallbackExecutorStats stats() const
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                CallbackExecutorStats stats = _stats;
+                stats.depth = _entries.size();
+                stats.meanQueueLatencyMs = stats.executedEvents != 0 ? _totalLatencyMs / static_cast<double>(stats.executedEvents) : 0.0;
+                return stats;
+            }
+
+        private:
+            friend class CallbackExecutor;
+
+            struct Entry
+            {
+                Task task;
+                Clock::time_point queuedAt;
+                bool droppable;
+            };
+
+            void dropOldestMessage()
+            {
+                auto oldest = std::find_if(_entries.begin(), _entries.end(), [](const Entry &entry)
+                                           { return entry.droppable; });
+                if (oldest != _entries.end())
+                {
+                    _entries.erase(oldest);
+                    ++_stats.droppedEvents;
+                    _executor->recordDropped(1);
+                }
+            }
+
+            /**
+             * Runs up to maxTasks tasks on the calling worker.
+             * @return true if tasks remain, the strand then stays scheduled and must be queued again.
+             */
+            bool runBatch(std::size_t maxTasks, bool stolen)
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _running = true;
+                _runningOn = std::this_thread::get_id();
+                if (stolen)
+                {
+                    ++_stats.stolenBatches;
+                }
+                for (std::size_t i = 0; i < maxTasks && !_entries.empty(); ++i)
+                {
+                    Entry entry = std::move(_entries.front());
+                    _entries.pop_front();
+                    const double latencyMs = std::chrono::duration<double, std::milli>(Clock::now() - entry.queuedAt).count();
+                    _condition.notify_all();
+                    lock.unlock();
+                    try
+                    {
+                        entry.task();
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::error("Error in session callback: {}", e.what());
+                    }
+                    entry.task = nullptr;
+                    _executor->recordExecuted(latencyMs);
+                    lock.lock();
+                    ++_stats.executedEvents;
+                    _totalLatencyMs += latencyMs;
+                    _stats.maxQueueLatencyMs = std::max(_stats.maxQueueLatencyMs, latencyMs);
+                }
+                _running = false;
+                _runningOn = std::thread::id();
+                const bool remaining = !_entries.empty();
+                _scheduled = remaining;
+                _condition.notify_all();
+                return remaining;
+            }
+
+        private:
+            const std::shared_ptr<CallbackExecutor> _executor;
+            CallbackExecutorOptions _options;
+
+            mutable std::mutex _mutex;
+            // space freed, task done or strand closed
+            std::condition_variable _condition;
+            std::deque<Entry> _entries;
+            // queued on a worker or running
+            bool _scheduled = false;
+            bool _running = false;
+            std::thread::id _runningOn;
+            bool _closed = false;
+
+            CallbackExecutorStats _stats;
+            double _totalLatencyMs = 0.0;
+        };
+
+        explicit CallbackExecutor(std::size_t threadCount)
+        {
+            for (std::size_t i = 0; i < std::max<std::size_t>(threadCount, 1); ++i)
+            {
+                _workers.push_back(std::make_unique<Worker>());
+            }
+            for (std::size_t i = 0; i < _workers.size(); ++i)
+            {
+                _workers[i]->thread = std::thread([this, i]()
+                                                  { run(i); });
+            }
+        }
+
+        /**
+         * Stops the workers. Strands hold the executor, so this only happens once every session has released
+         * its strand; a worker releasing the last one lets itself finish on its own.
+         */
+        ~CallbackExecutor()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_sleepMutex);
+                _stopping = true;
+            }
+            _sleepCondition.notify_all();
+            for (auto &worker : _workers)
+            {
+                if (worker->thread.get_id() == std::this_thread::get_id())
+                {
+                    t_released = true;
+                    worker->thread.detach();
+                }
+                else if (worker->thread.joinable())
+                {
+                    worker->thread.join();
+                }
+            }
+        }
+
+        std::shared_ptr<Strand> makeStrand(const CallbackExecutorOptions &options)
+        {
+            return std::make_shared<Strand>(shared_from_this(), options);
+        }
+
+        CallbackExecutorStats stats() const
+        {
+            CallbackExecutorStats stats;
+            stats.depth = _depth.load(std::memory_order_relaxed);
+            stats.maxDepth = _maxDepth.load(std::memory_order_relaxed);
+            stats.executedEvents = _executed.load(std::memory_order_relaxed);
+            stats.droppedEvents = _dropped.load(std::memory_order_relaxed);
+            stats.stolenBatches = _stolen.load(std::memory_order_relaxed);
+            const double totalLatencyMs = static_cast<double>(_totalLatencyUs.load(std::memory_order_relaxed)) / 1000.0;
+            stats.meanQueueLatencyMs = stats.executedEvents != 0 ? totalLatencyMs / static_cast<double>(stats.executedEvents) : 0.0;
+            stats.maxQueueLatencyMs = static_cast<double>(_maxLatencyUs.load(std::memory_order_relaxed)) / 1000.0;
+            return stats;
+        }
+
+    private:
+        static constexpr std::size_t BATCH_TASKS = 32;
+
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<std::shared_ptr<Strand>> strands;
+            std::thread thread;
+        };
+
+        /**
+         * Queues a strand with pending tasks: a worker queues its own strands on its deque, the other threads
+         * spread them over the workers in turn.
+         */
+        void schedule(std::shared_ptr<Strand> strand)
+        {
+            const std::size_t index = t_executor == this ? t_workerIndex
+                                                         : _nextWorker.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+            {
+                std::lock_guard<std::mutex> lock(_workers[index]->mutex);
+                _workers[index]->strands.push_back(std::move(strand));
+            }
+            {
+                std::lock_guard<std::mutex> lock(_sleepMutex);
+                ++_scheduledStrands;
+            }
+            _sleepCondition.notify_one();
+        }
+
+        /**
+         * Takes the oldest strand of the worker's deque, or steals the newest one of another worker.
+         */
+        std::shared_ptr<Strand> take(std::size_t index, bool &stolen)
+        {
+            for (std::size_t offset = 0; offset < _workers.size(); ++offset)
+            {
+                Worker &worker = *_workers[(index + offset) % _workers.size()];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                if (worker.strands.empty())
+                {
+                    continue;
+                }
+                std::shared_ptr<Strand> strand;
+                if (offset == 0)
+                {
+                    strand = std::move(worker.strands.front());
+                    worker.strands.pop_front();
+                }
+                else
+                {
+                    strand = std::move(worker.strands.back());
+                    worker.strands.pop_back();
+                }
+                stolen = offset != 0;
+                return strand;
+            }
+            return nullptr;
+        }
+
+        void run(std::size_t index)
+        {
+            t_executor = this;
+            t_workerIndex = index;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_sleepMutex);
+                    _sleepCondition.wait(lock, [this]()
+                                         { return _stopping || _scheduledStrands > 0; });
+                    if (_stopping)
+                    {
+                        return;
+                    }
+                    // the strands are in the deques before being counted, this one is there for us
+                    --_scheduledStrands;
+                }
+                bool stolen = false;
+                std::shared_ptr<Strand> strand;
+                while (strand == nullptr)
+                {
+                    strand = take(index, stolen);
+                }
+                if (stolen)
+                {
+                    _stolen.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (strand->runBatch(BATCH_TASKS, stolen))
+                {
+                    schedule(std::move(strand));
+                }
+                // releasing the last strand may destroy the executor from this thread
+                strand.reset();
+                if (t_released)
+                {
+                    return;
+                }
+            }
+        }
+
+        void recordQueued()
+        {
+            const std::size_t depth = _depth.fetch_add(1, std::memory_order_relaxed) + 1;
+            std::size_t maxDepth = _maxDepth.load(std::memory_order_relaxed);
+            while (depth > maxDepth && !_maxDepth.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void recordExecuted(double latencyMs)
+        {
+            _depth.fetch_sub(1, std::memory_order_relaxed);
+            _executed.fetch_add(1, std::memory_order_relaxed);
+            const auto latencyUs = static_cast<std::uint64_t>(latencyMs * 1000.0);
+            _totalLatencyUs.fetch_add(latencyUs, std::memory_order_relaxed);
+            std::uint64_t maxLatencyUs = _maxLatencyUs.load(std::memory_order_relaxed);
+            while (latencyUs > maxLatencyUs && !_maxLatencyUs.compare_exchange_weak(maxLatencyUs, latencyUs, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void recordDropped(std::size_t count)
+        {
+            _depth.fetch_sub(count, std::memory_order_relaxed);
+            _dropped.fetch_add(count, std::memory_order_relaxed);
+        }
+
+    private:
+        // executor and index of the worker running on this thread, if any
+        static inline thread_local const CallbackExecutor *t_executor = nullptr;
+        static inline thread_local std::size_t t_workerIndex = 0;
+        // set when a worker destroyed its own executor
+        static inline thread_local bool t_released = false;
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+        std::atomic<std::size_t> _nextWorker{0};
+
+        std::mutex _sleepMutex;
+        std::condition_variable _sleepCondition;
+        // strands in the deques that no worker has claimed yet
+        std::size_t _scheduledStrands = 0;
+        bool _stopping = false;
+
+        std::atomic<std::size_t> _depth{0};
+        std::atomic<std::size_t> _maxDepth{0};
+        std::atomic<std::uint64_t> _executed{0};
+        std::atomic<std::uint64_t> _dropped{0};
+        std::atomic<std::uint64_t> _stolen{0};
+        std::atomic<std::uint64_t> _totalLatencyUs{0};
+        std::atomic<std::uint64_t> _maxLatencyUs{0};
+    };
+}
@@ -1,12 +1,24 @@
 #pragma once
 
 #include "../gladiapp.hpp"
+#include "../gladiapp_transport.hpp"
 #include "../utils.hpp"
 #include <curl/curl.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <filesystem>
+#include <functional>
 #include <string>
 #include <stdexcept>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 namespace gladiapp::v2::curl_util
 {
@@ -35,11 +47,209 @@ namespace gladiapp::v2::curl_util
         return size * nmemb;
     }
 
+    /**
+     * Destination of a response body streamed to HttpRequest::bodySink.
+     */
+    struct StreamingWriteContext
+    {
+        CURL *curl = nullptr;
+        std::string *body = nullptr;
+        const std::function<bool(const char *, size_t)> *sink = nullptr;
+    };
+
+    inline size_t streamingWriteCallback(char *ptr, size_t size, size_t nmemb, void *userdata)
+    {
+        auto *context = static_cast<StreamingWriteContext *>(userdata);
+        long statusCode = 0;
+        curl_easy_getinfo(context->curl, CURLINFO_RESPONSE_CODE, &statusCode);
+        if (statusCode < 200 || statusCode >= 300)
+        {
+            context->body->append(ptr, size * nmemb);
+            return size * nmemb;
+        }
+        // any other value than size * nmemb makes curl fail with CURLE_WRITE_ERROR
+        return (*context->sink)(ptr, size * nmemb) ? size * nmemb : 0;
+    }
+
     inline std::string buildUrl(const std::string &path)
     {
         return "https://" + std::string(gladiapp::v2::common::HOST) + path;
     }
 
+    // Origin of a URL for HTTP requests to the same server: "wss://host:port/path" -> "https://host:port",
+    // "ws://host/path" -> "http://host". Empty if the URL cannot be parsed.
+    inline std::string httpOrigin(const std::string &url)
+    {
+        std::string origin;
+        CURLU *handle = curl_url();
+        char *scheme = nullptr;
+        char *host = nullptr;
+        char *port = nullptr;
+        if (handle != nullptr && curl_url_set(handle, CURLUPART_URL, url.c_str(), CURLU_NON_SUPPORT_SCHEME) == CURLUE_OK &&
+            curl_url_get(handle, CURLUPART_SCHEME, &scheme, 0) == CURLUE_OK &&
+            curl_url_get(handle, CURLUPART_HOST, &host, 0) == CURLUE_OK)
+        {
+            const std::string plain(scheme);
+            origin = (plain == "ws" || plain == "http" ? "http://" : "https://") + std::string(host);
+            if (curl_url_get(handle, CURLUPART_PORT, &port, 0) == CURLUE_OK)
+            {
+                origin += ":" + std::string(port);
+            }
+        }
+        curl_free(scheme);
+        curl_free(host);
+        curl_free(port);
+        curl_url_cleanup(handle);
+        return origin;
+    }
+
+    // Plain URL of the TCP endpoint behind an origin ("https://host" -> "http://host:443"), for a
+    // CURLOPT_CONNECT_ONLY transfer opening a bare TCP connection. Empty if the origin cannot be parsed.
+    inline std::string tcpUrl(const std::string &origin)
+    {
+        std::string url;
+        CURLU *handle = curl_url();
+        char *host = nullptr;
+        char *port = nullptr;
+        if (handle != nullptr && curl_url_set(handle, CURLUPART_URL, origin.c_str(), 0) == CURLUE_OK &&
+            curl_url_get(handle, CURLUPART_HOST, &host, 0) == CURLUE_OK &&
+            curl_url_get(handle, CURLUPART_PORT, &port, CURLU_DEFAULT_PORT) == CURLUE_OK)
+        {
+            url = "http://" + std::string(host) + ":" + std::string(port) + "/";
+        }
+        curl_free(host);
+        curl_free(port);
+        curl_url_cleanup(handle);
+        return url;
+    }
+
+    /**
+     * TCP connection opened ahead of a transfer, which then skips the TCP handshake: curl's open socket
+     * callback gets the socket and its socket option callback reports it connected. Closed if never used.
+     * Not available on Windows, take() returns null there.
+     */
+    class PreconnectedSocket
+    {
+    public:
+        /**
+         * Keeps the connection of a completed CURLOPT_CONNECT_ONLY transfer, the handle can be cleaned up.
+         */
+        static std::unique_ptr<PreconnectedSocket> take(CURL *connectOnly)
+        {
+#ifdef _WIN32
+            (void)connectOnly;
+            return nullptr;
+#else
+            curl_socket_t sockfd = CURL_SOCKET_BAD;
+            if (curl_easy_getinfo(connectOnly, CURLINFO_ACTIVESOCKET, &sockfd) != CURLE_OK || sockfd == CURL_SOCKET_BAD)
+            {
+                return nullptr;
+            }
+            // the handle closes its own descriptor, the connection lives on through the duplicate
+            int duplicate = ::dup(sockfd);
+            if (duplicate < 0)
+            {
+                return nullptr;
+            }
+            return std::unique_ptr<PreconnectedSocket>(new PreconnectedSocket(duplicate));
+#endif
+        }
+
+        ~PreconnectedSocket()
+        {
+#ifndef _WIN32
+            if (_sockfd != CURL_SOCKET_BAD)
+            {
+                ::close(_sockfd);
+            }
+#endif
+        }
+
+        PreconnectedSocket(const PreconnectedSocket &) = delete;
+        PreconnectedSocket &operator=(const PreconnectedSocket &) = delete;
+
+        /**
+         * Makes the next transfer of the handle use the connection; the object must outlive that transfer.
+         */
+        void apply(CURL *curl)
+        {
+            curl_easy_setopt(curl, CURLOPT_OPENSOCKETFUNCTION, openSocket);
+            curl_easy_setopt(curl, CURLOPT_OPENSOCKETDATA, this);
+            curl_easy_setopt(curl, CURLOPT_SOCKOPTFUNCTION, socketOptions);
+            curl_easy_setopt(curl, CURLOPT_SOCKOPTDATA, this);
+        }
+
+        /**
+         * True once curl took the connection, which it then closes itself.
+         */
+        bool handedOver() const
+        {
+            return _handedOver != CURL_SOCKET_BAD;
+        }
+
+    private:
+        explicit PreconnectedSocket(curl_socket_t sockfd)
+            : _sockfd(sockfd)
+        {
+        }
+
+        static curl_socket_t openSocket(void *clientp, curlsocktype purpose, struct curl_sockaddr *address)
+        {
+            auto *self = static_cast<PreconnectedSocket *>(clientp);
+            if (purpose == CURLSOCKTYPE_IPCXN && self->_sockfd != CURL_SOCKET_BAD)
+            {
+                self->_handedOver = self->_sockfd;
+                self->_sockfd = CURL_SOCKET_BAD;
+                return self->_handedOver;
+            }
+            return ::socket(address->family, address->socktype, address->protocol);
+        }
+
+        static int socketOptions(void *clientp, curl_socket_t sockfd, curlsocktype)
+        {
+            return sockfd == static_cast<PreconnectedSocket *>(clientp)->_handedOver ? CURL_SOCKOPT_ALREADY_CONNECTED : CURL_SOCKOPT_OK;
+        }
+
+        curl_socket_t _sockfd;
+        curl_socket_t _handedOver = CURL_SOCKET_BAD;
+    };
+
+    /**
+     * Durations in milliseconds of the connection steps of a completed transfer, from curl's
+     * cumulative timers. A step skipped (cached address, reused connection, no TLS) lasts 0.
+     */
+    struct ConnectPhases
+    {
+        double dnsMs = 0.0;
+        double tcpMs = 0.0;
+        double tlsMs = 0.0;
+        // request and response, after the connection was established
+        double transferMs = 0.0;
+        double totalMs = 0.0;
+    };
+
+    inline ConnectPhases connectPhases(CURL *curl)
+    {
+        curl_off_t nameLookup = 0;
+        curl_off_t connect = 0;
+        curl_off_t appConnect = 0;
+        curl_off_t total = 0;
+        curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &nameLookup);
+        curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+        curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &appConnect);
+        curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+        // the timers are in microseconds, 0 when the step did not happen
+        connect = std::max(connect, nameLookup);
+        const curl_off_t established = std::max(appConnect, connect);
+        ConnectPhases phases;
+        phases.dnsMs = static_cast<double>(nameLookup) / 1000.0;
+        phases.tcpMs = static_cast<double>(connect - nameLookup) / 1000.0;
+        phases.tlsMs = appConnect > 0 ? static_cast<double>(appConnect - connect) / 1000.0 : 0.0;
+        phases.transferMs = static_cast<double>(std::max(total - established, curl_off_t{0})) / 1000.0;
+        phases.totalMs = static_cast<double>(total) / 1000.0;
+        return phases;
+    }
+
     // mbedTLS (curl's TLS backend on Android) ships with no built-in trust
     // anchors, so without an explicit CA file every handshake fails with
     // "SSL peer certificate ... was not OK". caFilePath is empty on platforms
@@ -52,134 +262,400 @@ namespace gladiapp::v2::curl_util
         }
     }
 
-    // Performs a synchronous HTTPS request against api.gladia.io.
-    // method: "GET", "POST" or "DELETE". body/contentType are only used for POST.
-    inline HttpResponse performRequest(const std::string &url,
-                                       const std::string &method,
-                                       const std::string &apiKey,
-                                       const std::string &body = "",
-                                       const std::string &contentType = "",
-                                       const std::string &caFilePath = {})
+    // DEFAULT leaves CURLOPT_HTTP_VERSION to libcurl (pooled handles are reset before reuse).
+    // CURL_HTTP_VERSION_2TLS negotiates h2 through ALPN and falls back to HTTP/1.1 on its own.
+    // PIPEWAIT makes a transfer wait for a connection it can multiplex on instead of opening a new one.
+    inline void applyHttpVersion(CURL *curl, TransportOptions::HttpVersion httpVersion)
     {
-        ensureGlobalInit();
+        if (httpVersion == TransportOptions::HttpVersion::HTTP_2)
+        {
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+            curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+        }
+        else if (httpVersion == TransportOptions::HttpVersion::HTTP_1_1)
+        {
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1));
+        }
+    }
 
-        CURL *curl = curl_easy_init();
-        if (!curl)
+    /**
+     * Pool of reusable easy handles sharing one CURLSH (DNS cache, TLS session cache and
+     * connection cache), so consecutive requests of a client skip the TCP + TLS handshake.
+     * Owned by the client implementations; safe to use from several threads at once.
+     * Without shareConnections only the DNS and TLS session caches are shared, for handles
+     * whose connection must stay their own (CURLOPT_CONNECT_ONLY).
+     */
+    class ConnectionPool
+    {
+    public:
+        explicit ConnectionPool(size_t maxIdleHandles = 16, bool shareConnections = true)
+            : _maxIdleHandles(maxIdleHandles)
         {
-            throw std::runtime_error("Failed to initialize curl easy handle");
+            ensureGlobalInit();
+            _share = curl_share_init();
+            if (_share == nullptr)
+            {
+                throw std::runtime_error("Failed to initialize curl share handle");
+            }
+            curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, lockCallback);
+            curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, unlockCallback);
+            curl_share_setopt(_share, CURLSHOPT_USERDATA, this);
+            curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            if (shareConnections)
+            {
+                curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+            }
         }
-        applyCaFile(curl, caFilePath);
 
-        struct curl_slist *headerList = nullptr;
-        std::string apiKeyHeader = std::string(gladiapp::v2::headers::X_GLADIA_KEY) + ": " + apiKey;
-        headerList = curl_slist_append(headerList, apiKeyHeader.c_str());
-        if (!contentType.empty())
+        ~ConnectionPool()
         {
-            headerList = curl_slist_append(headerList, ("Content-Type: " + contentType).c_str());
+            // every easy handle attached to the share must be gone before the share itself
+            for (CURL *curl : _idleHandles)
+            {
+                curl_easy_cleanup(curl);
+            }
+            _idleHandles.clear();
+            curl_share_cleanup(_share);
         }
 
-        HttpResponse response;
+        ConnectionPool(const ConnectionPool &) = delete;
+        ConnectionPool &operator=(const ConnectionPool &) = delete;
 
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerList);
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, gladiapp::v2::common::USER_AGENT);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
-        // The live session endpoints redirect to a regional host (e.g. api.us-west-1.gladia.io).
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-        curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 5L);
-        curl_easy_setopt(curl, CURLOPT_POSTREDIR, CURL_REDIR_POST_ALL);
+        /**
+         * Returns an easy handle attached to the share, either an idle one or a new one.
+         * Options of a reused handle are reset, its connection and caches are kept.
+         */
+        CURL *acquire()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_idleMutex);
+                if (!_idleHandles.empty())
+                {
+                    CURL *curl = _idleHandles.back();
+                    _idleHandles.pop_back();
+                    _handlesReused++;
+                    return curl;
+                }
+            }
+            CURL *curl = curl_easy_init();
+            if (curl == nullptr)
+            {
+                throw std::runtime_error("Failed to initialize curl easy handle");
+            }
+            curl_easy_setopt(curl, CURLOPT_SHARE, _share);
+            _handlesCreated++;
+            return curl;
+        }
 
-        if (method == "POST")
+        /**
+         * Gives a handle back to the pool. Handles beyond maxIdleHandles are destroyed.
+         */
+        void release(CURL *curl)
         {
-            curl_easy_setopt(curl, CURLOPT_POST, 1L);
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.size()));
+            if (curl == nullptr)
+            {
+                return;
+            }
+            curl_easy_reset(curl);
+            {
+                std::lock_guard<std::mutex> lock(_idleMutex);
+                if (_idleHandles.size() < _maxIdleHandles)
+                {
+                    _idleHandles.push_back(curl);
+                    return;
+                }
+            }
+            curl_easy_cleanup(curl);
         }
-        else if (method == "DELETE")
+
+        /**
+         * Updates the connection counters from a completed transfer.
+         */
+        void recordTransfer(CURL *curl)
         {
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+            long newConnections = 0;
+            curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &newConnections);
+            _requests++;
+            if (newConnections > 0)
+            {
+                _connectionsCreated += static_cast<std::uint64_t>(newConnections);
+            }
+            else
+            {
+                _connectionsReused++;
+            }
         }
 
-        CURLcode res = curl_easy_perform(curl);
-        if (res != CURLE_OK)
+        CURLSH *share() const
         {
-            std::string errorMessage = curl_easy_strerror(res);
-            curl_slist_free_all(headerList);
-            curl_easy_cleanup(curl);
-            throw std::runtime_error("curl request failed: " + errorMessage);
+            return _share;
         }
 
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.statusCode);
+        ConnectionPoolStats stats() const
+        {
+            ConnectionPoolStats stats;
+            stats.requests = _requests.load();
+            stats.handlesCreated = _handlesCreated.load();
+            stats.handlesReused = _handlesReused.load();
+            stats.connectionsCreated = _connectionsCreated.load();
+            stats.connectionsReused = _connectionsReused.load();
+            return stats;
+        }
 
-        curl_slist_free_all(headerList);
-        curl_easy_cleanup(curl);
-        return response;
-    }
+    private:
+        static void lockCallback(CURL *, curl_lock_data data, curl_lock_access, void *userptr)
+        {
+            static_cast<ConnectionPool *>(userptr)->_shareMutexes[static_cast<size_t>(data) % CURL_LOCK_DATA_LAST].lock();
+        }
 
-    // Performs a synchronous multipart/form-data file upload.
-    inline HttpResponse performUpload(const std::string &url,
-                                      const std::string &apiKey,
-                                      const std::string &filePath,
-                                      const std::string &fieldName = "audio",
-                                      const std::string &fileContentType = "audio/mpeg",
-                                      const std::string &caFilePath = {})
+        static void unlockCallback(CURL *, curl_lock_data data, void *userptr)
+        {
+            static_cast<ConnectionPool *>(userptr)->_shareMutexes[static_cast<size_t>(data) % CURL_LOCK_DATA_LAST].unlock();
+        }
+
+        size_t _maxIdleHandles;
+        CURLSH *_share = nullptr;
+        std::mutex _shareMutexes[CURL_LOCK_DATA_LAST];
+        std::mutex _idleMutex;
+        std::vector<CURL *> _idleHandles;
+
+        std::atomic<std::uint64_t> _requests{0};
+        std::atomic<std::uint64_t> _handlesCreated{0};
+        std::atomic<std::uint64_t> _handlesReused{0};
+        std::atomic<std::uint64_t> _connectionsCreated{0};
+        std::atomic<std::uint64_t> _connectionsReused{0};
+    };
+
+    /**
+     * Scoped easy handle: taken from the pool when one is given, created otherwise.
+     */
+    class EasyHandle
     {
-        ensureGlobalInit();
+    public:
+        explicit EasyHandle(ConnectionPool *pool)
+            : _pool(pool)
+        {
+            ensureGlobalInit();
+            _curl = _pool != nullptr ? _pool->acquire() : curl_easy_init();
+            if (_curl == nullptr)
+            {
+                throw std::runtime_error("Failed to initialize curl easy handle");
+            }
+        }
 
-        if (!std::filesystem::exists(filePath))
+        ~EasyHandle()
         {
-            throw std::runtime_error("Cannot open file: " + filePath);
+            if (_pool != nullptr)
+            {
+                _pool->release(_curl);
+            }
+            else
+            {
+                curl_easy_cleanup(_curl);
+            }
         }
 
-        CURL *curl = curl_easy_init();
-        if (!curl)
+        EasyHandle(const EasyHandle &) = delete;
+        EasyHandle &operator=(const EasyHandle &) = delete;
+
+        CURL *get() const
+        {
+            return _curl;
+        }
+
+        void recordTransfer()
         {
-            throw std::runtime_error("Failed to initialize curl easy handle");
+            if (_pool != nullptr)
+            {
+                _pool->recordTransfer(_curl);
+            }
         }
-        applyCaFile(curl, caFilePath);
 
-        struct curl_slist *headerList = nullptr;
-        std::string apiKeyHeader = std::string(gladiapp::v2::headers::X_GLADIA_KEY) + ": " + apiKey;
-        headerList = curl_slist_append(headerList, apiKeyHeader.c_str());
+    private:
+        ConnectionPool *_pool;
+        CURL *_curl;
+    };
 
-        curl_mime *mime = curl_mime_init(curl);
-        curl_mimepart *part = curl_mime_addpart(mime);
-        curl_mime_name(part, fieldName.c_str());
-        curl_mime_filedata(part, filePath.c_str());
-        curl_mime_type(part, fileContentType.c_str());
+    /**
+     * Describes one HTTPS request against api.gladia.io.
+     * method: "GET", "POST" or "DELETE". body/contentType are only used for POST.
+     * A non-empty uploadFilePath turns the request into a multipart/form-data file upload.
+     */
+    struct HttpRequest
+    {
+        std::string url;
+        std::string method = "GET";
+        std::string body;
+        std::string contentType;
+        std::string uploadFilePath;
+        std::string uploadFieldName = "audio";
+        std::string uploadContentType = "audio/mpeg";
+        /**
+         * When set, a successful (2xx) response body is handed to the sink chunk by chunk as it arrives
+         * instead of being accumulated in HttpResponse::body; returning false aborts the transfer.
+         * Error bodies are still accumulated so they can be parsed as a TranscriptionError.
+         */
+        std::function<bool(const char *data, size_t size)> bodySink;
+    };
 
-        HttpResponse response;
+    /**
+     * Configures an easy handle for a request and owns the header list and mime data the
+     * handle points to until the transfer is over. The request and the response body must
+     * outlive the setup.
+     */
+    class TransferSetup
+    {
+    public:
+        TransferSetup(CURL *curl,
+                      const HttpRequest &request,
+                      const std::string &apiKey,
+                      const std::string &caFilePath,
+                      std::string *responseBody,
+                      TransportOptions::HttpVersion httpVersion = TransportOptions::HttpVersion::DEFAULT)
+        {
+            const bool isUpload = !request.uploadFilePath.empty();
+            if (isUpload && !std::filesystem::exists(request.uploadFilePath))
+            {
+                throw std::runtime_error("Cannot open file: " + request.uploadFilePath);
+            }
+
+            applyCaFile(curl, caFilePath);
+            applyHttpVersion(curl, httpVersion);
 
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerList);
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, gladiapp::v2::common::USER_AGENT);
-        curl_easy_setopt(curl, CURLOPT_MIMEPOST, mime);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
+            std::string apiKeyHeader = std::string(gladiapp::v2::headers::X_GLADIA_KEY) + ": " + apiKey;
+            _headerList = curl_slist_append(_headerList, apiKeyHeader.c_str());
+            if (!request.contentType.empty())
+            {
+                _headerList = curl_slist_append(_headerList, ("Content-Type: " + request.contentType).c_str());
+            }
 
-        spdlog::info("file name: {} file size: {}",
-                     std::filesystem::path(filePath).filename().string(),
-                     gladiapp::utils::formatBytes(static_cast<long long>(std::filesystem::file_size(filePath))));
+            curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, _headerList);
+            curl_easy_setopt(curl, CURLOPT_USERAGENT, gladiapp::v2::common::USER_AGENT);
+            if (request.bodySink)
+            {
+                _writeContext.curl = curl;
+                _writeContext.body = responseBody;
+                _writeContext.sink = &request.bodySink;
+                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, streamingWriteCallback);
+                curl_easy_setopt(curl, CURLOPT_WRITEDATA, &_writeContext);
+            }
+            else
+            {
+                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
+                curl_easy_setopt(curl, CURLOPT_WRITEDATA, responseBody);
+            }
 
-        CURLcode res = curl_easy_perform(curl);
+            if (isUpload)
+            {
+                _mime = curl_mime_init(curl);
+                curl_mimepart *part = curl_mime_addpart(_mime);
+                curl_mime_name(part, request.uploadFieldName.c_str());
+                curl_mime_filedata(part, request.uploadFilePath.c_str());
+                curl_mime_type(part, request.uploadContentType.c_str());
+                curl_easy_setopt(curl, CURLOPT_MIMEPOST, _mime);
+
+                spdlog::info("file name: {} file size: {}",
+                             std::filesystem::path(request.uploadFilePath).filename().string(),
+                             gladiapp::utils::formatBytes(static_cast<long long>(std::filesystem::file_size(request.uploadFilePath))));
+                return;
+            }
+
+            // The live session endpoints redirect to a regional host (e.g. api.us-west-1.gladia.io).
+            curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+            curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 5L);
+            curl_easy_setopt(curl, CURLOPT_POSTREDIR, CURL_REDIR_POST_ALL);
+
+            if (request.method == "POST")
+            {
+                curl_easy_setopt(curl, CURLOPT_POST, 1L);
+                curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
+                curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+            }
+            else if (request.method == "DELETE")
+            {
+                curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+            }
+        }
+
+        ~TransferSetup()
+        {
+            if (_mime != nullptr)
+            {
+                curl_mime_free(_mime);
+            }
+            curl_slist_free_all(_headerList);
+        }
+
+        TransferSetup(const TransferSetup &) = delete;
+        TransferSetup &operator=(const TransferSetup &) = delete;
+
+    private:
+        struct curl_slist *_headerList = nullptr;
+        curl_mime *_mime = nullptr;
+        StreamingWriteContext _writeContext;
+    };
+
+    // Performs a synchronous HTTPS request, on a pooled handle when a pool is given.
+    inline HttpResponse perform(const HttpRequest &request,
+                                const std::string &apiKey,
+                                const std::string &caFilePath = {},
+                                ConnectionPool *pool = nullptr,
+                                TransportOptions::HttpVersion httpVersion = TransportOptions::HttpVersion::DEFAULT)
+    {
+        EasyHandle handle(pool);
+        HttpResponse response;
+        TransferSetup setup(handle.get(), request, apiKey, caFilePath, &response.body, httpVersion);
+
+        CURLcode res = curl_easy_perform(handle.get());
         if (res != CURLE_OK)
         {
             std::string errorMessage = curl_easy_strerror(res);
-            curl_mime_free(mime);
-            curl_slist_free_all(headerList);
-            curl_easy_cleanup(curl);
-            throw std::runtime_error("curl upload failed: " + errorMessage);
+            throw std::runtime_error((request.uploadFilePath.empty() ? "curl request failed: " : "curl upload failed: ") + errorMessage);
         }
 
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.statusCode);
-
-        curl_mime_free(mime);
-        curl_slist_free_all(headerList);
-        curl_easy_cleanup(curl);
+        curl_easy_getinfo(handle.get(), CURLINFO_RESPONSE_CODE, &response.statusCode);
+        handle.recordTransfer();
         return response;
     }
 
+    // Performs a synchronous HTTPS request against api.gladia.io.
+    // method: "GET", "POST" or "DELETE". body/contentType are only used for POST.
+    inline HttpResponse performRequest(const std::string &url,
+                                       const std::string &method,
+                                       const std::string &apiKey,
+                                       const std::string &body = "",
+                                       const std::string &contentType = "",
+                                       const std::string &caFilePath = {},
+                                       ConnectionPool *pool = nullptr)
+    {
+        HttpRequest request;
+        request.url = url;
+        request.method = method;
+        request.body = body;
+        request.contentType = contentType;
+        return perform(request, apiKey, caFilePath, pool);
+    }
+
+    // Performs a synchronous multipart/form-data file upload.
+    inline HttpResponse performUpload(const std::string &url,
+                                      const std::string &apiKey,
+                                      const std::string &filePath,
+                                      const std::string &fieldName = "audio",
+                                      const std::string &fileContentType = "audio/mpeg",
+                                      const std::string &caFilePath = {},
+                                      ConnectionPool *pool = nullptr)
+    {
+        HttpRequest request;
+        request.url = url;
+        request.method = "POST";
+        request.uploadFilePath = filePath;
+        request.uploadFieldName = fieldName;
+        request.uploadContentType = fileContentType;
+        return perform(request, apiKey, caFilePath, pool);
+    }
+
     inline std::string urlEncode(const std::string &value)
     {
         ensureGlobalInit();
@@ -0,0 +1,276 @@
+#pragma once
+
+#include "curl_http_util.hpp"
+#include <curl/curl.h>
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace gladiapp::v2::curl_util
+{
+    /**
+     * Event loop driving many HTTPS transfers concurrently on a single thread through curl_multi.
+     * Requests beyond maxConcurrentTransfers wait in a FIFO queue until a slot frees up.
+     * Completion callbacks run on the loop thread, they must not block.
+     * In HTTP/2 mode the multi handle multiplexes concurrent transfers over shared connections.
+     */
+    class MultiEngine
+    {
+    public:
+        // errorMessage is empty when the transfer completed, whatever its HTTP status code.
+        using CompletionCallback = std::function<void(HttpResponse &&response, const std::string &errorMessage)>;
+
+        MultiEngine(const std::string &apiKey,
+                    const std::string &caFilePath,
+                    ConnectionPool *pool,
+                    size_t maxConcurrentTransfers,
+                    TransportOptions::HttpVersion httpVersion = TransportOptions::HttpVersion::DEFAULT)
+            : _apiKey(apiKey),
+              _caFilePath(caFilePath),
+              _pool(pool),
+              _maxConcurrentTransfers(maxConcurrentTransfers > 0 ? maxConcurrentTransfers : 1),
+              _httpVersion(httpVersion)
+        {
+            ensureGlobalInit();
+            _multi = curl_multi_init();
+            if (_multi == nullptr)
+            {
+                throw std::runtime_error("Failed to initialize curl multi handle");
+            }
+            curl_multi_setopt(_multi, CURLMOPT_PIPELINING,
+                              static_cast<long>(httpVersion == TransportOptions::HttpVersion::HTTP_2 ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING));
+            _loopThread = std::thread([this]()
+                                      { run(); });
+        }
+
+        ~MultiEngine()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_queueMutex);
+                _stopping = true;
+            }
+            curl_multi_wakeup(_multi);
+            if (_loopThread.joinable())
+            {
+                _loopThread.join();
+            }
+            curl_multi_cleanup(_multi);
+        }
+
+        MultiEngine(const MultiEngine &) = delete;
+        MultiEngine &operator=(const MultiEngine &) = delete;
+
+        /**
+         * Queues a request; the callback is invoked exactly once, from the loop thread.
+         */
+        void submit(HttpRequest request, CompletionCallback callback)
+        {
+            auto transfer = std::make_unique<Transfer>();
+            transfer->request = std::move(request);
+            transfer->callback = std::move(callback);
+            {
+                std::lock_guard<std::mutex> lock(_queueMutex);
+                if (!_stopping)
+                {
+                    _queue.push_back(std::move(transfer));
+                }
+            }
+            if (transfer != nullptr)
+            {
+                transfer->callback(HttpResponse(), "transfer engine is shutting down");
+                return;
+            }
+            curl_multi_wakeup(_multi);
+        }
+
+        void setMaxConcurrentTransfers(size_t maxConcurrentTransfers)
+        {
+            _maxConcurrentTransfers = maxConcurrentTransfers > 0 ? maxConcurrentTransfers : 1;
+            curl_multi_wakeup(_multi);
+        }
+
+        size_t queuedTransfers() const
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            return _queue.size();
+        }
+
+        size_t activeTransfers() const
+        {
+            return _activeCount;
+        }
+
+    private:
+        struct Transfer
+        {
+            HttpRequest request;
+            CompletionCallback callback;
+            HttpResponse response;
+            std::unique_ptr<EasyHandle> handle;
+            std::unique_ptr<TransferSetup> setup;
+        };
+
+        void run()
+        {
+            while (true)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_queueMutex);
+                    if (_stopping)
+                    {
+                        break;
+                    }
+                }
+                startQueuedTransfers();
+
+                int runningHandles = 0;
+                curl_multi_perform(_multi, &runningHandles);
+
+                int messagesLeft = 0;
+                while (CURLMsg *message = curl_multi_info_read(_multi, &messagesLeft))
+                {
+                    if (message->msg == CURLMSG_DONE)
+                    {
+                        completeTransfer(message->easy_handle, message->data.result);
+                    }
+                }
+                // refill the freed slots now, a freshly added handle makes the poll below return at once
+                startQueuedTransfers();
+
+                curl_multi_poll(_multi, nullptr, 0, 1000, nullptr);
+            }
+            abortAll();
+        }
+
+        void startQueuedTransfers()
+        {
+            while (_active.size() < _maxConcurrentTransfers)
+            {
+                std::unique_ptr<Transfer> transfer;
+                {
+                    std::lock_guard<std::mutex> lock(_queueMutex);
+                    if (_queue.empty())
+                    {
+                        return;
+                    }
+                    transfer = std::move(_queue.front());
+                    _queue.pop_front();
+                }
+
+                try
+                {
+                    transfer->handle = std::make_unique<EasyHandle>(_pool);
+                    transfer->setup = std::make_unique<TransferSetup>(transfer->handle->get(), transfer->request,
+                                                                      _apiKey, _caFilePath, &transfer->response.body, _httpVersion);
+                }
+                catch (const std::exception &e)
+                {
+                    transfer->setup.reset();
+                    transfer->handle.reset();
+                    invoke(*transfer, e.what());
+                    continue;
+                }
+
+                CURL *curl = transfer->handle->get();
+                CURLMcode res = curl_multi_add_handle(_multi, curl);
+                if (res != CURLM_OK)
+                {
+                    transfer->setup.reset();
+                    transfer->handle.reset();
+                    invoke(*transfer, curl_multi_strerror(res));
+                    continue;
+                }
+                _active.emplace(curl, std::move(transfer));
+                _activeCount = _active.size();
+            }
+        }
+
+        void completeTransfer(CURL *curl, CURLcode result)
+        {
+            auto it = _active.find(curl);
+            if (it == _active.end())
+            {
+                return;
+            }
+            std::unique_ptr<Transfer> transfer = std::move(it->second);
+            _active.erase(it);
+            _activeCount = _active.size();
+            curl_multi_remove_handle(_multi, curl);
+
+            std::string errorMessage;
+            if (result != CURLE_OK)
+            {
+                errorMessage = std::string(transfer->request.uploadFilePath.empty() ? "curl request failed: " : "curl upload failed: ") +
+                               curl_easy_strerror(result);
+            }
+            else
+            {
+                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &transfer->response.statusCode);
+                transfer->handle->recordTransfer();
+            }
+            // give the handle back to the pool before running user code
+            transfer->setup.reset();
+            transfer->handle.reset();
+            invoke(*transfer, errorMessage);
+        }
+
+        void abortAll()
+        {
+            for (auto &entry : _active)
+            {
+                curl_multi_remove_handle(_multi, entry.first);
+                entry.second->setup.reset();
+                entry.second->handle.reset();
+                invoke(*entry.second, "transfer engine is shutting down");
+            }
+            _active.clear();
+            _activeCount = 0;
+
+            std::deque<std::unique_ptr<Transfer>> queue;
+            {
+                std::lock_guard<std::mutex> lock(_queueMutex);
+                queue.swap(_queue);
+            }
+            for (auto &transfer : queue)
+            {
+                invoke(*transfer, "transfer engine is shutting down");
+            }
+        }
+
+        static void invoke(Transfer &transfer, const std::string &errorMessage)
+        {
+            try
+            {
+                transfer.callback(std::move(transfer.response), errorMessage);
+            }
+            catch (const std::exception &e)
+            {
+                spdlog::error("Error in transfer completion callback: {}", e.what());
+            }
+        }
+
+    private:
+        std::string _apiKey;
+        std::string _caFilePath;
+        ConnectionPool *_pool;
+        std::atomic<size_t> _maxConcurrentTransfers;
+        TransportOptions::HttpVersion _httpVersion;
+        CURLM *_multi = nullptr;
+
+        mutable std::mutex _queueMutex;
+        std::deque<std::unique_ptr<Transfer>> _queue;
+        bool _stopping = false;
+
+        // only touched by the loop thread
+        std::unordered_map<CURL *, std::unique_ptr<Transfer>> _active;
+        std::atomic<size_t> _activeCount{0};
+
+        std::thread _loopThread;
+    };
+}
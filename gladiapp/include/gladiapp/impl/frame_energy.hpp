@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gladiapp::v2::audio_util
+{
+    struct FrameEnergy
+    {
+        /** Sum of the squared samples. */
+        std::uint64_t sumSquares = 0;
+        /** Number of sign changes between consecutive samples. */
+        std::uint32_t zeroCrossings = 0;
+    };
+
+    /**
+     * Measures a frame of mono 16-bit samples for voice activity detection.
+     * Uses AVX2 when the CPU supports it, picked once at runtime.
+     */
+    FrameEnergy measureFrame(const std::int16_t *samples, std::size_t count);
+
+    /**
+     * Name of the kernel selected for this CPU ("avx2" or "scalar").
+     */
+    const char *frameEnergyKernelName();
+}
@@ -0,0 +1,363 @@
+#pragma once
+
+#include "../gladiapp_job_watcher.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+using namespace gladiapp::v2;
+
+namespace gladiapp
+{
+    namespace v2
+    {
+        class JobWatcherImpl
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            JobWatcherImpl(const GladiaRestClient &client, const JobWatcherOptions &options)
+                : _client(client), _options(options)
+            {
+                if (_options.minInterval <= std::chrono::milliseconds::zero())
+                {
+                    _options.minInterval = std::chrono::milliseconds(1);
+                }
+                _options.maxInterval = std::max(_options.maxInterval, _options.minInterval);
+                _options.backoffFactor = std::max(_options.backoffFactor, 1.0);
+                _watchThread = std::thread([this]()
+                                           { run(); });
+            }
+
+            ~JobWatcherImpl()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_jobsMutex);
+                    _stopping = true;
+                }
+                _jobsCondition.notify_all();
+                if (_watchThread.joinable())
+                {
+                    _watchThread.join();
+                }
+                // the promises of the jobs left are broken when the map goes away
+            }
+
+            std::future<response::TranscriptionResult> watch(const std::string &id,
+                                                             double audioDuration,
+                                                             const JobWatcher::CompletionCallback &callback)
+            {
+                auto job = std::make_shared<WatchedJob>();
+                job->id = id;
+                job->callback = callback;
+                job->audioDuration = audioDuration;
+                job->interval = expectedInterval(audioDuration);
+                job->nextCheck = Clock::now() + job->interval;
+                auto future = job->promise.get_future();
+                {
+                    std::lock_guard<std::mutex> lock(_jobsMutex);
+                    if (_jobs.count(id) != 0)
+                    {
+                        throw std::invalid_argument("Job " + id + " is already watched");
+                    }
+                    _jobs.emplace(id, std::move(job));
+                }
+                _jobsCondition.notify_all();
+                return future;
+            }
+
+            bool unwatch(const std::string &id)
+            {
+                std::lock_guard<std::mutex> lock(_jobsMutex);
+                return _jobs.erase(id) != 0;
+            }
+
+            bool notifyResult(const response::TranscriptionResult &result)
+            {
+                if (result.status != "done" && result.status != "error")
+                {
+                    return false;
+                }
+                std::shared_ptr<WatchedJob> job;
+                {
+                    std::lock_guard<std::mutex> lock(_jobsMutex);
+                    auto it = _jobs.find(result.id);
+                    if (it == _jobs.end())
+                    {
+                        return false;
+                    }
+                    job = it->second;
+                }
+                return complete(job, result, response::TranscriptionError());
+            }
+
+            std::size_t pendingJobs() const
+            {
+                std::lock_guard<std::mutex> lock(_jobsMutex);
+                return _jobs.size();
+            }
+
+            JobWatcherStats getStats() const
+            {
+                JobWatcherStats stats;
+                stats.resultRequests = _resultRequests;
+                stats.listRequests = _listRequests;
+                stats.completedJobs = _completedJobs;
+                return stats;
+            }
+
+        private:
+            struct WatchedJob
+            {
+                std::string id;
+                std::promise<response::TranscriptionResult> promise;
+                JobWatcher::CompletionCallback callback;
+                double audioDuration = 0.0;
+                std::chrono::milliseconds interval{0};
+                Clock::time_point nextCheck;
+            };
+
+            void run()
+            {
+                std::unique_lock<std::mutex> lock(_jobsMutex);
+                while (!_stopping)
+                {
+                    if (_jobs.empty())
+                    {
+                        _jobsCondition.wait(lock);
+                        continue;
+                    }
+
+                    auto nextCheck = Clock::time_point::max();
+                    for (const auto &entry : _jobs)
+                    {
+                        nextCheck = std::min(nextCheck, entry.second->nextCheck);
+                    }
+                    if (nextCheck > Clock::now())
+                    {
+                        _jobsCondition.wait_until(lock, nextCheck);
+                        continue;
+                    }
+
+                    std::vector<std::shared_ptr<WatchedJob>> dueJobs;
+                    auto now = Clock::now();
+                    for (const auto &entry : _jobs)
+                    {
+                        if (entry.second->nextCheck <= now)
+                        {
+                            dueJobs.push_back(entry.second);
+                        }
+                    }
+
+                    lock.unlock();
+                    checkJobs(dueJobs);
+                    lock.lock();
+                }
+            }
+
+            void checkJobs(const std::vector<std::shared_ptr<WatchedJob>> &dueJobs)
+            {
+                std::unordered_set<std::string> runningIds;
+                bool listed = dueJobs.size() >= std::max<std::size_t>(_options.batchThreshold, 1) &&
+                              listRunningJobs(runningIds);
+
+                for (const auto &job : dueJobs)
+                {
+                    if (listed && runningIds.count(job->id) != 0)
+                    {
+                        reschedule(*job);
+                        continue;
+                    }
+                    checkJob(job);
+                }
+            }
+
+            /**
+             * Collects the ids of the queued and processing jobs, false if the listing failed.
+             */
+            bool listRunningJobs(std::unordered_set<std::string> &runningIds)
+            {
+                request::ListResultsQuery query;
+                query.limit = _options.batchPageSize;
+                query.status = {request::ListResultsQuery::QUEUED, request::ListResultsQuery::PROCESSING};
+
+                for (int page = 0; page < std::max(_options.batchMaxPages, 1); ++page)
+                {
+                    response::TranscriptionError error;
+                    response::TranscriptionListResults results;
+                    try
+                    {
+                        ++_listRequests;
+                        results = _client.getResults(query, &error);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::warn("Failed to list running jobs: {}", e.what());
+                        return false;
+                    }
+                    if (error.status_code != 0)
+                    {
+                        spdlog::warn("Failed to list running jobs: {}", error.toString());
+                        return false;
+                    }
+
+                    for (const auto &item : results.items)
+                    {
+                        runningIds.insert(item.id);
+                        if (item.file.has_value())
+                        {
+                            learnDuration(item.id, item.file->duration);
+                        }
+                    }
+                    if (!results.next.has_value() || results.next->empty() || results.items.empty())
+                    {
+                        break;
+                    }
+                    query.offset += static_cast<int>(results.items.size());
+                }
+                // jobs beyond the last page are simply fetched one by one
+                return true;
+            }
+
+            void checkJob(const std::shared_ptr<WatchedJob> &job)
+            {
+                response::TranscriptionError error;
+                response::TranscriptionResult result;
+                try
+                {
+                    ++_resultRequests;
+                    result = _client.getResult(job->id, &error);
+                }
+                catch (const std::exception &e)
+                {
+                    // transport failure, try again later
+                    spdlog::warn("Failed to check job {}: {}", job->id, e.what());
+                    reschedule(*job);
+                    return;
+                }
+
+                if (error.status_code != 0 && isTransient(error.status_code))
+                {
+                    spdlog::warn("Failed to check job {}, retrying: {}", job->id, error.toString());
+                    reschedule(*job);
+                    return;
+                }
+                if (error.status_code != 0 || result.status == "done" || result.status == "error")
+                {
+                    complete(job, result, error);
+                    return;
+                }
+                if (result.file.has_value())
+                {
+                    learnDuration(job->id, result.file->duration);
+                }
+                reschedule(*job);
+            }
+
+            /**
+             * Timeouts, rate limiting and server errors say nothing about the job itself; any other
+             * rejection (401, 403, 404, ...) will not go away by asking again.
+             */
+            static bool isTransient(int statusCode)
+            {
+                return statusCode == 408 || statusCode == 429 || statusCode >= 500;
+            }
+
+            /**
+             * The first time the audio duration becomes known it replaces the default interval,
+             * later checks keep backing off from there.
+             */
+            void learnDuration(const std::string &id, double duration)
+            {
+                std::lock_guard<std::mutex> lock(_jobsMutex);
+                auto it = _jobs.find(id);
+                if (it == _jobs.end() || duration <= 0.0 || it->second->audioDuration > 0.0)
+                {
+                    return;
+                }
+                it->second->audioDuration = duration;
+                it->second->interval = std::max(it->second->interval, expectedInterval(duration));
+            }
+
+            void reschedule(WatchedJob &job)
+            {
+                std::lock_guard<std::mutex> lock(_jobsMutex);
+                job.nextCheck = Clock::now() + job.interval;
+                auto next = std::chrono::duration_cast<std::chrono::milliseconds>(job.interval * _options.backoffFactor);
+                job.interval = std::min(next, _options.maxInterval);
+            }
+
+            bool complete(const std::shared_ptr<WatchedJob> &job,
+                          const response::TranscriptionResult &result,
+                          const response::TranscriptionError &error)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_jobsMutex);
+                    auto it = _jobs.find(job->id);
+                    if (it == _jobs.end() || it->second != job)
+                    {
+                        // unwatched or completed in the meantime
+                        return false;
+                    }
+                    _jobs.erase(it);
+                }
+                ++_completedJobs;
+
+                if (job->callback)
+                {
+                    try
+                    {
+                        job->callback(result, error);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::error("Error in job completion callback: {}", e.what());
+                    }
+                }
+                if (error.status_code != 0)
+                {
+                    job->promise.set_exception(std::make_exception_ptr(
+                        std::runtime_error("Failed to get transcription result: " + error.toString())));
+                }
+                else
+                {
+                    job->promise.set_value(result);
+                }
+                return true;
+            }
+
+            std::chrono::milliseconds expectedInterval(double audioDuration) const
+            {
+                if (audioDuration <= 0.0)
+                {
+                    return _options.minInterval;
+                }
+                auto expected = std::chrono::milliseconds(
+                    static_cast<std::chrono::milliseconds::rep>(audioDuration * _options.expectedProcessingRatio * 1000.0));
+                return std::clamp(expected, _options.minInterval, _options.maxInterval);
+            }
+
+        private:
+            const GladiaRestClient &_client;
+            JobWatcherOptions _options;
+
+            mutable std::mutex _jobsMutex;
+            std::condition_variable _jobsCondition;
+            std::unordered_map<std::string, std::shared_ptr<WatchedJob>> _jobs;
+            bool _stopping = false;
+
+            std::atomic<std::uint64_t> _resultRequests{0};
+            std::atomic<std::uint64_t> _listRequests{0};
+            std::atomic<std::uint64_t> _completedJobs{0};
+
+            std::thread _watchThread;
+        };
+    }
+}
@@ -3,7 +3,12 @@
 #include "../gladiapp_rest.hpp"
 #include "../gladiapp.hpp"
 #include "curl_http_util.hpp"
+#include "curl_multi_engine.hpp"
+#include "json_item_stream.hpp"
 #include <sstream>
+#include <future>
+#include <mutex>
+#include <type_traits>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 
@@ -16,32 +21,26 @@ namespace gladiapp
         class GladiaRestClientImpl
         {
         public:
-            GladiaRestClientImpl(const std::string &apiKey, const std::string &caFilePath = {})
-                : _apiKey(apiKey), _caFilePath(caFilePath)
+            GladiaRestClientImpl(const std::string &apiKey,
+                                 const std::string &caFilePath = {},
+                                 const TransportOptions &options = {})
+                : _apiKey(apiKey), _caFilePath(caFilePath), _options(options),
+                  _connectionPool(std::make_unique<curl_util::ConnectionPool>(options.maxIdleConnections))
             {
             }
 
             ~GladiaRestClientImpl()
             {
+                // stop the event loop before the pool its handles come from
+                _multiEngine.reset();
             }
 
             response::UploadResponse upload(const std::string &filePath, response::TranscriptionError *transcriptionError) const
             {
                 try
                 {
-                    auto httpResponse = curl_util::performUpload(
-                        curl_util::buildUrl(gladiapp::v2::common::UPLOAD_ENDPOINT), _apiKey, filePath,
-                        "audio", "audio/mpeg", _caFilePath);
-
-                    if (httpResponse.statusCode != 200)
-                    {
-                        if (transcriptionError != nullptr)
-                        {
-                            *transcriptionError = response::TranscriptionError::fromJson(httpResponse.body);
-                            return response::UploadResponse();
-                        }
-                    }
-                    return response::UploadResponse::fromJson(httpResponse.body);
+                    auto httpResponse = performBlocking(buildUploadRequest(filePath));
+                    return handleUploadResponse(httpResponse, transcriptionError);
                 }
                 catch (const std::exception &e)
                 {
@@ -55,24 +54,8 @@ namespace gladiapp
             {
                 try
                 {
-                    auto httpResponse = curl_util::performRequest(
-                        curl_util::buildUrl(gladiapp::v2::common::PRERECORDED_ENDPOINT), "POST", _apiKey,
-                        transcriptionRequest.toJson().dump(), "application/json", _caFilePath);
-
-                    spdlog::info("!!! Transcription response: {}, http code: {}", httpResponse.body, httpResponse.statusCode);
-
-                    if (httpResponse.statusCode != 201)
-                    {
-                        std::ostringstream oss;
-                        oss << "Transcription failed, error code: " << httpResponse.statusCode
-                            << ", message: " << httpResponse.body;
-                        if (transcriptionError != nullptr)
-                        {
-                            *transcriptionError = response::TranscriptionError::fromJson(httpResponse.body);
-                            return response::TranscriptionJobResponse();
-                        }
-                    }
-                    return response::TranscriptionJobResponse::fromJson(httpResponse.body);
+                    auto httpResponse = performBlocking(buildPreRecordedRequest(transcriptionRequest));
+                    return handlePreRecordedResponse(httpResponse, transcriptionError);
                 }
                 catch (const std::exception &e)
                 {
@@ -87,26 +70,8 @@ namespace gladiapp
             {
                 try
                 {
-                    auto httpResponse = curl_util::performRequest(
-                        curl_util::buildUrl(std::string(gladiapp::v2::common::PRERECORDED_ENDPOINT) + "/" + id),
-                        "GET", _apiKey, "", "", _caFilePath);
-
-                    if (httpResponse.statusCode != 200)
-                    {
-                        std::ostringstream oss;
-                        oss << "Failed to get transcription result, error code: " << httpResponse.statusCode
-                            << ", message: " << httpResponse.body;
-                        if (transcriptionError != nullptr)
-                        {
-                            *transcriptionError = response::TranscriptionError::fromJson(httpResponse.body);
-                            return response::TranscriptionResult();
-                        }
-                    }
-                    else
-                    {
-                        spdlog::info("Successfully retrieved transcription result: {}", httpResponse.body);
-                        return response::TranscriptionResult::fromJson(httpResponse.body);
-                    }
+                    auto httpResponse = performBlocking(buildGetResultRequest(id));
+                    return handleGetResultResponse(httpResponse, transcriptionError);
                 }
                 catch (const std::exception &e)
                 {
@@ -118,66 +83,76 @@ namespace gladiapp
 
             response::TranscriptionListResults getResults(const request::ListResultsQuery &query,
                                                           response::TranscriptionError *transcriptionError) const
+            {
+                return getResultsStreaming(query, nullptr, transcriptionError);
+            }
+
+            /**
+             * Parses the items of a results page one at a time while the body downloads, the page
+             * is never held as a whole nor as a DOM. Items go to onItem when set, to the returned
+             * listing otherwise.
+             */
+            response::TranscriptionListResults getResultsStreaming(const request::ListResultsQuery &query,
+                                                                   const GladiaRestClient::ResultItemCallback &onItem,
+                                                                   response::TranscriptionError *transcriptionError) const
             {
                 try
                 {
-                    std::ostringstream stringStream;
-                    stringStream << gladiapp::v2::common::PRERECORDED_ENDPOINT << "?"
-                                 << "offset=" << query.offset
-                                 << "&limit=" << query.limit;
-                    if (!query.date.empty())
-                        stringStream << "&date=" << curl_util::urlEncode(query.date);
-                    if (!query.before_date.empty())
-                        stringStream << "&before_date=" << curl_util::urlEncode(query.before_date);
-                    if (!query.after_date.empty())
-                        stringStream << "&after_date=" << curl_util::urlEncode(query.after_date);
-                    if (!query.status.empty())
-                    {
-                        stringStream << "&status=";
-
-                        for (size_t i = 0; i < query.status.size(); ++i)
+                    std::vector<response::TranscriptionResult> items;
+                    std::string itemError;
+                    json_util::ArrayItemSplitter splitter("items", [&](std::string &element)
+                                                          {
+                        try
                         {
-                            if (i > 0)
+                            auto item = response::TranscriptionResult::fromJson(element);
+                            if (onItem)
                             {
-                                stringStream << ",";
+                                onItem(item);
                             }
-                            switch (query.status[i])
+                            else
                             {
-                            case request::ListResultsQuery::Status::DONE:
-                                stringStream << "done";
-                                break;
-                            case request::ListResultsQuery::Status::ERROR:
-                                stringStream << "error";
-                                break;
-                            case request::ListResultsQuery::Status::PROCESSING:
-                                stringStream << "processing";
-                                break;
-                            case request::ListResultsQuery::Status::QUEUED:
-                                stringStream << "queued";
-                                break;
+                                items.push_back(std::move(item));
                             }
+                            return true;
                         }
-                    }
+                        catch (const std::exception &e)
+                        {
+                            itemError = std::string("Failed to parse transcription result item: ") + e.what();
+                            return false;
+                        } });
 
-                    auto httpResponse = curl_util::performRequest(
-                        curl_util::buildUrl(stringStream.str()), "GET", _apiKey, "", "", _caFilePath);
+                    auto httpRequest = buildGetResultsRequest(query);
+                    httpRequest.bodySink = [&splitter](const char *data, size_t size)
+                    {
+                        return splitter.feed(data, size);
+                    };
 
-                    if (httpResponse.statusCode != 200)
+                    curl_util::HttpResponse httpResponse;
+                    try
+                    {
+                        httpResponse = performBlocking(httpRequest);
+                    }
+                    catch (const std::exception &)
                     {
-                        std::ostringstream oss;
-                        oss << "Failed to get transcription result, error code: " << httpResponse.statusCode
-                            << ", message: " << httpResponse.body;
-                        if (transcriptionError != nullptr)
+                        if (!itemError.empty())
                         {
-                            *transcriptionError = response::TranscriptionError::fromJson(httpResponse.body);
-                            return response::TranscriptionListResults();
+                            throw std::runtime_error(itemError);
                         }
+                        throw;
                     }
-                    else
+                    if (httpResponse.statusCode != 200)
+                    {
+                        return handleGetResultsResponse(httpResponse, transcriptionError);
+                    }
+                    if (!splitter.finish())
                     {
-                        spdlog::info("Successfully retrieved transcription result: {}", httpResponse.body);
-                        return response::TranscriptionListResults::fromJson(httpResponse.body);
+                        throw std::runtime_error("Incomplete transcription results listing");
                     }
+
+                    auto results = response::TranscriptionListResults::fromJson(splitter.remainder());
+                    results.items = std::move(items);
+                    spdlog::info("Successfully retrieved {} transcription results", splitter.elementCount());
+                    return results;
                 }
                 catch (const std::exception &e)
                 {
@@ -192,36 +167,394 @@ namespace gladiapp
             {
                 try
                 {
-                    auto httpResponse = curl_util::performRequest(
-                        curl_util::buildUrl(std::string(gladiapp::v2::common::PRERECORDED_ENDPOINT) + "/" + id),
-                        "DELETE", _apiKey, "", "", _caFilePath);
+                    auto httpResponse = performBlocking(buildDeleteResultRequest(id));
+                    handleDeleteResultResponse(httpResponse, id, transcriptionError);
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::error("Error occurred: {}", e.what());
+                    spdlog::throw_spdlog_ex(e.what());
+                }
+            }
+
+            /**
+             * Asynchronous variants, driven by the curl_multi event loop.
+             */
+            std::future<response::UploadResponse> uploadAsync(const std::string &filePath,
+                                                              response::TranscriptionError *transcriptionError) const
+            {
+                return submitFuture<response::UploadResponse>(buildUploadRequest(filePath), transcriptionError, handleUploadResponse);
+            }
+
+            void uploadAsync(const std::string &filePath, const GladiaRestClient::UploadCallback &callback) const
+            {
+                submitCallback<response::UploadResponse>(buildUploadRequest(filePath), callback, handleUploadResponse);
+            }
+
+            std::future<response::TranscriptionJobResponse> preRecordedAsync(const request::TranscriptionRequest &transcriptionRequest,
+                                                                             response::TranscriptionError *transcriptionError) const
+            {
+                return submitFuture<response::TranscriptionJobResponse>(buildPreRecordedRequest(transcriptionRequest), transcriptionError,
+                                                                        handlePreRecordedResponse);
+            }
+
+            void preRecordedAsync(const request::TranscriptionRequest &transcriptionRequest,
+                                  const GladiaRestClient::PreRecordedCallback &callback) const
+            {
+                submitCallback<response::TranscriptionJobResponse>(buildPreRecordedRequest(transcriptionRequest), callback,
+                                                                   handlePreRecordedResponse);
+            }
+
+            std::future<response::TranscriptionResult> getResultAsync(const std::string &id,
+                                                                      response::TranscriptionError *transcriptionError) const
+            {
+                return submitFuture<response::TranscriptionResult>(buildGetResultRequest(id), transcriptionError, handleGetResultResponse);
+            }
+
+            void getResultAsync(const std::string &id, const GladiaRestClient::ResultCallback &callback) const
+            {
+                submitCallback<response::TranscriptionResult>(buildGetResultRequest(id), callback, handleGetResultResponse);
+            }
+
+            std::future<response::TranscriptionListResults> getResultsAsync(const request::ListResultsQuery &query,
+                                                                            response::TranscriptionError *transcriptionError) const
+            {
+                return submitFuture<response::TranscriptionListResults>(buildGetResultsRequest(query), transcriptionError,
+                                                                        handleGetResultsResponse);
+            }
+
+            void getResultsAsync(const request::ListResultsQuery &query, const GladiaRestClient::ResultsCallback &callback) const
+            {
+                submitCallback<response::TranscriptionListResults>(buildGetResultsRequest(query), callback, handleGetResultsResponse);
+            }
+
+            std::future<void> deleteResultAsync(const std::string &id, response::TranscriptionError *transcriptionError) const
+            {
+                return submitFuture<void>(buildDeleteResultRequest(id), transcriptionError,
+                                          [id](const curl_util::HttpResponse &httpResponse, response::TranscriptionError *error)
+                                          { handleDeleteResultResponse(httpResponse, id, error); });
+            }
+
+            void deleteResultAsync(const std::string &id, const GladiaRestClient::DeleteCallback &callback) const
+            {
+                submitCallback<void>(buildDeleteResultRequest(id), callback,
+                                     [id](const curl_util::HttpResponse &httpResponse, response::TranscriptionError *error)
+                                     { handleDeleteResultResponse(httpResponse, id, error); });
+            }
+
+            void setMaxConcurrentTransfers(size_t maxConcurrentTransfers)
+            {
+                std::lock_guard<std::mutex> lock(_multiEngineMutex);
+                _options.maxConcurrentTransfers = maxConcurrentTransfers;
+                if (_multiEngine != nullptr)
+                {
+                    _multiEngine->setMaxConcurrentTransfers(maxConcurrentTransfers);
+                }
+            }
+
+            ConnectionPoolStats getConnectionPoolStats() const
+            {
+                return _connectionPool->stats();
+            }
+
+        private:
+            static curl_util::HttpRequest buildUploadRequest(const std::string &filePath)
+            {
+                curl_util::HttpRequest request;
+                request.url = curl_util::buildUrl(gladiapp::v2::common::UPLOAD_ENDPOINT);
+                request.method = "POST";
+                request.uploadFilePath = filePath;
+                request.uploadFieldName = "audio";
+                request.uploadContentType = "audio/mpeg";
+                return request;
+            }
+
+            static curl_util::HttpRequest buildPreRecordedRequest(const request::TranscriptionRequest &transcriptionRequest)
+            {
+                curl_util::HttpRequest request;
+                request.url = curl_util::buildUrl(gladiapp::v2::common::PRERECORDED_ENDPOINT);
+                request.method = "POST";
+                request.body = transcriptionRequest.toJson().dump();
+                request.contentType = "application/json";
+                return request;
+            }
+
+            static curl_util::HttpRequest buildGetResultRequest(const std::string &id)
+            {
+                curl_util::HttpRequest request;
+                request.url = curl_util::buildUrl(std::string(gladiapp::v2::common::PRERECORDED_ENDPOINT) + "/" + id);
+                return request;
+            }
+
+            static curl_util::HttpRequest buildGetResultsRequest(const request::ListResultsQuery &query)
+            {
+                std::ostringstream stringStream;
+                stringStream << gladiapp::v2::common::PRERECORDED_ENDPOINT << "?"
+                             << "offset=" << query.offset
+                             << "&limit=" << query.limit;
+                if (!query.date.empty())
+                    stringStream << "&date=" << curl_util::urlEncode(query.date);
+                if (!query.before_date.empty())
+                    stringStream << "&before_date=" << curl_util::urlEncode(query.before_date);
+                if (!query.after_date.empty())
+                    stringStream << "&after_date=" << curl_util::urlEncode(query.after_date);
+                if (!query.status.empty())
+                {
+                    stringStream << "&status=";
 
-                    if (httpResponse.statusCode != 202)
+                    for (size_t i = 0; i < query.status.size(); ++i)
                     {
-                        std::ostringstream oss;
-                        oss << "Failed to delete transcription result, error code: " << httpResponse.statusCode
-                            << ", message: " << httpResponse.body;
-                        spdlog::error(oss.str());
-                        if (transcriptionError != nullptr)
+                        if (i > 0)
                         {
-                            *transcriptionError = response::TranscriptionError::fromJson(httpResponse.body);
+                            stringStream << ",";
+                        }
+                        switch (query.status[i])
+                        {
+                        case request::ListResultsQuery::Status::DONE:
+                            stringStream << "done";
+                            break;
+                        case request::ListResultsQuery::Status::ERROR:
+                            stringStream << "error";
+                            break;
+                        case request::ListResultsQuery::Status::PROCESSING:
+                            stringStream << "processing";
+                            break;
+                        case request::ListResultsQuery::Status::QUEUED:
+                            stringStream << "queued";
+                            break;
                         }
                     }
-                    else
+                }
+
+                curl_util::HttpRequest request;
+                request.url = curl_util::buildUrl(stringStream.str());
+                return request;
+            }
+
+            static curl_util::HttpRequest buildDeleteResultRequest(const std::string &id)
+            {
+                curl_util::HttpRequest request;
+                request.url = curl_util::buildUrl(std::string(gladiapp::v2::common::PRERECORDED_ENDPOINT) + "/" + id);
+                request.method = "DELETE";
+                return request;
+            }
+
+            static response::UploadResponse handleUploadResponse(const curl_util::HttpResponse &httpResponse,
+                                                                 response::TranscriptionError *transcriptionError)
+            {
+                if (httpResponse.statusCode != 200)
+                {
+                    if (transcriptionError != nullptr)
                     {
-                        spdlog::info("Successfully deleted result: {}", id);
+                        *transcriptionError = response::TranscriptionError::fromJson(httpResponse.body);
+                        return response::UploadResponse();
                     }
                 }
-                catch (const std::exception &e)
+                return response::UploadResponse::fromJson(httpResponse.body);
+            }
+
+            static response::TranscriptionJobResponse handlePreRecordedResponse(const curl_util::HttpResponse &httpResponse,
+                                                                                response::TranscriptionError *transcriptionError)
+            {
+                spdlog::info("!!! Transcription response: {}, http code: {}", httpResponse.body, httpResponse.statusCode);
+
+                if (httpResponse.statusCode != 201)
                 {
-                    spdlog::error("Error occurred: {}", e.what());
-                    spdlog::throw_spdlog_ex(e.what());
+                    std::ostringstream oss;
+                    oss << "Transcription failed, error code: " << httpResponse.statusCode
+                        << ", message: " << httpResponse.body;
+                    if (transcriptionError != nullptr)
+                    {
+                        *transcriptionError = response::TranscriptionError::fromJson(httpResponse.body);
+                        return response::TranscriptionJobResponse();
+                    }
+                }
+                return response::TranscriptionJobResponse::fromJson(httpResponse.body);
+            }
+
+            static response::TranscriptionResult handleGetResultResponse(const curl_util::HttpResponse &httpResponse,
+                                                                         response::TranscriptionError *transcriptionError)
+            {
+                if (httpResponse.statusCode != 200)
+                {
+                    std::ostringstream oss;
+                    oss << "Failed to get transcription result, error code: " << httpResponse.statusCode
+                        << ", message: " << httpResponse.body;
+                    if (transcriptionError != nullptr)
+                    {
+                        *transcriptionError = response::TranscriptionError::fromJson(httpResponse.body);
+                    }
+                    return response::TranscriptionResult();
+                }
+                spdlog::info("Successfully retrieved transcription result: {}", httpResponse.body);
+                return response::TranscriptionResult::fromJson(httpResponse.body);
+            }
+
+            static response::TranscriptionListResults handleGetResultsResponse(const curl_util::HttpResponse &httpResponse,
+                                                                               response::TranscriptionError *transcriptionError)
+            {
+                if (httpResponse.statusCode != 200)
+                {
+                    std::ostringstream oss;
+                    oss << "Failed to get transcription result, error code: " << httpResponse.statusCode
+                        << ", message: " << httpResponse.body;
+                    if (transcriptionError != nullptr)
+                    {
+                        *transcriptionError = response::TranscriptionError::fromJson(httpResponse.body);
+                    }
+                    return response::TranscriptionListResults();
+                }
+                spdlog::info("Successfully retrieved transcription result: {}", httpResponse.body);
+                return response::TranscriptionListResults::fromJson(httpResponse.body);
+            }
+
+            static void handleDeleteResultResponse(const curl_util::HttpResponse &httpResponse,
+                                                   const std::string &id,
+                                                   response::TranscriptionError *transcriptionError)
+            {
+                if (httpResponse.statusCode != 202)
+                {
+                    std::ostringstream oss;
+                    oss << "Failed to delete transcription result, error code: " << httpResponse.statusCode
+                        << ", message: " << httpResponse.body;
+                    spdlog::error(oss.str());
+                    if (transcriptionError != nullptr)
+                    {
+                        *transcriptionError = response::TranscriptionError::fromJson(httpResponse.body);
+                    }
+                }
+                else
+                {
+                    spdlog::info("Successfully deleted result: {}", id);
+                }
+            }
+
+            curl_util::MultiEngine &multiEngine() const
+            {
+                std::lock_guard<std::mutex> lock(_multiEngineMutex);
+                if (_multiEngine == nullptr)
+                {
+                    _multiEngine = std::make_unique<curl_util::MultiEngine>(_apiKey, _caFilePath, _connectionPool.get(),
+                                                                            _options.maxConcurrentTransfers, _options.httpVersion);
+                }
+                return *_multiEngine;
+            }
+
+            // In HTTP/2 mode the blocking calls go through the event loop too, so that concurrent
+            // callers share the multiplexed connection. They must not be made from a completion callback.
+            curl_util::HttpResponse performBlocking(const curl_util::HttpRequest &request) const
+            {
+                if (_options.httpVersion != TransportOptions::HttpVersion::HTTP_2)
+                {
+                    return curl_util::perform(request, _apiKey, _caFilePath, _connectionPool.get(), _options.httpVersion);
                 }
+
+                std::promise<curl_util::HttpResponse> promise;
+                std::future<curl_util::HttpResponse> future = promise.get_future();
+                multiEngine().submit(request, [&promise](curl_util::HttpResponse &&httpResponse, const std::string &errorMessage)
+                                     {
+                    if (!errorMessage.empty())
+                    {
+                        promise.set_exception(std::make_exception_ptr(std::runtime_error(errorMessage)));
+                        return;
+                    }
+                    promise.set_value(std::move(httpResponse)); });
+                return future.get();
+            }
+
+            // The future is completed after transcriptionError (when given) has been filled;
+            // transport failures are stored in the future as an exception.
+            template <typename T, typename Handler>
+            std::future<T> submitFuture(curl_util::HttpRequest request,
+                                        response::TranscriptionError *transcriptionError,
+                                        Handler handler) const
+            {
+                auto promise = std::make_shared<std::promise<T>>();
+                std::future<T> future = promise->get_future();
+                multiEngine().submit(std::move(request), [promise, transcriptionError, handler](curl_util::HttpResponse &&httpResponse, const std::string &errorMessage)
+                                     {
+                    try
+                    {
+                        if (!errorMessage.empty())
+                        {
+                            throw std::runtime_error(errorMessage);
+                        }
+                        if constexpr (std::is_void_v<T>)
+                        {
+                            handler(httpResponse, transcriptionError);
+                            promise->set_value();
+                        }
+                        else
+                        {
+                            promise->set_value(handler(httpResponse, transcriptionError));
+                        }
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::error("Error occurred: {}", e.what());
+                        promise->set_exception(std::current_exception());
+                    } });
+                return future;
+            }
+
+            // Transport and parsing failures are reported through the error message, with a status code of 0.
+            template <typename T, typename Callback, typename Handler>
+            void submitCallback(curl_util::HttpRequest request, const Callback &callback, Handler handler) const
+            {
+                multiEngine().submit(std::move(request), [callback, handler](curl_util::HttpResponse &&httpResponse, const std::string &errorMessage)
+                                     {
+                    response::TranscriptionError transcriptionError;
+                    if constexpr (std::is_void_v<T>)
+                    {
+                        try
+                        {
+                            if (!errorMessage.empty())
+                            {
+                                throw std::runtime_error(errorMessage);
+                            }
+                            handler(httpResponse, &transcriptionError);
+                        }
+                        catch (const std::exception &e)
+                        {
+                            spdlog::error("Error occurred: {}", e.what());
+                            transcriptionError.message = e.what();
+                        }
+                        if (callback)
+                        {
+                            callback(transcriptionError);
+                        }
+                    }
+                    else
+                    {
+                        T result{};
+                        try
+                        {
+                            if (!errorMessage.empty())
+                            {
+                                throw std::runtime_error(errorMessage);
+                            }
+                            result = handler(httpResponse, &transcriptionError);
+                        }
+                        catch (const std::exception &e)
+                        {
+                            spdlog::error("Error occurred: {}", e.what());
+                            transcriptionError.message = e.what();
+                        }
+                        if (callback)
+                        {
+                            callback(result, transcriptionError);
+                        }
+                    } });
             }
 
         private:
             std::string _apiKey;
             std::string _caFilePath;
+            TransportOptions _options;
+            std::unique_ptr<curl_util::ConnectionPool> _connectionPool;
+            // created on the first asynchronous request
+            mutable std::mutex _multiEngineMutex;
+            mutable std::unique_ptr<curl_util::MultiEngine> _multiEngine;
         };
     }
 }
@@ -0,0 +1,647 @@
+#pragma once
+
+#include "../gladiapp_webhook.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace gladiapp::v2;
+
+namespace gladiapp
+{
+    namespace v2
+    {
+        class WebhookReceiverImpl
+        {
+        public:
+            explicit WebhookReceiverImpl(const WebhookReceiverOptions &options)
+                : _options(options),
+                  _callbackPath(options.path + (!options.path.empty() && options.path.back() == '/' ? "" : "/") + options.secret)
+            {
+                _options.maxConnections = std::max<std::size_t>(_options.maxConnections, 1);
+            }
+
+            ~WebhookReceiverImpl()
+            {
+                stop();
+            }
+
+            bool start()
+            {
+#ifdef __linux__
+                if (_listenerThread.joinable())
+                {
+                    return true;
+                }
+                if (_options.secret.empty())
+                {
+                    spdlog::error("Webhook receiver: a shared secret is required (WebhookReceiverOptions::secret)");
+                    return false;
+                }
+
+                _listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+                if (_listenFd < 0)
+                {
+                    spdlog::error("Webhook receiver: socket() failed: {}", std::strerror(errno));
+                    return false;
+                }
+                int reuse = 1;
+                setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+                sockaddr_in address{};
+                address.sin_family = AF_INET;
+                address.sin_port = htons(_options.port);
+                if (inet_pton(AF_INET, _options.bindAddress.c_str(), &address.sin_addr) != 1)
+                {
+                    spdlog::error("Webhook receiver: invalid bind address {}", _options.bindAddress);
+                    closeSockets();
+                    return false;
+                }
+                if (bind(_listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+                    listen(_listenFd, SOMAXCONN) != 0)
+                {
+                    spdlog::error("Webhook receiver: cannot listen on {}:{}: {}", _options.bindAddress, _options.port, std::strerror(errno));
+                    closeSockets();
+                    return false;
+                }
+                socklen_t addressLength = sizeof(address);
+                getsockname(_listenFd, reinterpret_cast<sockaddr *>(&address), &addressLength);
+                _port = ntohs(address.sin_port);
+
+                _epollFd = epoll_create1(EPOLL_CLOEXEC);
+                _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                if (_epollFd < 0 || _wakeFd < 0 || !watch(_listenFd, EPOLLIN, EPOLL_CTL_ADD) || !watch(_wakeFd, EPOLLIN, EPOLL_CTL_ADD))
+                {
+                    spdlog::error("Webhook receiver: epoll setup failed: {}", std::strerror(errno));
+                    closeSockets();
+                    return false;
+                }
+
+                _stopping = false;
+                _listenerThread = std::thread([this]()
+                                              { run(); });
+                spdlog::info("Webhook receiver listening on {}:{}{}", _options.bindAddress, _port.load(), _options.path);
+                return true;
+#else
+                spdlog::error("Webhook receiver: epoll is only available on Linux");
+                return false;
+#endif
+            }
+
+            void stop()
+            {
+#ifdef __linux__
+                if (!_listenerThread.joinable())
+                {
+                    return;
+                }
+                _stopping = true;
+                std::uint64_t one = 1;
+                [[maybe_unused]] auto written = write(_wakeFd, &one, sizeof(one));
+                _listenerThread.join();
+
+                for (auto &entry : _connections)
+                {
+                    close(entry.first);
+                }
+                _connections.clear();
+                closeSockets();
+                _port = 0;
+#endif
+                std::lock_guard<std::mutex> lock(_resultsMutex);
+                _expected.clear();
+            }
+
+            std::uint16_t port() const
+            {
+                return _port;
+            }
+
+            const std::string &callbackPath() const
+            {
+                return _callbackPath;
+            }
+
+            std::future<response::TranscriptionResult> expect(const std::string &id)
+            {
+                std::promise<response::TranscriptionResult> promise;
+                auto future = promise.get_future();
+
+                std::lock_guard<std::mutex> lock(_resultsMutex);
+                auto unclaimed = _unclaimed.find(id);
+                if (unclaimed != _unclaimed.end())
+                {
+                    promise.set_value(std::move(unclaimed->second));
+                    _unclaimed.erase(unclaimed);
+                    return future;
+                }
+                if (!_expected.emplace(id, std::move(promise)).second)
+                {
+                    throw std::invalid_argument("Result of job " + id + " is already expected");
+                }
+                return future;
+            }
+
+            void setOnResultCallback(const WebhookReceiver::ResultCallback &callback)
+            {
+                std::lock_guard<std::mutex> lock(_resultsMutex);
+                _onResultCallback = callback;
+            }
+
+            /**
+             * Parses a callback body, either Gladia's {"id", "event", "payload"} envelope or a bare
+             * transcription result as returned by getResult.
+             */
+            static std::optional<response::TranscriptionResult> parseCallback(const std::string &body)
+            {
+                auto json = nlohmann::json::parse(body, nullptr, false);
+                if (json.is_discarded() || !json.is_object())
+                {
+                    return std::nullopt;
+                }
+                if (!json.contains("payload"))
+                {
+                    if (!json.contains("id") || !json.contains("status"))
+                    {
+                        return std::nullopt;
+                    }
+                    return response::TranscriptionResult::fromJsonDocument(json);
+                }
+
+                const auto &payload = json["payload"];
+                if (payload.is_object() && payload.contains("id") && payload.contains("status"))
+                {
+                    return response::TranscriptionResult::fromJsonDocument(payload);
+                }
+                if (!json.contains("id") || !json["id"].is_string())
+                {
+                    return std::nullopt;
+                }
+                std::string event = json.value("event", "");
+                bool failed = event.size() >= 5 && event.compare(event.size() - 5, 5, "error") == 0;
+
+                nlohmann::json result;
+                result["id"] = json["id"];
+                result["status"] = failed ? "error" : "done";
+                result["kind"] = "pre-recorded";
+                if (payload.is_object())
+                {
+                    if (failed && payload.contains("error_code"))
+                    {
+                        result["error_code"] = payload["error_code"];
+                    }
+                    result["result"] = payload;
+                }
+                return response::TranscriptionResult::fromJsonDocument(result);
+            }
+
+        private:
+#ifdef __linux__
+            using Clock = std::chrono::steady_clock;
+
+            struct Connection
+            {
+                std::string input;
+                std::string output;
+                std::size_t outputOffset = 0;
+                // the whole exchange must be over by then, however slowly the peer sends or reads
+                Clock::time_point deadline;
+            };
+
+            static constexpr std::size_t MAX_HEADER_SIZE = 16 * 1024;
+            static constexpr const char *SECRET_HEADER = "x-webhook-secret";
+
+            void run()
+            {
+                epoll_event events[64];
+                while (!_stopping)
+                {
+                    int count = epoll_wait(_epollFd, events, 64, nextTimeoutMs());
+                    if (count < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        spdlog::error("Webhook receiver: epoll_wait failed: {}", std::strerror(errno));
+                        return;
+                    }
+                    for (int i = 0; i < count; ++i)
+                    {
+                        int fd = events[i].data.fd;
+                        if (fd == _wakeFd)
+                        {
+                            continue;
+                        }
+                        if (fd == _listenFd)
+                        {
+                            acceptConnections();
+                            continue;
+                        }
+                        handleConnection(fd, events[i].events);
+                    }
+                    closeExpiredConnections();
+                }
+            }
+
+            /**
+             * Time until the earliest connection deadline, -1 (no timeout) without connections.
+             */
+            int nextTimeoutMs() const
+            {
+                if (_connections.empty())
+                {
+                    return -1;
+                }
+                auto earliest = Clock::time_point::max();
+                for (const auto &entry : _connections)
+                {
+                    earliest = std::min(earliest, entry.second.deadline);
+                }
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(earliest - Clock::now()).count();
+                // rounded up so that the deadline has passed when epoll_wait returns
+                return static_cast<int>(std::max<long long>(remaining + 1, 0));
+            }
+
+            void closeExpiredConnections()
+            {
+                auto now = Clock::now();
+                std::vector<int> expired;
+                for (const auto &entry : _connections)
+                {
+                    if (entry.second.deadline <= now)
+                    {
+                        expired.push_back(entry.first);
+                    }
+                }
+                for (int fd : expired)
+                {
+                    spdlog::debug("Webhook receiver: closing connection {} after {} ms", fd, _options.connectionTimeout.count());
+                    closeConnection(fd);
+                }
+            }
+
+            void acceptConnections()
+            {
+                while (true)
+                {
+                    int fd = accept4(_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (fd < 0)
+                    {
+                        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                        {
+                            spdlog::warn("Webhook receiver: accept failed: {}", std::strerror(errno));
+                        }
+                        return;
+                    }
+                    if (_connections.size() >= _options.maxConnections)
+                    {
+                        spdlog::debug("Webhook receiver: {} connections open, refusing another one", _connections.size());
+                        close(fd);
+                        continue;
+                    }
+                    if (!watch(fd, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_ADD))
+                    {
+                        close(fd);
+                        continue;
+                    }
+                    Connection connection;
+                    connection.deadline = Clock::now() + _options.connectionTimeout;
+                    _connections.emplace(fd, std::move(connection));
+                }
+            }
+
+            void handleConnection(int fd, std::uint32_t events)
+            {
+                auto it = _connections.find(fd);
+                if (it == _connections.end())
+                {
+                    return;
+                }
+                Connection &connection = it->second;
+
+                if (events & EPOLLERR)
+                {
+                    closeConnection(fd);
+                    return;
+                }
+                if (!connection.output.empty())
+                {
+                    // a response is in flight, the request is not read any further
+                    flush(fd, connection);
+                    return;
+                }
+                if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))
+                {
+                    char buffer[16 * 1024];
+                    while (true)
+                    {
+                        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                        if (received > 0)
+                        {
+                            connection.input.append(buffer, static_cast<std::size_t>(received));
+                            if (connection.input.size() > MAX_HEADER_SIZE + _options.maxBodySize)
+                            {
+                                // more than any acceptable request, answered from what was read
+                                break;
+                            }
+                            continue;
+                        }
+                        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                        {
+                            break;
+                        }
+                        if (received < 0 && errno == EINTR)
+                        {
+                            continue;
+                        }
+                        // peer closed or failed before sending a complete request
+                        if (!processInput(fd, connection))
+                        {
+                            closeConnection(fd);
+                        }
+                        return;
+                    }
+                    processInput(fd, connection);
+                }
+            }
+
+            /**
+             * Answers the request once it is complete, false while more input is needed.
+             */
+            bool processInput(int fd, Connection &connection)
+            {
+                auto headerEnd = connection.input.find("\r\n\r\n");
+                if (headerEnd == std::string::npos)
+                {
+                    if (connection.input.size() > MAX_HEADER_SIZE)
+                    {
+                        respond(fd, connection, 431, "Request Header Fields Too Large");
+                        return true;
+                    }
+                    return false;
+                }
+
+                std::istringstream head(connection.input.substr(0, headerEnd));
+                std::string method, target, version, line;
+                head >> method >> target >> version;
+                std::getline(head, line);
+
+                std::size_t contentLength = 0;
+                std::string secret;
+                while (std::getline(head, line))
+                {
+                    if (!line.empty() && line.back() == '\r')
+                    {
+                        line.pop_back();
+                    }
+                    auto colon = line.find(':');
+                    if (colon == std::string::npos)
+                    {
+                        continue;
+                    }
+                    std::string name = line.substr(0, colon);
+                    for (auto &c : name)
+                    {
+                        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                    }
+                    auto valueStart = line.find_first_not_of(' ', colon + 1);
+                    std::string value = valueStart == std::string::npos ? std::string() : line.substr(valueStart);
+                    if (name == "content-length")
+                    {
+                        contentLength = static_cast<std::size_t>(std::strtoull(value.c_str(), nullptr, 10));
+                    }
+                    else if (name == SECRET_HEADER)
+                    {
+                        secret = value;
+                    }
+                    else if (name == "transfer-encoding")
+                    {
+                        respond(fd, connection, 411, "Length Required");
+                        return true;
+                    }
+                }
+
+                // the sender is authenticated before its body is waited for, let alone parsed
+                std::string path = target.substr(0, target.find('?'));
+                bool authorized = path == _callbackPath;
+                if (!authorized && path == _options.path)
+                {
+                    if (!matchesSecret(secret))
+                    {
+                        respond(fd, connection, 401, "Unauthorized");
+                        return true;
+                    }
+                    authorized = true;
+                }
+                if (!authorized)
+                {
+                    respond(fd, connection, 404, "Not Found");
+                    return true;
+                }
+                if (method != "POST" && method != "PUT")
+                {
+                    respond(fd, connection, 405, "Method Not Allowed");
+                    return true;
+                }
+
+                if (contentLength > _options.maxBodySize)
+                {
+                    respond(fd, connection, 413, "Payload Too Large");
+                    return true;
+                }
+                std::size_t bodyStart = headerEnd + 4;
+                if (connection.input.size() < bodyStart + contentLength)
+                {
+                    return false;
+                }
+
+                std::optional<response::TranscriptionResult> result;
+                try
+                {
+                    result = parseCallback(connection.input.substr(bodyStart, contentLength));
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::warn("Webhook receiver: invalid callback body: {}", e.what());
+                }
+                if (!result.has_value())
+                {
+                    respond(fd, connection, 400, "Bad Request");
+                    return true;
+                }
+                respond(fd, connection, 200, "OK");
+                dispatch(std::move(*result));
+                return true;
+            }
+
+            void respond(int fd, Connection &connection, int statusCode, const char *reason)
+            {
+                std::string body = statusCode == 200 ? "{}" : "{\"message\":\"" + std::string(reason) + "\"}";
+                std::ostringstream oss;
+                oss << "HTTP/1.1 " << statusCode << " " << reason << "\r\n"
+                    << "Content-Type: application/json\r\n"
+                    << "Content-Length: " << body.size() << "\r\n"
+                    << "Connection: close\r\n\r\n"
+                    << body;
+                connection.input.clear();
+                connection.output = oss.str();
+                connection.outputOffset = 0;
+                flush(fd, connection);
+            }
+
+            void flush(int fd, Connection &connection)
+            {
+                while (connection.outputOffset < connection.output.size())
+                {
+                    ssize_t sent = send(fd, connection.output.data() + connection.outputOffset,
+                                        connection.output.size() - connection.outputOffset, MSG_NOSIGNAL);
+                    if (sent < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        if (errno == EAGAIN || errno == EWOULDBLOCK)
+                        {
+                            watch(fd, EPOLLOUT, EPOLL_CTL_MOD);
+                            return;
+                        }
+                        break;
+                    }
+                    connection.outputOffset += static_cast<std::size_t>(sent);
+                }
+                closeConnection(fd);
+            }
+
+            /**
+             * Compares in a time that does not depend on where the candidate differs.
+             */
+            bool matchesSecret(const std::string &candidate) const
+            {
+                const std::string &secret = _options.secret;
+                unsigned char difference = candidate.size() == secret.size() ? 0 : 1;
+                for (std::size_t i = 0; i < secret.size(); ++i)
+                {
+                    difference |= static_cast<unsigned char>(secret[i] ^ (i < candidate.size() ? candidate[i] : 0));
+                }
+                return difference == 0;
+            }
+
+            void closeConnection(int fd)
+            {
+                epoll_ctl(_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+                close(fd);
+                _connections.erase(fd);
+            }
+
+            bool watch(int fd, std::uint32_t events, int operation)
+            {
+                epoll_event event{};
+                event.events = events;
+                event.data.fd = fd;
+                return epoll_ctl(_epollFd, operation, fd, &event) == 0;
+            }
+
+            void closeSockets()
+            {
+                for (int *fd : {&_listenFd, &_epollFd, &_wakeFd})
+                {
+                    if (*fd >= 0)
+                    {
+                        close(*fd);
+                        *fd = -1;
+                    }
+                }
+            }
+#endif
+
+            void dispatch(response::TranscriptionResult &&result)
+            {
+                WebhookReceiver::ResultCallback callback;
+                std::optional<std::promise<response::TranscriptionResult>> promise;
+                {
+                    std::lock_guard<std::mutex> lock(_resultsMutex);
+                    callback = _onResultCallback;
+                    auto expected = _expected.find(result.id);
+                    if (expected != _expected.end())
+                    {
+                        promise = std::move(expected->second);
+                        _expected.erase(expected);
+                    }
+                    else if (_options.maxUnclaimedResults > 0)
+                    {
+                        if (_unclaimed.count(result.id) == 0)
+                        {
+                            _unclaimedOrder.push_back(result.id);
+                        }
+                        _unclaimed[result.id] = result;
+                        while (_unclaimedOrder.size() > _options.maxUnclaimedResults)
+                        {
+                            _unclaimed.erase(_unclaimedOrder.front());
+                            _unclaimedOrder.pop_front();
+                        }
+                    }
+                }
+
+                if (callback)
+                {
+                    try
+                    {
+                        callback(result);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::error("Error in webhook result callback: {}", e.what());
+                    }
+                }
+                if (promise.has_value())
+                {
+                    promise->set_value(std::move(result));
+                }
+            }
+
+        private:
+            WebhookReceiverOptions _options;
+            const std::string _callbackPath;
+            std::atomic<std::uint16_t> _port{0};
+
+            int _listenFd = -1;
+            int _epollFd = -1;
+            int _wakeFd = -1;
+            std::atomic<bool> _stopping{false};
+            std::thread _listenerThread;
+
+            // only touched by the listener thread
+            std::unordered_map<int, Connection> _connections;
+
+            std::mutex _resultsMutex;
+            std::unordered_map<std::string, std::promise<response::TranscriptionResult>> _expected;
+            std::unordered_map<std::string, response::TranscriptionResult> _unclaimed;
+            std::deque<std::string> _unclaimedOrder;
+            WebhookReceiver::ResultCallback _onResultCallback;
+        };
+    }
+}
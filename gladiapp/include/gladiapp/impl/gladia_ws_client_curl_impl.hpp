@@ -5,6 +5,12 @@
 #include "../gladiapp_ws_response.hpp"
 #include "../gladiapp_error.hpp"
 #include "curl_http_util.hpp"
+#include "ws_reactor.hpp"
+#include "ws_send_queue.hpp"
+#include "audio_buffer_pool.hpp"
+#include "audio_coalescer.hpp"
+#include "audio_replay_buffer.hpp"
+#include "callback_executor.hpp"
 
 #include <curl/curl.h>
 #include <sstream>
@@ -13,13 +19,23 @@
 #include <functional>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
+#include <deque>
+#include <map>
+#include <chrono>
 #include <vector>
 
 #ifdef _WIN32
 #include <winsock2.h>
 #else
-#include <sys/select.h>
+#include <poll.h>
+#endif
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 #endif
 
 using namespace gladiapp::v2::response;
@@ -31,17 +47,39 @@ namespace gladiapp::v2::ws
     class GladiaWebsocketClientImpl
     {
     public:
-        GladiaWebsocketClientImpl(const std::string &apiKey, const std::string &caFilePath = {})
-            : _apiKey(apiKey), _caFilePath(caFilePath)
+        GladiaWebsocketClientImpl(const std::string &apiKey, const std::string &caFilePath = {},
+                                  const WebsocketClientOptions &options = {})
+            : _apiKey(apiKey), _caFilePath(caFilePath), _options(options),
+              _connectionPool(std::make_unique<gladiapp::v2::curl_util::ConnectionPool>()),
+              _sessionCaches(std::make_shared<gladiapp::v2::curl_util::ConnectionPool>(2, false))
         {
+            if (options.reactorThreads > 0)
+            {
+                _reactor = std::make_shared<WebsocketReactor>(options.reactorThreads);
+                if (!_reactor->isRunning())
+                {
+                    spdlog::warn("WebSocket reactor unavailable, sessions use their own reception thread.");
+                    _reactor.reset();
+                }
+            }
+            if (options.callbackExecutor.mode == CallbackExecutorOptions::Mode::SHARED)
+            {
+                _callbackExecutor = std::make_shared<CallbackExecutor>(options.callbackExecutor.threads);
+            }
         }
 
         ~GladiaWebsocketClientImpl()
         {
         }
 
+        /**
+         * @param timing Receives the durations of the POST and of the warm-up running alongside it, if any.
+         * @param preconnectedSocket Receives the TCP connection to the session URL's host opened by the warm-up, if any.
+         */
         InitializeSessionResponse connect(const InitializeSessionRequest &initRequest,
-                                          TranscriptionError *transcriptionError) const
+                                          TranscriptionError *transcriptionError,
+                                          SessionStartTiming *timing = nullptr,
+                                          std::unique_ptr<gladiapp::v2::curl_util::PreconnectedSocket> *preconnectedSocket = nullptr) const
         {
             try
             {
@@ -59,14 +97,44 @@ namespace gladiapp::v2::ws
                 std::ostringstream oss;
                 oss << gladiapp::v2::common::LIVE_ENDPOINT << "?region=" << region;
 
-                auto httpResponse = gladiapp::v2::curl_util::performRequest(
-                    gladiapp::v2::curl_util::buildUrl(oss.str()), "POST", _apiKey,
-                    initRequest.toJson().dump(), "application/json", _caFilePath);
+                gladiapp::v2::curl_util::HttpRequest request;
+                request.url = gladiapp::v2::curl_util::buildUrl(oss.str());
+                request.method = "POST";
+                request.body = initRequest.toJson().dump();
+                request.contentType = "application/json";
+
+                SessionStartTiming startTiming;
+                std::unique_ptr<gladiapp::v2::curl_util::PreconnectedSocket> socket;
+                bool knownOrigin = false;
+                const std::string warmUpOrigin = _options.pipelinedConnect ? liveOrigin(initRequest.region, knownOrigin) : std::string();
+                const auto start = std::chrono::steady_clock::now();
+                auto httpResponse = warmUpOrigin.empty()
+                                        ? gladiapp::v2::curl_util::perform(request, _apiKey, _caFilePath, _connectionPool.get())
+                                        : performWithWarmUp(request, warmUpOrigin, !knownOrigin, startTiming, socket);
+                if (warmUpOrigin.empty())
+                {
+                    startTiming.initRequestMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                }
 
                 if (httpResponse.statusCode == 201)
                 {
                     InitializeSessionResponse initResponse = InitializeSessionResponse::fromJson(nlohmann::json::parse(httpResponse.body));
                     spdlog::info("Session initialized successfully: {}, {}", initResponse.id, initResponse.url);
+                    const std::string origin = gladiapp::v2::curl_util::httpOrigin(initResponse.url);
+                    startTiming.warmUpHit = !warmUpOrigin.empty() && origin == warmUpOrigin;
+                    if (_options.pipelinedConnect && !origin.empty())
+                    {
+                        std::lock_guard<std::mutex> lock(_liveOriginsMutex);
+                        _liveOrigins[initRequest.region] = origin;
+                    }
+                    if (timing != nullptr)
+                    {
+                        *timing = startTiming;
+                    }
+                    if (preconnectedSocket != nullptr && startTiming.warmUpHit)
+                    {
+                        *preconnectedSocket = std::move(socket);
+                    }
                     return initResponse;
                 }
                 else
@@ -86,14 +154,14 @@ namespace gladiapp::v2::ws
         }
 
         bool getResultById(const std::string &id,
-                           nlohmann::json &outputJson,
+                           std::string &outputBody,
                            gladiapp::v2::response::TranscriptionError *transcriptionError) const
         {
             try
             {
                 auto httpResponse = gladiapp::v2::curl_util::performRequest(
                     gladiapp::v2::curl_util::buildUrl(std::string(gladiapp::v2::common::LIVE_ENDPOINT) + "/" + id),
-                    "GET", _apiKey, "", "application/json", _caFilePath);
+                    "GET", _apiKey, "", "application/json", _caFilePath, _connectionPool.get());
 
                 if (httpResponse.statusCode != 200)
                 {
@@ -104,7 +172,7 @@ namespace gladiapp::v2::ws
                     }
                     return false;
                 }
-                outputJson = nlohmann::json::parse(httpResponse.body);
+                outputBody = std::move(httpResponse.body);
             }
             catch (std::exception &e)
             {
@@ -121,7 +189,7 @@ namespace gladiapp::v2::ws
             {
                 auto httpResponse = gladiapp::v2::curl_util::performRequest(
                     gladiapp::v2::curl_util::buildUrl(std::string(gladiapp::v2::common::LIVE_ENDPOINT) + "/" + id),
-                    "DELETE", _apiKey, "", "application/json", _caFilePath);
+                    "DELETE", _apiKey, "", "application/json", _caFilePath, _connectionPool.get());
 
                 if (httpResponse.statusCode != 202)
                 {
@@ -141,32 +209,270 @@ namespace gladiapp::v2::ws
             return true;
         }
 
+        gladiapp::v2::ConnectionPoolStats getConnectionPoolStats() const
+        {
+            return _connectionPool->stats();
+        }
+
+        /**
+         * The DNS and TLS session caches the sessions' WebSocket handles attach to, shared with the warm-up.
+         */
+        std::shared_ptr<gladiapp::v2::curl_util::ConnectionPool> sessionCaches() const
+        {
+            return _sessionCaches;
+        }
+
+        /**
+         * The reactor shared by the sessions of this client, null when they run their own reception thread.
+         */
+        std::shared_ptr<WebsocketReactor> reactor() const
+        {
+            return _reactor;
+        }
+
+        /**
+         * The pool running the callbacks of this client's sessions, null unless they share one.
+         */
+        std::shared_ptr<CallbackExecutor> callbackExecutor() const
+        {
+            return _callbackExecutor;
+        }
+
+        const WebsocketClientOptions &options() const
+        {
+            return _options;
+        }
+
+    private:
+        /**
+         * Origin of the WebSocket URLs of a region: the last one seen, the region's default host before.
+         * @param known Set to false when no session of the region was created yet.
+         */
+        std::string liveOrigin(InitializeSessionRequest::Region region, bool &known) const
+        {
+            std::lock_guard<std::mutex> lock(_liveOriginsMutex);
+            auto origin = _liveOrigins.find(region);
+            known = origin != _liveOrigins.end();
+            if (known)
+            {
+                return origin->second;
+            }
+            return std::string("https://") + (region == InitializeSessionRequest::Region::EU_WEST ? gladiapp::v2::common::LIVE_HOST_EU_WEST
+                                                                                                : gladiapp::v2::common::LIVE_HOST_US_WEST);
+        }
+
+        /**
+         * Performs the request while the origin is warmed up on the same multi handle: a bare TCP connection
+         * is opened for the WebSocket and, with warmUpTls, a HEAD request fills the shared TLS session cache
+         * (a full request rather than a handshake, TLS 1.3 servers send their session tickets after it).
+         * Once the request is answered the connection is still waited for, which costs the WebSocket no
+         * more than it saves, but the HEAD is abandoned. The warm-up never fails the request.
+         */
+        gladiapp::v2::curl_util::HttpResponse performWithWarmUp(const gladiapp::v2::curl_util::HttpRequest &request,
+                                                                const std::string &origin,
+                                                                bool warmUpTls,
+                                                                SessionStartTiming &timing,
+                                                                std::unique_ptr<gladiapp::v2::curl_util::PreconnectedSocket> &socket) const
+        {
+            using Clock = std::chrono::steady_clock;
+            gladiapp::v2::curl_util::EasyHandle post(_connectionPool.get());
+            gladiapp::v2::curl_util::HttpResponse response;
+            gladiapp::v2::curl_util::TransferSetup setup(post.get(), request, _apiKey, _caFilePath, &response.body);
+
+            // not a pooled handle: its connection leaves with the socket
+            const std::string tcpUrl = gladiapp::v2::curl_util::tcpUrl(origin);
+            std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> preconnect(tcpUrl.empty() ? nullptr : curl_easy_init(), curl_easy_cleanup);
+            if (preconnect != nullptr)
+            {
+                curl_easy_setopt(preconnect.get(), CURLOPT_SHARE, _sessionCaches->share());
+                curl_easy_setopt(preconnect.get(), CURLOPT_URL, tcpUrl.c_str());
+                curl_easy_setopt(preconnect.get(), CURLOPT_CONNECT_ONLY, 1L);
+                curl_easy_setopt(preconnect.get(), CURLOPT_CONNECTTIMEOUT_MS, WARM_UP_TIMEOUT_MS);
+            }
+
+            std::unique_ptr<gladiapp::v2::curl_util::EasyHandle> head;
+            const std::string headUrl = origin + "/";
+            if (warmUpTls)
+            {
+                head = std::make_unique<gladiapp::v2::curl_util::EasyHandle>(_sessionCaches.get());
+                curl_easy_setopt(head->get(), CURLOPT_URL, headUrl.c_str());
+                curl_easy_setopt(head->get(), CURLOPT_NOBODY, 1L);
+                curl_easy_setopt(head->get(), CURLOPT_USERAGENT, gladiapp::v2::common::USER_AGENT);
+                curl_easy_setopt(head->get(), CURLOPT_TIMEOUT_MS, WARM_UP_TIMEOUT_MS);
+                gladiapp::v2::curl_util::applyCaFile(head->get(), _caFilePath);
+                // same ALPN as the WebSocket upgrade, whose TLS session it must be able to resume
+                gladiapp::v2::curl_util::applyHttpVersion(head->get(), TransportOptions::HttpVersion::HTTP_1_1);
+            }
+
+            CURLM *multi = curl_multi_init();
+            if (multi == nullptr)
+            {
+                throw std::runtime_error("Failed to initialize curl multi handle");
+            }
+            curl_multi_add_handle(multi, post.get());
+            if (preconnect != nullptr)
+            {
+                curl_multi_add_handle(multi, preconnect.get());
+            }
+            if (head != nullptr)
+            {
+                curl_multi_add_handle(multi, head->get());
+            }
+
+            const auto start = Clock::now();
+            auto answeredAt = start;
+            CURLcode postResult = CURLE_OK;
+            CURLcode preconnectResult = CURLE_OK;
+            CURLcode headResult = CURLE_OK;
+            bool postDone = false;
+            bool preconnectDone = preconnect == nullptr;
+            bool headDone = false;
+            // a failed POST does not wait for the connection
+            while (!postDone || (!preconnectDone && postResult == CURLE_OK))
+            {
+                int running = 0;
+                curl_multi_perform(multi, &running);
+                int queued = 0;
+                while (CURLMsg *message = curl_multi_info_read(multi, &queued))
+                {
+                    if (message->msg != CURLMSG_DONE)
+                    {
+                        continue;
+                    }
+                    if (message->easy_handle == post.get())
+                    {
+                        postDone = true;
+                        postResult = message->data.result;
+                        answeredAt = Clock::now();
+                    }
+                    else if (message->easy_handle == preconnect.get())
+                    {
+                        preconnectDone = true;
+                        preconnectResult = message->data.result;
+                    }
+                    else
+                    {
+                        headDone = true;
+                        headResult = message->data.result;
+                    }
+                }
+                if (!postDone || (!preconnectDone && postResult == CURLE_OK))
+                {
+                    curl_multi_poll(multi, nullptr, 0, 100, nullptr);
+                }
+            }
+
+            const bool preconnected = preconnect != nullptr && preconnectDone && preconnectResult == CURLE_OK;
+            if (preconnected)
+            {
+                const auto phases = gladiapp::v2::curl_util::connectPhases(preconnect.get());
+                timing.warmedUp = true;
+                timing.warmUpDnsMs = phases.dnsMs;
+                timing.warmUpTcpMs = phases.tcpMs;
+                timing.warmUpMs = phases.totalMs;
+                // the handle forgets its connection once out of the multi handle
+                socket = gladiapp::v2::curl_util::PreconnectedSocket::take(preconnect.get());
+            }
+            else if (preconnectDone && preconnect != nullptr)
+            {
+                spdlog::warn("Warm-up connection to {} failed: {}", origin, curl_easy_strerror(preconnectResult));
+            }
+            if (headDone && headResult == CURLE_OK)
+            {
+                timing.warmUpTlsMs = gladiapp::v2::curl_util::connectPhases(head->get()).tlsMs;
+            }
+
+            curl_multi_remove_handle(multi, post.get());
+            if (preconnect != nullptr)
+            {
+                curl_multi_remove_handle(multi, preconnect.get());
+            }
+            if (head != nullptr)
+            {
+                curl_multi_remove_handle(multi, head->get());
+            }
+            curl_multi_cleanup(multi);
+
+            if (postResult != CURLE_OK)
+            {
+                throw std::runtime_error(std::string("curl request failed: ") + curl_easy_strerror(postResult));
+            }
+            curl_easy_getinfo(post.get(), CURLINFO_RESPONSE_CODE, &response.statusCode);
+            post.recordTransfer();
+
+            timing.initRequestMs = std::chrono::duration<double, std::milli>(answeredAt - start).count();
+            timing.warmUpWaitMs = std::chrono::duration<double, std::milli>(Clock::now() - answeredAt).count();
+            return response;
+        }
+
     private:
+        static constexpr long WARM_UP_TIMEOUT_MS = 3000;
+
         std::string _apiKey;
         std::string _caFilePath;
+        WebsocketClientOptions _options;
+        std::unique_ptr<gladiapp::v2::curl_util::ConnectionPool> _connectionPool;
+        std::shared_ptr<gladiapp::v2::curl_util::ConnectionPool> _sessionCaches;
+        std::shared_ptr<WebsocketReactor> _reactor;
+        std::shared_ptr<CallbackExecutor> _callbackExecutor;
+        mutable std::mutex _liveOriginsMutex;
+        mutable std::map<InitializeSessionRequest::Region, std::string> _liveOrigins;
     };
 
     class GladiaWebsocketClientSessionImpl
     {
     public:
-        GladiaWebsocketClientSessionImpl(const std::string &endpoint, const std::string &caFilePath = {})
+        GladiaWebsocketClientSessionImpl(const std::string &endpoint, const std::string &caFilePath = {},
+                                         std::shared_ptr<WebsocketReactor> reactor = nullptr,
+                                         const WebsocketClientOptions &options = {})
             : _endpoint(endpoint),
               _caFilePath(caFilePath),
+              _reactor(std::move(reactor)),
+              // a full queue, the frame being written and the buffer being filled must all fit back into the pool
+              _audioBufferPool(std::make_shared<AudioBufferPool>(options.audioBufferSize,
+                                                                 std::max(options.audioBufferPoolSize, sendQueueOptions(options).capacity + 2))),
               _curl(nullptr),
               _keepReading(false),
-              _canSendData(true)
+              _canSendData(true),
+              _reconnectOptions(options.reconnect),
+              _callbackOptions(options.callbackExecutor)
         {
             gladiapp::v2::curl_util::ensureGlobalInit();
+            const SendQueueOptions queueOptions = sendQueueOptions(options);
+            if (queueOptions.capacity > 0)
+            {
+                _ownedSendQueue = makeSendQueue(queueOptions);
+                _sendQueue = _ownedSendQueue.get();
+            }
+            if (options.coalescing.targetMs > 0)
+            {
+                _coalescer = std::make_shared<AudioCoalescer>(options.coalescing, TimerWheel::shared(), [this](const uint8_t *data, std::size_t size)
+                                                              { return transmitFrame(reinterpret_cast<const char *>(data), size, CURLWS_BINARY); });
+            }
+            if (_reconnectOptions.enabled)
+            {
+                _replayBuffer = std::make_unique<AudioReplayBuffer>(replayBufferBytes(audio::AudioFormat().bytesPerSecond()));
+            }
         }
 
         ~GladiaWebsocketClientSessionImpl()
         {
+            stopReconnecting();
+            if (_coalescer != nullptr)
+            {
+                // no deadline may send through this session any more
+                _coalescer->close();
+            }
             _keepReading = false;
+            detachFromReactor();
+            wakeReceptionThread();
             if (_dataReceptionThread.joinable())
             {
                 _dataReceptionThread.join();
             }
+            closeReceptionWaiter();
             disconnect();
+            stopCallbacks();
         }
 
         bool connectAndStart(const std::function<void(const std::string &)> &dataReadCallback,
@@ -178,7 +484,16 @@ namespace gladiapp::v2::ws
             {
                 return false;
             }
-            if (!startThread(dataReadCallback, onConnectedCallback, onDisconnectedCallback, onErrorCallback))
+            {
+                std::lock_guard<std::mutex> lock(_reconnectMutex);
+                _stopReconnecting = false;
+            }
+            if (WebsocketSendQueue *queue = _sendQueue)
+            {
+                queue->setErrorFunction(onErrorCallback);
+                queue->start();
+            }
+            if (!startReceiving(dataReadCallback, onConnectedCallback, onDisconnectedCallback, onErrorCallback))
             {
                 disconnect();
                 return false;
@@ -190,10 +505,11 @@ namespace gladiapp::v2::ws
         {
             if (_canSendData)
             {
+                flushCoalescedAudio();
                 _canSendData = false;
                 nlohmann::json stopJson = {{"type", "stop_recording"}};
                 std::string payload = stopJson.dump();
-                if (!sendFrame(payload.data(), payload.size(), CURLWS_TEXT))
+                if (!transmitFrame(payload.data(), payload.size(), CURLWS_TEXT, true))
                 {
                     spdlog::error("Error sending stop signal");
                     return false;
@@ -205,20 +521,35 @@ namespace gladiapp::v2::ws
 
         void disconnect()
         {
-            std::lock_guard<std::mutex> lock(_sendMutex);
-            if (_curl != nullptr)
+            flushCoalescedAudio();
+            if (WebsocketSendQueue *queue = _sendQueue)
+            {
+                // flushes the queued frames, the stop signal included, before the close frame
+                queue->stop();
+            }
+            // a write still stalled on a full socket gives up instead of holding the session for SEND_TIMEOUT_MS
+            _abortWrites = true;
+            stopReconnecting();
+            detachFromReactor();
+            auto lock = lockSend();
+            if (CURL *curl = _curl.exchange(nullptr))
             {
                 size_t sent = 0;
-                curl_ws_send(_curl, "", 0, &sent, 0, CURLWS_CLOSE);
-                curl_easy_cleanup(_curl);
-                _curl = nullptr;
+                curl_ws_send(curl, "", 0, &sent, 0, CURLWS_CLOSE);
+                curl_easy_cleanup(curl);
                 spdlog::info("WebSocket disconnected.");
             }
+            lock.unlock();
+            stopCallbacks();
         }
 
+        /**
+         * True while a dropped connection is being restored as well. Only a hint for the caller:
+         * the connection may be swapped right after, the senders check it again under the send mutex.
+         */
         bool isConnected() const
         {
-            return _curl != nullptr;
+            return _curl != nullptr || _reconnecting;
         }
 
         bool sendAudioBinary(const uint8_t *audioData, int size,
@@ -234,20 +565,26 @@ namespace gladiapp::v2::ws
                 spdlog::warn("Cannot send audio data after stop signal has been sent.");
                 return false;
             }
-            if (!sendFrame(reinterpret_cast<const char *>(audioData), static_cast<size_t>(size), CURLWS_BINARY))
+            bool transmitted = _coalescer != nullptr ? _coalescer->add(audioData, static_cast<size_t>(size))
+                                                     : transmitFrame(reinterpret_cast<const char *>(audioData), static_cast<size_t>(size), CURLWS_BINARY);
+            if (!transmitted)
             {
                 if (errorCallback)
                 {
-                    errorCallback("Error sending audio binary data");
+                    errorCallback(_sendQueue != nullptr ? "Audio binary data could not be queued" : "Error sending audio binary data");
                 }
                 return false;
             }
-            spdlog::debug("Sent {} bytes of audio binary data.", size);
+            spdlog::debug("{} {} bytes of audio binary data.", _sendQueue != nullptr ? "Queued" : "Sent", size);
             return true;
         }
 
+        /**
+         * Sends a text frame; audioBytes is the size of the audio it carries, for the replay offsets.
+         */
         bool sendTextJson(const std::string &jsonText,
-                          std::function<void(const std::string &)> errorCallback = nullptr) const
+                          std::function<void(const std::string &)> errorCallback = nullptr,
+                          std::size_t audioBytes = 0) const
         {
             if (!isConnected())
             {
@@ -259,56 +596,451 @@ namespace gladiapp::v2::ws
                 spdlog::warn("Cannot send text data after stop signal has been sent.");
                 return false;
             }
-            if (!sendFrame(jsonText.data(), jsonText.size(), CURLWS_TEXT))
+            flushCoalescedAudio();
+            if (!transmitFrame(jsonText.data(), jsonText.size(), CURLWS_TEXT, false, audioBytes))
             {
                 if (errorCallback)
                 {
-                    errorCallback("Error sending JSON text data");
+                    errorCallback(_sendQueue != nullptr ? "JSON text data could not be queued" : "Error sending JSON text data");
                 }
                 return false;
             }
-            spdlog::debug("Sent JSON text data: {}", jsonText);
+            spdlog::debug("{} JSON text data: {}", _sendQueue != nullptr ? "Queued" : "Sent", jsonText);
             return true;
         }
 
-    private:
-        bool sendFrame(const char *data, size_t len, unsigned int flags) const
+        AudioBuffer acquireAudioBuffer() const
         {
-            std::lock_guard<std::mutex> lock(_sendMutex);
-            if (_curl == nullptr)
+            return AudioBuffer(_audioBufferPool->take(), _audioBufferPool);
+        }
+
+        bool submitAudio(AudioBuffer &&buffer,
+                         std::function<void(const std::string &)> errorCallback = nullptr) const
+        {
+            if (!isConnected())
             {
+                spdlog::warn("WebSocket is not open. Cannot submit audio buffer.");
                 return false;
             }
-            size_t sent = 0;
-            CURLcode res = curl_ws_send(_curl, data, len, &sent, 0, flags);
-            if (res != CURLE_OK)
+            if (!_canSendData)
+            {
+                spdlog::warn("Cannot send audio data after stop signal has been sent.");
+                return false;
+            }
+            if (!buffer)
+            {
+                spdlog::warn("Cannot submit an empty audio buffer.");
+                return false;
+            }
+            flushCoalescedAudio();
+            std::size_t size = buffer.size();
+            bool transmitted = false;
+            WebsocketSendQueue *queue = _sendQueue;
+            if (queue == nullptr)
             {
-                spdlog::error("curl_ws_send failed: {}", curl_easy_strerror(res));
+                transmitted = sendFrame(reinterpret_cast<const char *>(buffer.data()), size, CURLWS_BINARY);
+            }
+            else
+            {
+                WebsocketSendQueue::Frame frame;
+                frame.flags = CURLWS_BINARY;
+                frame.audio = std::move(buffer);
+                transmitted = queue->enqueue(std::move(frame));
+            }
+            if (!transmitted)
+            {
+                if (errorCallback)
+                {
+                    errorCallback(queue != nullptr ? "Audio buffer could not be queued" : "Error sending audio binary data");
+                }
                 return false;
             }
+            spdlog::debug("{} {} bytes of audio binary data.", queue != nullptr ? "Queued" : "Sent", size);
             return true;
         }
 
-        static bool waitSocketReadable(curl_socket_t sockfd, long timeoutMs)
+        SendQueueStats getSendQueueStats() const
+        {
+            WebsocketSendQueue *queue = _sendQueue;
+            return queue != nullptr ? queue->stats() : SendQueueStats{};
+        }
+
+        /**
+         * Byte rate of the session's audio, for the coalescing target and the replay buffer size.
+         */
+        void setAudioBytesPerSecond(std::size_t bytesPerSecond)
+        {
+            if (_coalescer != nullptr)
+            {
+                _coalescer->setBytesPerSecond(bytesPerSecond);
+            }
+            if (_replayBuffer != nullptr)
+            {
+                _replayBuffer->setCapacity(replayBufferBytes(bytesPerSecond));
+            }
+        }
+
+        /**
+         * True when audio acknowledgments release the replay buffer.
+         */
+        bool replaysAudio() const
+        {
+            return _replayBuffer != nullptr;
+        }
+
+        void acknowledgeAudio(std::uint64_t end)
+        {
+            if (_replayBuffer != nullptr)
+            {
+                _replayBuffer->acknowledge(end);
+            }
+        }
+
+        ReconnectStats getReconnectStats() const
+        {
+            ReconnectStats stats;
+            stats.reconnections = _reconnections;
+            if (_replayBuffer != nullptr)
+            {
+                stats.replayedBytes = _replayBuffer->replayedBytes();
+                stats.lostBytes = _replayBuffer->lostBytes();
+            }
+            return stats;
+        }
+
+        void setReconnectedCallback(const std::function<void()> &callback)
+        {
+            _onReconnectedCallback = callback;
+        }
+
+        /**
+         * Attaches the WebSocket handles to the client's caches, so that connections resume its TLS sessions.
+         */
+        void setSessionCaches(std::shared_ptr<gladiapp::v2::curl_util::ConnectionPool> sessionCaches)
+        {
+            _sessionCaches = std::move(sessionCaches);
+        }
+
+        void setStartTiming(const SessionStartTiming &timing)
+        {
+            _startTiming = timing;
+        }
+
+        /**
+         * Hands the session a TCP connection to its host, used by the next connectAndStart().
+         */
+        void setPreconnectedSocket(std::unique_ptr<gladiapp::v2::curl_util::PreconnectedSocket> socket)
         {
-            fd_set readfds;
-            FD_ZERO(&readfds);
-            FD_SET(sockfd, &readfds);
-            struct timeval tv;
-            tv.tv_sec = timeoutMs / 1000;
-            tv.tv_usec = (timeoutMs % 1000) * 1000;
-            int rc = select(static_cast<int>(sockfd) + 1, &readfds, nullptr, nullptr, &tv);
-            return rc > 0;
+            _preconnectedSocket = std::move(socket);
+        }
+
+        SessionStartTiming getStartTiming() const
+        {
+            return _startTiming;
+        }
+
+        /**
+         * Runs the session's callbacks on the client's shared pool rather than on a thread of its own.
+         */
+        void setCallbackExecutor(std::shared_ptr<CallbackExecutor> executor)
+        {
+            _callbackExecutor = std::move(executor);
+        }
+
+        /**
+         * Strand the session's events are posted to, opened again by a new connectAndStart(); null when the
+         * callbacks run inline.
+         */
+        std::shared_ptr<CallbackExecutor::Strand> openCallbackStrand()
+        {
+            if (_callbackOptions.mode == CallbackExecutorOptions::Mode::INLINE)
+            {
+                return nullptr;
+            }
+            if (_callbackStrand == nullptr)
+            {
+                if (_callbackExecutor == nullptr)
+                {
+                    _callbackExecutor = std::make_shared<CallbackExecutor>(1);
+                }
+                _callbackStrand = _callbackExecutor->makeStrand(_callbackOptions);
+            }
+            _callbackStrand->reopen();
+            return _callbackStrand;
+        }
+
+        /**
+         * Delivers the events already received, then posts no more. Called from a callback, the events
+         * behind it are discarded instead.
+         */
+        void stopCallbacks()
+        {
+            if (_callbackStrand != nullptr)
+            {
+                _callbackStrand->drain();
+                _callbackStrand->close();
+            }
+        }
+
+        CallbackExecutorStats getCallbackExecutorStats() const
+        {
+            return _callbackStrand != nullptr ? _callbackStrand->stats() : CallbackExecutorStats{};
+        }
+
+        void setSendQueueHighWaterCallback(const std::function<void(std::size_t depth)> &callback)
+        {
+            std::lock_guard<std::mutex> lock(_sendQueueMutex);
+            _onSendQueueHighWater = callback;
+            if (_ownedSendQueue != nullptr)
+            {
+                _ownedSendQueue->setHighWaterFunction(callback);
+            }
+        }
+
+        /**
+         * Creates the send queue of a session that has none (SendQueueOptions::capacity 0), for audio sent
+         * from the shared timer thread. Frames already written synchronously stay ahead of the queued ones.
+         */
+        void ensureSendQueue()
+        {
+            std::lock_guard<std::mutex> lock(_sendQueueMutex);
+            if (_ownedSendQueue != nullptr)
+            {
+                return;
+            }
+            SendQueueOptions options;
+            options.capacity = DEFAULT_SEND_QUEUE_CAPACITY;
+            auto queue = makeSendQueue(options);
+            queue->setErrorFunction(_onErrorCallback);
+            queue->setHighWaterFunction(_onSendQueueHighWater);
+            queue->start();
+            _ownedSendQueue = std::move(queue);
+            _sendQueue = _ownedSendQueue.get();
+            spdlog::info("Created a send queue of {} frames for audio sent from the timer thread.", options.capacity);
+        }
+
+    private:
+        /**
+         * The coalescer flushes from the shared timer thread, which must not write to sockets: a session
+         * coalescing audio without a send queue gets one of DEFAULT_SEND_QUEUE_CAPACITY frames.
+         */
+        static SendQueueOptions sendQueueOptions(const WebsocketClientOptions &options)
+        {
+            SendQueueOptions queueOptions = options.sendQueue;
+            if (queueOptions.capacity == 0 && options.coalescing.targetMs > 0)
+            {
+                queueOptions.capacity = DEFAULT_SEND_QUEUE_CAPACITY;
+            }
+            return queueOptions;
+        }
+
+        std::unique_ptr<WebsocketSendQueue> makeSendQueue(const SendQueueOptions &options)
+        {
+            return std::make_unique<WebsocketSendQueue>(options, [this](const WebsocketSendQueue::Frame &frame)
+                                                        { return sendFrame(frame.data(), frame.size(), frame.flags, frame.audioBytes); });
+        }
+
+        /**
+         * Sends the audio gathered by the coalescer, ahead of a frame that must follow it.
+         */
+        void flushCoalescedAudio() const
+        {
+            if (_coalescer != nullptr)
+            {
+                _coalescer->flush();
+            }
+        }
+
+        /**
+         * Hands the frame to the send queue when the session has one, writes it right away otherwise.
+         */
+        bool transmitFrame(const char *data, size_t len, unsigned int flags, bool control = false, std::size_t audioBytes = 0) const
+        {
+            WebsocketSendQueue *queue = _sendQueue;
+            if (queue == nullptr)
+            {
+                return sendFrame(data, len, flags, audioBytes);
+            }
+            return queue->enqueue(WebsocketSendQueue::Frame{std::string(data, len), flags, AudioBuffer{}, audioBytes}, control);
+        }
+
+        bool sendFrame(const char *data, size_t len, unsigned int flags, std::size_t audioBytes = 0) const
+        {
+            auto lock = lockSend();
+            if (_replayBuffer != nullptr && flags == CURLWS_BINARY && (_curl != nullptr || _reconnecting))
+            {
+                // kept until acknowledged; a write failing with the connection is replayed once it is restored
+                _replayBuffer->append(data, len);
+                if (!_reconnecting && !writeFrame(data, len, flags, lock))
+                {
+                    spdlog::warn("Audio frame of {} bytes kept for replay.", len);
+                }
+                return true;
+            }
+            if (_reconnecting)
+            {
+                // sent after the replayed audio
+                _heldFrames.push_back(WebsocketSendQueue::Frame{std::string(data, len), flags, AudioBuffer{}, audioBytes});
+                return true;
+            }
+            skipReplayedAudio(audioBytes);
+            return writeFrame(data, len, flags, lock);
+        }
+
+        /**
+         * Moves the replay offsets past audio sent as JSON, the send mutex being held: the server counts it,
+         * the buffer cannot send it again.
+         */
+        void skipReplayedAudio(std::size_t audioBytes) const
+        {
+            if (_replayBuffer != nullptr && audioBytes > 0 && _curl != nullptr)
+            {
+                _replayBuffer->skip(audioBytes);
+            }
+        }
+
+        /**
+         * Takes the send mutex once no frame is being written: a writer waiting for socket space releases it,
+         * and curl wants the rest of that frame before anything else.
+         */
+        std::unique_lock<std::mutex> lockSend() const
+        {
+            std::unique_lock<std::mutex> lock(_sendMutex);
+            _writerCondition.wait(lock, [this]()
+                                  { return !_writing; });
+            return lock;
+        }
+
+        /**
+         * Writes a frame to the current connection, the send mutex being held through lockSend().
+         */
+        bool writeFrame(const char *data, size_t len, unsigned int flags, std::unique_lock<std::mutex> &lock) const
+        {
+            // only swapped under the send mutex, which waitWritable() keeps from other senders while released
+            CURL *curl = _curl.load();
+            if (curl == nullptr)
+            {
+                return false;
+            }
+            // a full socket buffer leaves the frame partially sent: curl then wants the rest,
+            // or the very same arguments again after CURLE_AGAIN, before anything else
+            size_t offset = 0;
+            do
+            {
+                size_t sent = 0;
+                CURLcode res = curl_ws_send(curl, data + offset, len - offset, &sent, 0, flags);
+                if (res == CURLE_AGAIN)
+                {
+                    if (!waitWritable(curl, lock))
+                    {
+                        spdlog::error("curl_ws_send failed: socket not writable after {} ms", SEND_TIMEOUT_MS);
+                        return false;
+                    }
+                    continue;
+                }
+                if (res != CURLE_OK)
+                {
+                    spdlog::error("curl_ws_send failed: {}", curl_easy_strerror(res));
+                    return false;
+                }
+                offset += sent;
+            } while (offset < len);
+            return true;
+        }
+
+        /**
+         * Waits up to SEND_TIMEOUT_MS for space in the socket buffer, without holding the send mutex meanwhile.
+         * Other senders wait in lockSend(); disconnect() aborts the wait.
+         */
+        bool waitWritable(CURL *curl, std::unique_lock<std::mutex> &lock) const
+        {
+            curl_socket_t sockfd = CURL_SOCKET_BAD;
+            curl_easy_getinfo(curl, CURLINFO_ACTIVESOCKET, &sockfd);
+            if (sockfd == CURL_SOCKET_BAD)
+            {
+                return false;
+            }
+            _writing = true;
+            lock.unlock();
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SEND_TIMEOUT_MS);
+            bool writable = false;
+            while (!writable && !_abortWrites && std::chrono::steady_clock::now() < deadline)
+            {
+                writable = waitSocket(sockfd, POLLOUT, WRITE_WAIT_SLICE_MS);
+            }
+            lock.lock();
+            _writing = false;
+            _writerCondition.notify_all();
+            return writable && !_abortWrites;
+        }
+
+        /**
+         * poll() rather than select(): with thousands of sessions socket numbers pass FD_SETSIZE.
+         */
+        static bool waitSocket(curl_socket_t sockfd, short events, long timeoutMs)
+        {
+#ifdef _WIN32
+            WSAPOLLFD pollFd{};
+            pollFd.fd = sockfd;
+            pollFd.events = events;
+            return WSAPoll(&pollFd, 1, static_cast<INT>(timeoutMs)) > 0;
+#else
+            pollfd pollFd{};
+            pollFd.fd = sockfd;
+            pollFd.events = events;
+            return poll(&pollFd, 1, static_cast<int>(timeoutMs)) > 0;
+#endif
         }
 
         bool connect()
+        {
+            auto socket = std::move(_preconnectedSocket);
+            CURL *curl = openConnection(0, socket.get());
+            _startTiming.wsPreconnected = curl != nullptr && socket != nullptr && socket->handedOver();
+            if (curl == nullptr && socket != nullptr)
+            {
+                // the server may have closed the connection meanwhile
+                spdlog::warn("Preconnected socket unusable, connecting again.");
+                curl = openConnection();
+            }
+            if (curl == nullptr)
+            {
+                return false;
+            }
+            {
+                auto lock = lockSend();
+                _curl = curl;
+            }
+            const auto phases = gladiapp::v2::curl_util::connectPhases(curl);
+            _startTiming.wsDnsMs = phases.dnsMs;
+            _startTiming.wsTcpMs = phases.tcpMs;
+            _startTiming.wsTlsMs = phases.tlsMs;
+            _startTiming.wsUpgradeMs = phases.transferMs;
+            _startTiming.wsConnectMs = phases.totalMs;
+            return true;
+        }
+
+        /**
+         * @param timeoutMs Connection timeout, 0 for curl's default.
+         * @param socket TCP connection to use instead of opening one, if any.
+         * @return connected handle, null on failure.
+         */
+        CURL *openConnection(long timeoutMs = 0, gladiapp::v2::curl_util::PreconnectedSocket *socket = nullptr) const
         {
             spdlog::info("Connecting to {} ...", _endpoint);
             CURL *curl = curl_easy_init();
             if (!curl)
             {
                 spdlog::error("Failed to initialize curl easy handle");
-                return false;
+                return nullptr;
+            }
+            if (_sessionCaches != nullptr)
+            {
+                curl_easy_setopt(curl, CURLOPT_SHARE, _sessionCaches->share());
+            }
+            if (socket != nullptr)
+            {
+                socket->apply(curl);
             }
 
             curl_easy_setopt(curl, CURLOPT_URL, _endpoint.c_str());
@@ -316,94 +1048,430 @@ namespace gladiapp::v2::ws
             gladiapp::v2::curl_util::applyCaFile(curl, _caFilePath);
             // 2L: connect and prepare the handle for use with curl_ws_send/curl_ws_recv
             curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 2L);
+            if (timeoutMs > 0)
+            {
+                curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, timeoutMs);
+            }
 
             CURLcode res = curl_easy_perform(curl);
             if (res != CURLE_OK)
             {
                 spdlog::error("Error occurred: {}", curl_easy_strerror(res));
                 curl_easy_cleanup(curl);
-                return false;
+                return nullptr;
             }
 
-            _curl = curl;
             spdlog::info("WebSocket connected successfully!");
-            return true;
+            return curl;
+        }
+
+        bool startReceiving(const std::function<void(const std::string &)> &dataReadCallback,
+                            const std::function<void()> &onConnectedCallback = nullptr,
+                            const std::function<void(const std::string &message)> &onDisconnectedCallback = nullptr,
+                            const std::function<void(const std::string &errorMessage)> &onErrorCallback = nullptr)
+        {
+            _dataReadCallback = dataReadCallback;
+            _onConnectedCallback = onConnectedCallback;
+            _onDisconnectedCallback = onDisconnectedCallback;
+            _onErrorCallback = onErrorCallback;
+            _receivedFirstFrame = false;
+            return watchSocket();
         }
 
-        bool startThread(const std::function<void(const std::string &)> &dataReadCallback,
-                         const std::function<void()> &onConnectedCallback = nullptr,
-                         const std::function<void(const std::string &message)> &onDisconnectedCallback = nullptr,
-                         const std::function<void(const std::string &errorMessage)> &onErrorCallback = nullptr)
+        /**
+         * Starts draining the current connection, on the reactor or a reception thread.
+         */
+        bool watchSocket()
         {
-            _dataReceptionThread = std::thread([this, dataReadCallback, onConnectedCallback, onDisconnectedCallback, onErrorCallback]()
+            _messageAccumulator.clear();
+            _keepReading = true;
+
+            curl_socket_t sockfd = CURL_SOCKET_BAD;
+            curl_easy_getinfo(_curl.load(), CURLINFO_ACTIVESOCKET, &sockfd);
+
+            if (_reactor != nullptr && _reactor->isRunning() && sockfd != CURL_SOCKET_BAD)
+            {
+                _reactorRegistration = _reactor->add(static_cast<int>(sockfd), [this]()
+                                                     { return receiveAvailable(); });
+                if (_reactorRegistration != 0)
+                {
+                    return true;
+                }
+                spdlog::warn("Falling back to a dedicated reception thread.");
+            }
+
+            openReceptionWaiter(sockfd);
+            _dataReceptionThread = std::thread([this, sockfd]()
                                                {
-                _keepReading = true;
-                curl_socket_t sockfd = CURL_SOCKET_BAD;
-                curl_easy_getinfo(_curl, CURLINFO_ACTIVESOCKET, &sockfd);
+                while (receiveAvailable())
+                {
+                    waitReadableOrWoken(sockfd);
+                } });
+            return true;
+        }
+
+        /**
+         * Lets the reception thread sleep until the socket is readable or the session stops: the socket and
+         * an eventfd are watched by a per-session epoll instance. Without it the thread polls the socket.
+         */
+        void openReceptionWaiter(curl_socket_t sockfd)
+        {
+#ifdef __linux__
+            _receptionEpollFd = epoll_create1(EPOLL_CLOEXEC);
+            _receptionWakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            epoll_event socketEvent{};
+            socketEvent.events = EPOLLIN;
+            socketEvent.data.fd = static_cast<int>(sockfd);
+            epoll_event wakeEvent{};
+            wakeEvent.events = EPOLLIN;
+            wakeEvent.data.fd = _receptionWakeFd;
+            if (_receptionEpollFd < 0 || _receptionWakeFd < 0 ||
+                epoll_ctl(_receptionEpollFd, EPOLL_CTL_ADD, static_cast<int>(sockfd), &socketEvent) != 0 ||
+                epoll_ctl(_receptionEpollFd, EPOLL_CTL_ADD, _receptionWakeFd, &wakeEvent) != 0)
+            {
+                spdlog::warn("epoll setup failed, the reception thread polls the socket instead.");
+                closeReceptionWaiter();
+            }
+#else
+            (void)sockfd;
+#endif
+        }
+
+        void waitReadableOrWoken(curl_socket_t sockfd)
+        {
+#ifdef __linux__
+            if (_receptionEpollFd >= 0)
+            {
+                epoll_event event{};
+                // EINTR or readiness alike: the caller reads again and checks whether it should stop
+                epoll_wait(_receptionEpollFd, &event, 1, -1);
+                return;
+            }
+#endif
+            waitSocket(sockfd, POLLIN, 200);
+        }
+
+        void wakeReceptionThread()
+        {
+#ifdef __linux__
+            if (_receptionWakeFd >= 0)
+            {
+                // left readable on purpose, the thread exits on the next check of _keepReading
+                std::uint64_t one = 1;
+                [[maybe_unused]] auto written = write(_receptionWakeFd, &one, sizeof(one));
+            }
+#endif
+        }
+
+        void closeReceptionWaiter()
+        {
+#ifdef __linux__
+            if (_receptionWakeFd >= 0)
+            {
+                close(_receptionWakeFd);
+                _receptionWakeFd = -1;
+            }
+            if (_receptionEpollFd >= 0)
+            {
+                close(_receptionEpollFd);
+                _receptionEpollFd = -1;
+            }
+#endif
+        }
 
-                bool isConnectedFlag = false;
-                std::string messageAccumulator;
-                std::vector<char> buffer(65536);
+        /**
+         * Reads every frame available without blocking, from the reception thread or a reactor I/O thread.
+         * @return false once the connection is over or the session is stopping.
+         */
+        bool receiveAvailable()
+        {
+            // shared by the sessions drained on this thread
+            thread_local std::vector<char> buffer(65536);
+
+            // the connection is only replaced once nothing drains it any more
+            CURL *curl = nullptr;
+            while ((curl = _curl.load()) != nullptr && _keepReading)
+            {
+                size_t bytesRead = 0;
+                const curl_ws_frame *meta = nullptr;
+                CURLcode res = curl_ws_recv(curl, buffer.data(), buffer.size(), &bytesRead, &meta);
 
-                while (_curl != nullptr && _keepReading)
+                if (res == CURLE_AGAIN)
                 {
-                    size_t bytesRead = 0;
-                    const curl_ws_frame *meta = nullptr;
-                    CURLcode res = curl_ws_recv(_curl, buffer.data(), buffer.size(), &bytesRead, &meta);
+                    return true;
+                }
 
-                    if (res == CURLE_AGAIN)
+                if (res != CURLE_OK)
+                {
+                    std::string errorMessage = curl_easy_strerror(res);
+                    if (startReconnecting(errorMessage))
                     {
-                        waitSocketReadable(sockfd, 200);
-                        continue;
+                        return false;
                     }
-
-                    if (res != CURLE_OK)
+                    spdlog::warn("WebSocket closed by server: {}", errorMessage);
+                    if (_onDisconnectedCallback)
                     {
-                        std::string errorMessage = curl_easy_strerror(res);
-                        spdlog::warn("WebSocket closed by server: {}", errorMessage);
-                        if (onDisconnectedCallback)
-                        {
-                            onDisconnectedCallback(errorMessage);
-                        }
-                        break;
+                        _onDisconnectedCallback(errorMessage);
                     }
+                    return false;
+                }
 
-                    if (!isConnectedFlag)
+                if (!_receivedFirstFrame)
+                {
+                    _receivedFirstFrame = true;
+                    if (_onConnectedCallback)
                     {
-                        isConnectedFlag = true;
-                        if (onConnectedCallback)
-                        {
-                            onConnectedCallback();
-                        }
+                        _onConnectedCallback();
                     }
+                }
 
-                    if (meta != nullptr && (meta->flags & CURLWS_CLOSE) != 0)
+                if (meta != nullptr && (meta->flags & CURLWS_CLOSE) != 0)
+                {
+                    spdlog::info("WebSocket close frame received.");
+                    if (_onDisconnectedCallback)
                     {
-                        spdlog::info("WebSocket close frame received.");
-                        if (onDisconnectedCallback)
-                        {
-                            onDisconnectedCallback("closed by server");
-                        }
-                        break;
+                        _onDisconnectedCallback("closed by server");
                     }
+                    return false;
+                }
+
+                _messageAccumulator.append(buffer.data(), bytesRead);
+                if (meta == nullptr || meta->bytesleft == 0)
+                {
+                    _dataReadCallback(_messageAccumulator);
+                    _messageAccumulator.clear();
+                }
+            }
+            return false;
+        }
+
+        std::size_t replayBufferBytes(std::size_t bytesPerSecond) const
+        {
+            return _reconnectOptions.replayBufferMs * bytesPerSecond / 1000;
+        }
+
+        /**
+         * Hands a lost connection over to the reconnection thread, from the thread draining the socket.
+         * The server closing the session, the stop signal sent or the session being stopped leave it closed.
+         * @return false if the session does not reconnect.
+         */
+        bool startReconnecting(const std::string &reason)
+        {
+            if (!_reconnectOptions.enabled || !_keepReading || !_canSendData)
+            {
+                return false;
+            }
+            std::thread previous;
+            {
+                std::lock_guard<std::mutex> lock(_reconnectMutex);
+                if (_stopReconnecting)
+                {
+                    return false;
+                }
+                previous = std::move(_reconnectThread);
+            }
+            // the previous reconnection is over, only its callback may still be running
+            if (previous.joinable())
+            {
+                previous.join();
+            }
+            std::lock_guard<std::mutex> lock(_reconnectMutex);
+            if (_stopReconnecting)
+            {
+                return false;
+            }
+            spdlog::warn("WebSocket connection lost: {}, reconnecting.", reason);
+            _reconnecting = true;
+            _reconnectThread = std::thread([this]()
+                                           { reconnect(); });
+            return true;
+        }
+
+        void reconnect()
+        {
+            // the lost connection is released once nothing watches its socket any more
+            detachFromReactor();
+            if (_dataReceptionThread.joinable())
+            {
+                _dataReceptionThread.join();
+            }
+            closeReceptionWaiter();
+            closeConnection();
 
-                    messageAccumulator.append(buffer.data(), bytesRead);
-                    if (meta == nullptr || meta->bytesleft == 0)
+            std::size_t backoffMs = _reconnectOptions.initialBackoffMs;
+            for (std::size_t attempt = 1; _reconnectOptions.maxAttempts == 0 || attempt <= _reconnectOptions.maxAttempts; ++attempt)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_reconnectMutex);
+                    if (_reconnectCondition.wait_for(lock, std::chrono::milliseconds(backoffMs), [this]()
+                                                     { return _stopReconnecting; }))
                     {
-                        dataReadCallback(messageAccumulator);
-                        messageAccumulator.clear();
+                        return;
                     }
-                } });
+                }
+                backoffMs = std::min(backoffMs * 2, std::max(_reconnectOptions.maxBackoffMs, _reconnectOptions.initialBackoffMs));
+                spdlog::info("Reconnection attempt {}.", attempt);
+                CURL *curl = openConnection(RECONNECT_TIMEOUT_MS);
+                if (curl == nullptr || !resume(curl))
+                {
+                    continue;
+                }
+                ++_reconnections;
+                watchSocket();
+                spdlog::info("WebSocket reconnected.");
+                if (_onReconnectedCallback)
+                {
+                    try
+                    {
+                        _onReconnectedCallback();
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::error("Error in reconnected callback: {}", e.what());
+                    }
+                }
+                return;
+            }
+
+            {
+                auto lock = lockSend();
+                _reconnecting = false;
+                _heldFrames.clear();
+            }
+            spdlog::error("WebSocket reconnection failed after {} attempts.", _reconnectOptions.maxAttempts);
+            if (_onDisconnectedCallback)
+            {
+                _onDisconnectedCallback("reconnection failed");
+            }
+        }
+
+        /**
+         * Switches the session to a new connection, sending the unacknowledged audio and then the frames
+         * held meanwhile before anything else.
+         * @return false if the new connection failed too, it is then closed.
+         */
+        bool resume(CURL *curl)
+        {
+            auto lock = lockSend();
+            _curl = curl;
+            bool resumed = _replayBuffer->replay(REPLAY_FRAME_BYTES, [this, &lock](const uint8_t *data, std::size_t size)
+                                                 { return writeFrame(reinterpret_cast<const char *>(data), size, CURLWS_BINARY, lock); });
+            while (resumed && !_heldFrames.empty())
+            {
+                const auto &frame = _heldFrames.front();
+                resumed = writeFrame(frame.data(), frame.size(), frame.flags, lock);
+                if (resumed)
+                {
+                    // a held frame failing here is sent again on the next connection, counted then
+                    skipReplayedAudio(frame.audioBytes);
+                    _heldFrames.pop_front();
+                }
+            }
+            if (!resumed)
+            {
+                curl_easy_cleanup(_curl.exchange(nullptr));
+                return false;
+            }
+            _reconnecting = false;
             return true;
         }
 
+        void closeConnection()
+        {
+            auto lock = lockSend();
+            if (CURL *curl = _curl.exchange(nullptr))
+            {
+                curl_easy_cleanup(curl);
+            }
+        }
+
+        /**
+         * Cancels a reconnection in progress and keeps the session from starting another one.
+         */
+        void stopReconnecting()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_reconnectMutex);
+                _stopReconnecting = true;
+            }
+            _reconnectCondition.notify_all();
+            if (_reconnectThread.joinable() && _reconnectThread.get_id() != std::this_thread::get_id())
+            {
+                _reconnectThread.join();
+            }
+            auto lock = lockSend();
+            _reconnecting = false;
+            _heldFrames.clear();
+        }
+
+        /**
+         * Takes the socket back from the reactor, which must happen before curl closes it.
+         */
+        void detachFromReactor()
+        {
+            if (_reactor != nullptr && _reactorRegistration != 0)
+            {
+                _reactor->remove(_reactorRegistration);
+                _reactorRegistration = 0;
+            }
+        }
+
     private:
+        static constexpr long SEND_TIMEOUT_MS = 5000;
+        static constexpr long WRITE_WAIT_SLICE_MS = 50;
+        static constexpr long RECONNECT_TIMEOUT_MS = 10000;
+        static constexpr std::size_t REPLAY_FRAME_BYTES = 32768;
+        static constexpr std::size_t DEFAULT_SEND_QUEUE_CAPACITY = 64;
+
         std::string _endpoint;
         std::string _caFilePath;
-        CURL *_curl;
+        std::shared_ptr<gladiapp::v2::curl_util::ConnectionPool> _sessionCaches;
+        SessionStartTiming _startTiming;
+        std::unique_ptr<gladiapp::v2::curl_util::PreconnectedSocket> _preconnectedSocket;
+        std::shared_ptr<WebsocketReactor> _reactor;
+        std::shared_ptr<AudioBufferPool> _audioBufferPool;
+        WebsocketReactor::RegistrationId _reactorRegistration = 0;
+        // swapped under the send mutex by the reconnection thread, read without it by isConnected()
+        std::atomic<CURL *> _curl;
         mutable std::mutex _sendMutex;
+        // set while a writer waits for socket space with the send mutex released
+        mutable std::condition_variable _writerCondition;
+        mutable bool _writing = false;
+        std::atomic<bool> _abortWrites{false};
         std::thread _dataReceptionThread;
+        int _receptionEpollFd = -1;
+        int _receptionWakeFd = -1;
         std::atomic<bool> _keepReading;
         std::atomic<bool> _canSendData;
+        // created at most once, possibly while other threads send (ensureSendQueue)
+        std::mutex _sendQueueMutex;
+        std::unique_ptr<WebsocketSendQueue> _ownedSendQueue;
+        std::atomic<WebsocketSendQueue *> _sendQueue{nullptr};
+        std::function<void(std::size_t depth)> _onSendQueueHighWater;
+        std::shared_ptr<AudioCoalescer> _coalescer;
+
+        // reconnection, the replay buffer and held frames are guarded by the send mutex
+        const ReconnectOptions _reconnectOptions;
+        std::unique_ptr<AudioReplayBuffer> _replayBuffer;
+        mutable std::deque<WebsocketSendQueue::Frame> _heldFrames;
+        std::atomic<bool> _reconnecting{false};
+        std::atomic<std::uint64_t> _reconnections{0};
+        std::mutex _reconnectMutex;
+        std::condition_variable _reconnectCondition;
+        bool _stopReconnecting = false;
+        std::thread _reconnectThread;
+        std::function<void()> _onReconnectedCallback;
+
+        const CallbackExecutorOptions _callbackOptions;
+        std::shared_ptr<CallbackExecutor> _callbackExecutor;
+        std::shared_ptr<CallbackExecutor::Strand> _callbackStrand;
+
+        // receive state, only touched by the thread draining the socket
+        std::function<void(const std::string &)> _dataReadCallback;
+        std::function<void()> _onConnectedCallback;
+        std::function<void(const std::string &message)> _onDisconnectedCallback;
+        std::function<void(const std::string &errorMessage)> _onErrorCallback;
+        bool _receivedFirstFrame = false;
+        std::string _messageAccumulator;
     };
 }
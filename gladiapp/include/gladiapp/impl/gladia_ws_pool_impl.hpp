@@ -0,0 +1,284 @@
+#pragma once
+
+#include "../gladiapp_ws_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace gladiapp::v2::ws
+{
+    class LiveSessionPoolImpl
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        LiveSessionPoolImpl(const GladiaWebsocketClient &client, const LiveSessionPoolOptions &options)
+            : _client(client), _options(options)
+        {
+            _options.maxIdle = std::max(_options.maxIdle, std::chrono::milliseconds(1));
+            _refillThread = std::thread([this]()
+                                        { run(); });
+        }
+
+        ~LiveSessionPoolImpl()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _condition.notify_all();
+            if (_refillThread.joinable())
+            {
+                _refillThread.join();
+            }
+            // the ready sessions send their stop signal and disconnect as the map goes away
+        }
+
+        void prewarm(const request::InitializeSessionRequest &initRequest)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _configs.emplace(initRequest.toJson().dump(), Config(initRequest));
+            }
+            _condition.notify_all();
+        }
+
+        std::unique_ptr<GladiaWebsocketClientSession> acquire(const request::InitializeSessionRequest &initRequest,
+                                                              gladiapp::v2::response::TranscriptionError *error)
+        {
+            const auto start = Clock::now();
+            const std::string key = initRequest.toJson().dump();
+            std::vector<ReadySession> retired;
+            std::unique_ptr<GladiaWebsocketClientSession> session;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                // only prewarmed configurations are kept ready, others are created on demand
+                auto config = _configs.find(key);
+                if (config != _configs.end())
+                {
+                    auto &ready = config->second.ready;
+                    // oldest first, so that sessions are used before they expire
+                    while (!ready.empty() && session == nullptr)
+                    {
+                        if (isUsable(ready.front(), start))
+                        {
+                            session = std::move(ready.front().session);
+                        }
+                        else
+                        {
+                            retired.push_back(std::move(ready.front()));
+                            ++_stats.expiredSessions;
+                        }
+                        ready.pop_front();
+                    }
+                }
+            }
+            _condition.notify_all();
+            retired.clear();
+
+            const bool warm = session != nullptr;
+            if (!warm)
+            {
+                session = createSession(initRequest, error);
+            }
+            recordHandout(warm, session != nullptr, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            return session;
+        }
+
+        LiveSessionPoolStats getStats() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            LiveSessionPoolStats stats = _stats;
+            for (const auto &config : _configs)
+            {
+                stats.readySessions += config.second.ready.size();
+            }
+            stats.meanWarmHandoutMs = stats.warmHandouts != 0 ? _totalWarmHandoutMs / static_cast<double>(stats.warmHandouts) : 0.0;
+            stats.meanColdHandoutMs = stats.coldHandouts != 0 ? _totalColdHandoutMs / static_cast<double>(stats.coldHandouts) : 0.0;
+            return stats;
+        }
+
+    private:
+        struct ReadySession
+        {
+            std::unique_ptr<GladiaWebsocketClientSession> session;
+            Clock::time_point connectedAt;
+            // cleared by the session's disconnected callback
+            std::shared_ptr<std::atomic<bool>> open;
+        };
+
+        struct Config
+        {
+            explicit Config(const request::InitializeSessionRequest &initRequest) : request(initRequest) {}
+
+            request::InitializeSessionRequest request;
+            std::deque<ReadySession> ready;
+            // sessions being created for this configuration
+            std::size_t pending = 0;
+            Clock::time_point retryAt{};
+        };
+
+        bool isUsable(const ReadySession &entry, Clock::time_point now) const
+        {
+            return *entry.open && now - entry.connectedAt < _options.maxIdle;
+        }
+
+        std::unique_ptr<GladiaWebsocketClientSession> createSession(const request::InitializeSessionRequest &initRequest,
+                                                                    gladiapp::v2::response::TranscriptionError *error,
+                                                                    const std::shared_ptr<std::atomic<bool>> &open = nullptr) const
+        {
+            gladiapp::v2::response::TranscriptionError connectError;
+            std::unique_ptr<GladiaWebsocketClientSession> session(_client.connect(initRequest, &connectError));
+            if (session == nullptr || session->getSessionInfo().url.empty())
+            {
+                if (error != nullptr)
+                {
+                    *error = connectError;
+                }
+                return nullptr;
+            }
+            if (open != nullptr)
+            {
+                session->setOnDisconnectedCallback([open]()
+                                                   { *open = false; });
+            }
+            if (!session->connectAndStart())
+            {
+                return nullptr;
+            }
+            return session;
+        }
+
+        void recordHandout(bool warm, bool succeeded, double elapsedMs)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!succeeded)
+            {
+                ++_stats.failedHandouts;
+                return;
+            }
+            if (warm)
+            {
+                ++_stats.warmHandouts;
+                _totalWarmHandoutMs += elapsedMs;
+                _stats.maxWarmHandoutMs = std::max(_stats.maxWarmHandoutMs, elapsedMs);
+            }
+            else
+            {
+                ++_stats.coldHandouts;
+                _totalColdHandoutMs += elapsedMs;
+                _stats.maxColdHandoutMs = std::max(_stats.maxColdHandoutMs, elapsedMs);
+            }
+        }
+
+        /**
+         * Refill thread: replaces the expired sessions and creates the missing ones, one at a time.
+         */
+        void run()
+        {
+            std::vector<ReadySession> retired;
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stopping)
+            {
+                const auto now = Clock::now();
+                auto wakeAt = Clock::time_point::max();
+                Config *missing = nullptr;
+                for (auto &entry : _configs)
+                {
+                    Config &config = entry.second;
+                    auto &ready = config.ready;
+                    for (auto it = ready.begin(); it != ready.end();)
+                    {
+                        if (isUsable(*it, now))
+                        {
+                            wakeAt = std::min(wakeAt, it->connectedAt + _options.maxIdle);
+                            ++it;
+                            continue;
+                        }
+                        retired.push_back(std::move(*it));
+                        it = ready.erase(it);
+                        ++_stats.expiredSessions;
+                    }
+                    if (ready.size() + config.pending < _options.sessionsPerConfig)
+                    {
+                        if (config.retryAt <= now)
+                        {
+                            missing = missing != nullptr ? missing : &config;
+                        }
+                        else
+                        {
+                            wakeAt = std::min(wakeAt, config.retryAt);
+                        }
+                    }
+                }
+
+                if (!retired.empty())
+                {
+                    // stopping a session writes to its socket, not under the lock
+                    lock.unlock();
+                    retired.clear();
+                    lock.lock();
+                    continue;
+                }
+                if (missing != nullptr)
+                {
+                    refill(*missing, lock);
+                    continue;
+                }
+                // woken early by prewarm(), acquire() and the destructor
+                if (wakeAt == Clock::time_point::max())
+                {
+                    _condition.wait(lock);
+                }
+                else
+                {
+                    _condition.wait_until(lock, wakeAt);
+                }
+            }
+        }
+
+        /**
+         * Creates one session for the configuration, the lock being released meanwhile.
+         * Configurations are never erased, so the reference stays valid.
+         */
+        void refill(Config &config, std::unique_lock<std::mutex> &lock)
+        {
+            ++config.pending;
+            const request::InitializeSessionRequest initRequest = config.request;
+            lock.unlock();
+            auto open = std::make_shared<std::atomic<bool>>(true);
+            auto session = createSession(initRequest, nullptr, open);
+            const auto connectedAt = Clock::now();
+            lock.lock();
+            --config.pending;
+            if (session == nullptr)
+            {
+                spdlog::warn("Live session pool: session creation failed, retrying in {} ms.", _options.retryDelay.count());
+                ++_stats.failedRefills;
+                config.retryAt = connectedAt + _options.retryDelay;
+                return;
+            }
+            config.ready.push_back(ReadySession{std::move(session), connectedAt, std::move(open)});
+        }
+
+    private:
+        const GladiaWebsocketClient &_client;
+        LiveSessionPoolOptions _options;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _stopping = false;
+        std::map<std::string, Config> _configs;
+        std::thread _refillThread;
+
+        LiveSessionPoolStats _stats;
+        double _totalWarmHandoutMs = 0.0;
+        double _totalColdHandoutMs = 0.0;
+    };
+}
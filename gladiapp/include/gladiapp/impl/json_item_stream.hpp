@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace gladiapp::v2::json_util
+{
+    /**
+     * Push tokenizer splitting the elements of one top-level array out of a JSON object as its bytes arrive,
+     * e.g. the "items" of a results page. Each complete element is handed to the callback on its own, the
+     * rest of the document is kept with the array left empty (remainder()), so the whole body is never held.
+     * Only the structure is tracked (nesting, strings, escapes); elements are validated by whoever parses them.
+     */
+    class ArrayItemSplitter
+    {
+    public:
+        // returning false stops the stream, feed() then fails
+        using ItemCallback = std::function<bool(std::string &element)>;
+
+        ArrayItemSplitter(std::string arrayKey, ItemCallback onItem)
+            : _arrayKey(std::move(arrayKey)), _onItem(std::move(onItem))
+        {
+        }
+
+        /**
+         * Consumes the next chunk of the document.
+         * @return false once the callback rejected an element or the document is not an object.
+         */
+        bool feed(const char *data, std::size_t size)
+        {
+            for (std::size_t i = 0; i < size && !_failed; ++i)
+            {
+                consume(data[i]);
+            }
+            return !_failed;
+        }
+
+        /**
+         * True if a complete top-level object was consumed.
+         */
+        bool finish() const
+        {
+            return !_failed && _started && _depth == 0 && !_inArray;
+        }
+
+        const std::string &remainder() const
+        {
+            return _remainder;
+        }
+
+        std::size_t elementCount() const
+        {
+            return _elementCount;
+        }
+
+    private:
+        void consume(char c)
+        {
+            if (_inArray && (_elementDepth > 0 || _inElementPrimitive || startsElement(c)))
+            {
+                consumeElement(c);
+                return;
+            }
+
+            if (_inString)
+            {
+                _remainder.push_back(c);
+                if (_escaped)
+                {
+                    _escaped = false;
+                }
+                else if (c == '\\')
+                {
+                    _escaped = true;
+                }
+                else if (c == '"')
+                {
+                    _inString = false;
+                    if (_depth == 1)
+                    {
+                        _lastString = std::move(_stringBuffer);
+                    }
+                    _stringBuffer.clear();
+                    return;
+                }
+                if (_depth == 1 && _stringBuffer.size() <= _arrayKey.size())
+                {
+                    _stringBuffer.push_back(c);
+                }
+                return;
+            }
+
+            if (_inArray)
+            {
+                // between elements: separators, whitespace or the closing bracket
+                if (c == ']')
+                {
+                    _inArray = false;
+                    --_depth;
+                    _remainder.push_back(c);
+                }
+                return;
+            }
+
+            _remainder.push_back(c);
+            switch (c)
+            {
+            case '"':
+                _inString = true;
+                _stringBuffer.clear();
+                break;
+            case ':':
+                if (_depth == 1)
+                {
+                    _currentKey = _lastString;
+                }
+                break;
+            case ',':
+                if (_depth == 1)
+                {
+                    _currentKey.clear();
+                }
+                break;
+            case '{':
+                if (!_started)
+                {
+                    _started = true;
+                }
+                ++_depth;
+                break;
+            case '[':
+                if (!_started)
+                {
+                    _failed = true;
+                    break;
+                }
+                ++_depth;
+                if (_depth == 2 && _currentKey == _arrayKey)
+                {
+                    _inArray = true;
+                }
+                break;
+            case '}':
+            case ']':
+                --_depth;
+                break;
+            default:
+                if (!_started && !isSpace(c))
+                {
+                    _failed = true;
+                }
+                break;
+            }
+        }
+
+        void consumeElement(char c)
+        {
+            if (_elementDepth == 0 && !_inElementPrimitive)
+            {
+                if (c == '{' || c == '[')
+                {
+                    _elementDepth = 1;
+                }
+                else
+                {
+                    _inElementPrimitive = true;
+                    _elementInString = c == '"';
+                }
+                _element.push_back(c);
+                return;
+            }
+
+            if (_inElementPrimitive)
+            {
+                if (_elementInString)
+                {
+                    _element.push_back(c);
+                    if (_elementEscaped)
+                    {
+                        _elementEscaped = false;
+                    }
+                    else if (c == '\\')
+                    {
+                        _elementEscaped = true;
+                    }
+                    else if (c == '"')
+                    {
+                        _elementInString = false;
+                    }
+                    return;
+                }
+                if (c == ',' || c == ']' || isSpace(c))
+                {
+                    _inElementPrimitive = false;
+                    emitElement();
+                    // the separator or closing bracket is handled like any between-element character
+                    consume(c);
+                    return;
+                }
+                _element.push_back(c);
+                return;
+            }
+
+            _element.push_back(c);
+            if (_elementInString)
+            {
+                if (_elementEscaped)
+                {
+                    _elementEscaped = false;
+                }
+                else if (c == '\\')
+                {
+                    _elementEscaped = true;
+                }
+                else if (c == '"')
+                {
+                    _elementInString = false;
+                }
+                return;
+            }
+            switch (c)
+            {
+            case '"':
+                _elementInString = true;
+                break;
+            case '{':
+            case '[':
+                ++_elementDepth;
+                break;
+            case '}':
+            case ']':
+                if (--_elementDepth == 0)
+                {
+                    emitElement();
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        void emitElement()
+        {
+            ++_elementCount;
+            if (!_onItem(_element))
+            {
+                _failed = true;
+            }
+            _element.clear();
+        }
+
+        static bool startsElement(char c)
+        {
+            return !isSpace(c) && c != ',' && c != ']';
+        }
+
+        static bool isSpace(char c)
+        {
+            return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+        }
+
+    private:
+        std::string _arrayKey;
+        ItemCallback _onItem;
+
+        // document outside the array elements
+        std::string _remainder;
+        int _depth = 0;
+        bool _started = false;
+        bool _failed = false;
+        bool _inString = false;
+        bool _escaped = false;
+        std::string _stringBuffer;
+        std::string _lastString;
+        std::string _currentKey;
+
+        // current array element
+        bool _inArray = false;
+        std::string _element;
+        int _elementDepth = 0;
+        bool _inElementPrimitive = false;
+        bool _elementInString = false;
+        bool _elementEscaped = false;
+        std::size_t _elementCount = 0;
+    };
+}
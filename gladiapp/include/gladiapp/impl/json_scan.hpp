@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace gladiapp::v2::json_util
+{
+    /**
+     * Minimal structural scanner reading one top-level string field of a JSON object without building a DOM,
+     * e.g. the "type" of a live message. Values of the other fields are skipped, not validated.
+     */
+    class TopLevelScanner
+    {
+    public:
+        explicit TopLevelScanner(std::string_view document)
+            : _document(document)
+        {
+        }
+
+        /**
+         * @return false if the field is missing, is not a plain string (escapes included) or the document
+         *         is not an object, callers then fall back to a full parse.
+         */
+        bool findString(std::string_view key, std::string_view &value)
+        {
+            _position = 0;
+            skipSpaces();
+            if (!consume('{'))
+            {
+                return false;
+            }
+            for (;;)
+            {
+                skipSpaces();
+                std::string_view fieldName;
+                bool plainName = false;
+                if (!readString(fieldName, plainName))
+                {
+                    return false;
+                }
+                skipSpaces();
+                if (!consume(':'))
+                {
+                    return false;
+                }
+                skipSpaces();
+                if (plainName && fieldName == key)
+                {
+                    bool plainValue = false;
+                    return peek() == '"' && readString(value, plainValue) && plainValue;
+                }
+                if (!skipValue())
+                {
+                    return false;
+                }
+                skipSpaces();
+                if (!consume(','))
+                {
+                    // '}' or garbage, the field is not there either way
+                    return false;
+                }
+            }
+        }
+
+    private:
+        char peek() const
+        {
+            return _position < _document.size() ? _document[_position] : '\0';
+        }
+
+        bool consume(char expected)
+        {
+            if (peek() != expected)
+            {
+                return false;
+            }
+            ++_position;
+            return true;
+        }
+
+        void skipSpaces()
+        {
+            while (_position < _document.size() &&
+                   (_document[_position] == ' ' || _document[_position] == '\n' ||
+                    _document[_position] == '\r' || _document[_position] == '\t'))
+            {
+                ++_position;
+            }
+        }
+
+        /**
+         * Reads a string token, plain is false when it holds escapes (the view is then the raw text).
+         */
+        bool readString(std::string_view &text, bool &plain)
+        {
+            if (!consume('"'))
+            {
+                return false;
+            }
+            std::size_t start = _position;
+            plain = true;
+            while (_position < _document.size())
+            {
+                char c = _document[_position];
+                if (c == '\\')
+                {
+                    plain = false;
+                    _position += 2;
+                    continue;
+                }
+                if (c == '"')
+                {
+                    text = _document.substr(start, _position - start);
+                    ++_position;
+                    return true;
+                }
+                ++_position;
+            }
+            return false;
+        }
+
+        bool skipValue()
+        {
+            int depth = 0;
+            while (_position < _document.size())
+            {
+                char c = _document[_position];
+                if (c == '"')
+                {
+                    std::string_view ignored;
+                    bool plain = false;
+                    if (!readString(ignored, plain))
+                    {
+                        return false;
+                    }
+                    if (depth == 0)
+                    {
+                        return true;
+                    }
+                    continue;
+                }
+                if (c == '{' || c == '[')
+                {
+                    ++depth;
+                }
+                else if (c == '}' || c == ']')
+                {
+                    if (depth == 0)
+                    {
+                        // end of the enclosing object, the primitive before it is done
+                        return true;
+                    }
+                    if (--depth == 0)
+                    {
+                        ++_position;
+                        return true;
+                    }
+                }
+                else if (c == ',' && depth == 0)
+                {
+                    return true;
+                }
+                ++_position;
+            }
+            return false;
+        }
+
+    private:
+        std::string_view _document;
+        std::size_t _position = 0;
+    };
+}
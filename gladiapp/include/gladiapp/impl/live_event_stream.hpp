@@ -0,0 +1,229 @@
+#pragma once
+
+#include "../gladiapp_ws.hpp"
+#include "mpmc_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace gladiapp::v2::ws
+{
+    /**
+     * Events of a session waiting to be polled. The thread dispatching the session's messages pushes into a
+     * lock-free queue and consumers pop from it; either side only takes a lock to wake the other when it is
+     * asleep, or to wait for a free slot with the BLOCK policy. A consumer may also leave a handoff, which the
+     * next push calls with the oldest event instead of waking anyone.
+     */
+    class LiveEventStream
+    {
+    public:
+        using Handoff = std::function<void(LiveEvent &&event)>;
+
+        explicit LiveEventStream(const EventStreamOptions &options)
+            : _options(options), _queue(options.capacity)
+        {
+        }
+
+        ~LiveEventStream()
+        {
+            close();
+        }
+
+        /**
+         * Queues an event according to the overflow policy. Connection events always wait for a slot.
+         * @return false once the stream is closed.
+         */
+        bool push(LiveEvent &&event, bool control = false)
+        {
+            auto policy = control ? EventStreamOptions::OverflowPolicy::BLOCK : _options.overflowPolicy;
+            while (!_closed && !_queue.tryPush(std::move(event)))
+            {
+                if (policy == EventStreamOptions::OverflowPolicy::DROP_OLDEST)
+                {
+                    LiveEvent oldest;
+                    if (_queue.tryPop(oldest))
+                    {
+                        ++_droppedEvents;
+                    }
+                    continue;
+                }
+                waitForSpace();
+            }
+            if (_closed)
+            {
+                return false;
+            }
+            ++_queuedEvents;
+            // paired with the check in takeNext(): either we see its handoff or it sees our event
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_handoffsWaiting != 0)
+            {
+                handOff();
+            }
+            notifyConsumers();
+            return true;
+        }
+
+        /**
+         * Calls onEvent with the oldest queued event, right away if there is one, otherwise from the next push.
+         * Once the stream is closed and drained it receives a DISCONNECTED connection event instead.
+         */
+        void takeNext(Handoff onEvent)
+        {
+            LiveEvent event;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                const bool queued = _queue.tryPop(event);
+                if (!queued && _closed)
+                {
+                    event = ConnectionEvent{ConnectionEvent::Kind::DISCONNECTED, "event stream closed"};
+                }
+                else if (!queued)
+                {
+                    _handoffs.push_back(std::move(onEvent));
+                    _handoffsWaiting = static_cast<int>(_handoffs.size());
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    // an event pushed before the producer could see the handoff
+                    if (!_queue.tryPop(event))
+                    {
+                        return;
+                    }
+                    onEvent = std::move(_handoffs.front());
+                    _handoffs.pop_front();
+                    _handoffsWaiting = static_cast<int>(_handoffs.size());
+                }
+            }
+            notifySpace();
+            onEvent(std::move(event));
+        }
+
+        std::size_t poll(LiveEvent *events, std::size_t maxEvents)
+        {
+            std::size_t count = 0;
+            while (count < maxEvents && _queue.tryPop(events[count]))
+            {
+                ++count;
+            }
+            if (count != 0)
+            {
+                notifySpace();
+            }
+            return count;
+        }
+
+        bool waitFor(std::chrono::milliseconds timeout)
+        {
+            if (_queue.sizeApprox() != 0)
+            {
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(_mutex);
+            ++_consumersWaiting;
+            // paired with the check in notifyConsumers(): either the producer sees the count or we see its event
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool ready = _eventCondition.wait_for(lock, timeout, [this]()
+                                                  { return _closed || _queue.sizeApprox() != 0; });
+            --_consumersWaiting;
+            return ready && _queue.sizeApprox() != 0;
+        }
+
+        /**
+         * Wakes the producers and the consumers, later events are refused. Queued ones can still be polled.
+         */
+        void close()
+        {
+            std::deque<Handoff> handoffs;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _closed = true;
+                handoffs.swap(_handoffs);
+                _handoffsWaiting = 0;
+            }
+            _eventCondition.notify_all();
+            _spaceCondition.notify_all();
+            // the handoffs only wait when the queue is empty
+            for (auto &onEvent : handoffs)
+            {
+                onEvent(ConnectionEvent{ConnectionEvent::Kind::DISCONNECTED, "event stream closed"});
+            }
+        }
+
+        EventStreamStats stats() const
+        {
+            EventStreamStats stats;
+            stats.depth = _queue.sizeApprox();
+            stats.queuedEvents = _queuedEvents;
+            stats.droppedEvents = _droppedEvents;
+            return stats;
+        }
+
+    private:
+        void handOff()
+        {
+            LiveEvent event;
+            Handoff onEvent;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                // another consumer may have polled the event meanwhile, the handoff then waits for the next one
+                if (_handoffs.empty() || !_queue.tryPop(event))
+                {
+                    return;
+                }
+                onEvent = std::move(_handoffs.front());
+                _handoffs.pop_front();
+                _handoffsWaiting = static_cast<int>(_handoffs.size());
+            }
+            notifySpace();
+            onEvent(std::move(event));
+        }
+
+        void notifyConsumers()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_consumersWaiting != 0)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _eventCondition.notify_all();
+            }
+        }
+
+        void waitForSpace()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            ++_producersWaiting;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            _spaceCondition.wait(lock, [this]()
+                                 { return _closed || _queue.sizeApprox() < _queue.capacity(); });
+            --_producersWaiting;
+        }
+
+        void notifySpace()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_producersWaiting != 0)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _spaceCondition.notify_all();
+            }
+        }
+
+    private:
+        const EventStreamOptions _options;
+        concurrent_util::BoundedMpmcQueue<LiveEvent> _queue;
+
+        std::mutex _mutex;
+        std::condition_variable _eventCondition;
+        std::condition_variable _spaceCondition;
+        std::atomic<bool> _closed{false};
+        std::atomic<int> _consumersWaiting{0};
+        std::atomic<int> _producersWaiting{0};
+        std::deque<Handoff> _handoffs;
+        std::atomic<int> _handoffsWaiting{0};
+
+        std::atomic<std::uint64_t> _queuedEvents{0};
+        std::atomic<std::uint64_t> _droppedEvents{0};
+    };
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace gladiapp::v2::concurrent_util
+{
+    /**
+     * Bounded lock-free multi-producer/multi-consumer queue (Dmitry Vyukov's array queue).
+     * Each cell carries a sequence number telling producers and consumers whose turn it is,
+     * so a push or a pop is a single compare-and-swap on the shared position plus one cell store.
+     */
+    template <typename T>
+    class BoundedMpmcQueue
+    {
+    public:
+        /**
+         * @param capacity Raised to 2: with a single cell, a filled cell and a freed one carry the same
+         * sequence number, and a second push would overwrite the first value.
+         */
+        explicit BoundedMpmcQueue(std::size_t capacity)
+            : _capacity(std::max<std::size_t>(capacity, 2)), _cells(std::make_unique<Cell[]>(_capacity))
+        {
+            for (std::size_t i = 0; i < _capacity; ++i)
+            {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        BoundedMpmcQueue(const BoundedMpmcQueue &) = delete;
+        BoundedMpmcQueue &operator=(const BoundedMpmcQueue &) = delete;
+
+        /**
+         * @return false if the queue is full, value is left untouched then.
+         */
+        bool tryPush(T &&value)
+        {
+            std::size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = _cells[position % _capacity];
+                std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+                if (difference == 0)
+                {
+                    if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = std::move(value);
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = _enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @return false if the queue is empty.
+         */
+        bool tryPop(T &value)
+        {
+            std::size_t position = _dequeuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = _cells[position % _capacity];
+                std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+                if (difference == 0)
+                {
+                    if (_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        value = std::move(cell.value);
+                        cell.sequence.store(position + _capacity, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = _dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Number of queued elements, exact only when no push or pop is in progress.
+         */
+        std::size_t sizeApprox() const
+        {
+            std::size_t dequeued = _dequeuePosition.load(std::memory_order_acquire);
+            std::size_t enqueued = _enqueuePosition.load(std::memory_order_acquire);
+            return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+
+        std::size_t capacity() const
+        {
+            return _capacity;
+        }
+
+    private:
+        static constexpr std::size_t CACHE_LINE = 64;
+
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence{0};
+            T value{};
+        };
+
+        const std::size_t _capacity;
+        std::unique_ptr<Cell[]> _cells;
+        // producers and consumers each hammer their own position, keep them on separate cache lines
+        alignas(CACHE_LINE) std::atomic<std::size_t> _enqueuePosition{0};
+        alignas(CACHE_LINE) std::atomic<std::size_t> _dequeuePosition{0};
+    };
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+#ifdef GLADIAPP_USE_SIMDJSON
+
+#include "../gladiapp_rest_response.hpp"
+#include "../gladiapp_ws_response.hpp"
+#include <simdjson.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gladiapp::v2::simdjson_util
+{
+    /**
+     * simdjson on-demand fast path for large transcription results.
+     * Only the utterance arrays, which hold nearly all the bytes of a long transcript, are decoded here;
+     * every other field is handed over as raw JSON to the regular nlohmann fromJson so both backends
+     * fill the structs the same way. Any failure makes the callers fall back to nlohmann alone.
+     */
+    namespace ondemand = simdjson::ondemand;
+
+    inline ondemand::parser &threadParser()
+    {
+        thread_local ondemand::parser parser;
+        return parser;
+    }
+
+    /**
+     * Copies the fields of an object into rest, except those the handler consumes (returns true for).
+     */
+    template <typename Handler>
+    void splitObject(ondemand::object object, nlohmann::json &rest, Handler &&handler)
+    {
+        rest = nlohmann::json::object();
+        for (auto field : object)
+        {
+            std::string key(field.unescaped_key().value());
+            ondemand::value value = field.value();
+            if (!handler(key, value))
+            {
+                rest[key] = nlohmann::json::parse(value.raw_json().value());
+            }
+        }
+    }
+
+    inline bool isType(ondemand::value &value, ondemand::json_type type)
+    {
+        return value.type().value() == type;
+    }
+
+    template <typename Word>
+    Word parseWord(ondemand::object object, bool strict)
+    {
+        Word word{};
+        unsigned seen = 0;
+        for (auto field : object)
+        {
+            std::string_view key = field.unescaped_key().value();
+            if (key == "word")
+            {
+                word.word = std::string(field.value().get_string().value());
+                seen |= 1;
+            }
+            else if (key == "start")
+            {
+                word.start = field.value().get_double();
+                seen |= 2;
+            }
+            else if (key == "end")
+            {
+                word.end = field.value().get_double();
+                seen |= 4;
+            }
+            else if (key == "confidence")
+            {
+                word.confidence = field.value().get_double();
+                seen |= 8;
+            }
+        }
+        if (strict && seen != 15)
+        {
+            throw std::runtime_error("word is missing a required field");
+        }
+        return word;
+    }
+
+    /**
+     * Fills a vector of REST (lenient, missing fields default) or live (strict, missing fields throw) utterances.
+     */
+    template <typename Utterance>
+    void parseUtterances(ondemand::array array, std::vector<Utterance> &utterances, bool strict)
+    {
+        using Word = typename decltype(Utterance::words)::value_type;
+        for (auto element : array)
+        {
+            Utterance utterance{};
+            unsigned seen = 0;
+            for (auto field : element.get_object())
+            {
+                std::string_view key = field.unescaped_key().value();
+                ondemand::value value = field.value();
+                if (key == "language")
+                {
+                    utterance.language = std::string(value.get_string().value());
+                    seen |= 1;
+                }
+                else if (key == "start")
+                {
+                    utterance.start = value.get_double();
+                    seen |= 2;
+                }
+                else if (key == "end")
+                {
+                    utterance.end = value.get_double();
+                    seen |= 4;
+                }
+                else if (key == "confidence")
+                {
+                    utterance.confidence = value.get_double();
+                    seen |= 8;
+                }
+                else if (key == "channel")
+                {
+                    utterance.channel = static_cast<int>(value.get_int64().value());
+                    seen |= 16;
+                }
+                else if (key == "text")
+                {
+                    utterance.text = std::string(value.get_string().value());
+                    seen |= 32;
+                }
+                else if (key == "words")
+                {
+                    for (auto word : value.get_array())
+                    {
+                        utterance.words.push_back(parseWord<Word>(word.get_object(), strict));
+                    }
+                    seen |= 64;
+                }
+                else if (key == "speaker")
+                {
+                    utterance.speaker = static_cast<int>(value.get_int64().value());
+                }
+            }
+            if (strict && seen != 127)
+            {
+                throw std::runtime_error("utterance is missing a required field");
+            }
+            utterances.push_back(std::move(utterance));
+        }
+    }
+
+    /**
+     * Splits {"result": {"transcription": {"utterances": [...]}}} out of a result object.
+     * @return true if the utterances were found and decoded.
+     */
+    template <typename Utterance>
+    bool splitResultObject(ondemand::object object, nlohmann::json &rest, std::vector<Utterance> &utterances, bool strict)
+    {
+        bool found = false;
+        splitObject(object, rest, [&](const std::string &key, ondemand::value &value)
+                    {
+            if (key != "result" || !isType(value, ondemand::json_type::object))
+            {
+                return false;
+            }
+            nlohmann::json resultRest;
+            splitObject(value.get_object(), resultRest, [&](const std::string &resultKey, ondemand::value &resultValue)
+                        {
+                if (resultKey != "transcription" || !isType(resultValue, ondemand::json_type::object))
+                {
+                    return false;
+                }
+                nlohmann::json transcriptionRest;
+                splitObject(resultValue.get_object(), transcriptionRest, [&](const std::string &transcriptionKey, ondemand::value &transcriptionValue)
+                            {
+                    if (transcriptionKey != "utterances" || !isType(transcriptionValue, ondemand::json_type::array))
+                    {
+                        return false;
+                    }
+                    parseUtterances(transcriptionValue.get_array(), utterances, strict);
+                    found = true;
+                    return true; });
+                resultRest["transcription"] = std::move(transcriptionRest);
+                return true; });
+            rest["result"] = std::move(resultRest);
+            return true; });
+        return found;
+    }
+
+    inline response::TranscriptionResult parseTranscriptionResult(ondemand::object object)
+    {
+        nlohmann::json rest;
+        std::vector<response::TranscriptionResult::TranscriptionObject::Result::Utterance> utterances;
+        bool found = splitResultObject(object, rest, utterances, false);
+        auto result = response::TranscriptionResult::fromJsonDocument(rest);
+        if (found)
+        {
+            result.result.result.utterances = std::move(utterances);
+        }
+        return result;
+    }
+
+    inline bool parse(const std::string &jsonString, response::TranscriptionResult &result)
+    {
+        try
+        {
+            simdjson::padded_string padded(jsonString);
+            ondemand::document document = threadParser().iterate(padded);
+            result = parseTranscriptionResult(document.get_object());
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::debug("simdjson parsing failed, falling back to nlohmann: {}", e.what());
+        }
+        return false;
+    }
+
+    inline bool parse(const std::string &jsonString, response::TranscriptionListResults &results)
+    {
+        try
+        {
+            simdjson::padded_string padded(jsonString);
+            ondemand::document document = threadParser().iterate(padded);
+            nlohmann::json rest;
+            std::vector<response::TranscriptionResult> items;
+            bool found = false;
+            splitObject(document.get_object(), rest, [&](const std::string &key, ondemand::value &value)
+                        {
+                if (key != "items" || !isType(value, ondemand::json_type::array))
+                {
+                    return false;
+                }
+                for (auto item : value.get_array())
+                {
+                    items.push_back(parseTranscriptionResult(item.get_object()));
+                }
+                found = true;
+                return true; });
+            results = response::TranscriptionListResults::fromJsonDocument(rest);
+            if (found)
+            {
+                results.items = std::move(items);
+            }
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::debug("simdjson parsing failed, falling back to nlohmann: {}", e.what());
+        }
+        return false;
+    }
+
+    inline bool parse(const std::string &jsonString, ws::response::LiveTranscriptionResult &result)
+    {
+        try
+        {
+            simdjson::padded_string padded(jsonString);
+            ondemand::document document = threadParser().iterate(padded);
+            nlohmann::json rest;
+            std::vector<ws::response::Utterance> utterances;
+            bool found = splitResultObject(document.get_object(), rest, utterances, true);
+            result = ws::response::LiveTranscriptionResult::fromJson(rest);
+            if (found && result.result.transcription.has_value())
+            {
+                result.result.transcription->utterances = std::move(utterances);
+            }
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::debug("simdjson parsing failed, falling back to nlohmann: {}", e.what());
+        }
+        return false;
+    }
+}
+
+#endif
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace gladiapp::v2::ws
+{
+    /**
+     * Hashed timing wheel running the timers of every live session of the process on a single thread,
+     * e.g. the ticks of the audio pacers. Deadlines are rounded up to the next millisecond tick, and the
+     * thread sleeps until the next occupied slot rather than waking on every tick.
+     * Tasks run on the wheel thread and must stay short, a slow task delays all the other timers.
+     */
+    class TimerWheel
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TimerId = std::uint64_t;
+        using Task = std::function<void()>;
+
+        static constexpr Clock::duration TICK = std::chrono::milliseconds(1);
+        static constexpr std::size_t SLOT_COUNT = 1024;
+
+        /**
+         * Wheel shared by the process, started on first use. It lives until exit so that no task can
+         * ever release it from its own thread.
+         */
+        static std::shared_ptr<TimerWheel> shared()
+        {
+            static const std::shared_ptr<TimerWheel> instance = std::make_shared<TimerWheel>();
+            return instance;
+        }
+
+        TimerWheel()
+            : _origin(Clock::now()), _slots(SLOT_COUNT)
+        {
+            _thread = std::thread([this]()
+                                  { run(); });
+        }
+
+        ~TimerWheel()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _running = false;
+            }
+            _wakeUp.notify_all();
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+        }
+
+        /**
+         * Runs the task at the first tick at or after the deadline, right away for a past deadline.
+         * @return id to cancel the timer with.
+         */
+        TimerId schedule(Clock::time_point deadline, Task task)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_timerCount == 0)
+            {
+                // the wheel stopped turning while empty, catch up with the clock
+                _currentTick = std::max(_currentTick, elapsedTicks(Clock::now()));
+            }
+            std::uint64_t tick = std::max(tickAt(deadline), _currentTick);
+            std::size_t slot = static_cast<std::size_t>(tick % SLOT_COUNT);
+            TimerId id = ++_lastId;
+            _slots[slot].push_back(Timer{id, (tick - _currentTick) / SLOT_COUNT, std::move(task)});
+            _slotOf[id] = slot;
+            ++_timerCount;
+            bool earlier = tick < _nextWakeTick;
+            lock.unlock();
+            if (earlier)
+            {
+                _wakeUp.notify_one();
+            }
+            return id;
+        }
+
+        /**
+         * @return false if the timer already ran, is running or was cancelled.
+         */
+        bool cancel(TimerId id)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto entry = _slotOf.find(id);
+            if (entry == _slotOf.end())
+            {
+                return false;
+            }
+            auto &slot = _slots[entry->second];
+            for (std::size_t i = 0; i < slot.size(); ++i)
+            {
+                if (slot[i].id == id)
+                {
+                    slot[i] = std::move(slot.back());
+                    slot.pop_back();
+                    break;
+                }
+            }
+            _slotOf.erase(entry);
+            --_timerCount;
+            return true;
+        }
+
+        std::size_t pending() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _timerCount;
+        }
+
+        /**
+         * True when called from a timer task, which must hand slow work (e.g. socket writes) to another thread.
+         */
+        static bool onWheelThread()
+        {
+            return wheelThreadFlag();
+        }
+
+    private:
+        static bool &wheelThreadFlag()
+        {
+            thread_local bool onWheel = false;
+            return onWheel;
+        }
+
+        struct Timer
+        {
+            TimerId id;
+            // full turns of the wheel left before the timer is due
+            std::uint64_t rounds;
+            Task task;
+        };
+
+        /**
+         * Tick of a deadline, rounded up so that a timer never fires early.
+         */
+        std::uint64_t tickAt(Clock::time_point time) const
+        {
+            if (time <= _origin)
+            {
+                return 0;
+            }
+            return static_cast<std::uint64_t>((time - _origin + TICK - Clock::duration(1)) / TICK);
+        }
+
+        /**
+         * Last tick reached at a time.
+         */
+        std::uint64_t elapsedTicks(Clock::time_point time) const
+        {
+            return time <= _origin ? 0 : static_cast<std::uint64_t>((time - _origin) / TICK);
+        }
+
+        /**
+         * First tick with a timer in its slot, at most a full turn ahead.
+         */
+        std::uint64_t nextOccupiedTick() const
+        {
+            for (std::uint64_t tick = _currentTick; tick < _currentTick + SLOT_COUNT; ++tick)
+            {
+                if (!_slots[tick % SLOT_COUNT].empty())
+                {
+                    return tick;
+                }
+            }
+            return _currentTick + SLOT_COUNT;
+        }
+
+        void run()
+        {
+            wheelThreadFlag() = true;
+            std::vector<Task> due;
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (_running)
+            {
+                if (_timerCount == 0)
+                {
+                    _nextWakeTick = UINT64_MAX;
+                    _wakeUp.wait(lock, [this]()
+                                 { return !_running || _timerCount > 0; });
+                    continue;
+                }
+                _nextWakeTick = nextOccupiedTick();
+                // woken early by a timer scheduled ahead of the awaited slot
+                _wakeUp.wait_until(lock, _origin + _nextWakeTick * TICK, [this]()
+                                   { return !_running || elapsedTicks(Clock::now()) >= _nextWakeTick ||
+                                            nextOccupiedTick() < _nextWakeTick; });
+                if (!_running)
+                {
+                    break;
+                }
+
+                // turn the wheel up to the current time
+                const std::uint64_t now = elapsedTicks(Clock::now());
+                while (_currentTick <= now && _timerCount > 0)
+                {
+                    auto &slot = _slots[_currentTick % SLOT_COUNT];
+                    for (std::size_t i = 0; i < slot.size();)
+                    {
+                        if (slot[i].rounds > 0)
+                        {
+                            --slot[i].rounds;
+                            ++i;
+                            continue;
+                        }
+                        _slotOf.erase(slot[i].id);
+                        due.push_back(std::move(slot[i].task));
+                        slot[i] = std::move(slot.back());
+                        slot.pop_back();
+                        --_timerCount;
+                    }
+                    ++_currentTick;
+                }
+                if (due.empty())
+                {
+                    continue;
+                }
+
+                lock.unlock();
+                for (auto &task : due)
+                {
+                    try
+                    {
+                        task();
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::error("Error in timer task: {}", e.what());
+                    }
+                }
+                due.clear();
+                lock.lock();
+            }
+        }
+
+    private:
+        const Clock::time_point _origin;
+        mutable std::mutex _mutex;
+        std::condition_variable _wakeUp;
+        std::vector<std::vector<Timer>> _slots;
+        std::unordered_map<TimerId, std::size_t> _slotOf;
+        std::size_t _timerCount = 0;
+        TimerId _lastId = 0;
+        // next tick the wheel has not processed yet
+        std::uint64_t _currentTick = 0;
+        std::uint64_t _nextWakeTick = UINT64_MAX;
+        bool _running = true;
+        std::thread _thread;
+    };
+}
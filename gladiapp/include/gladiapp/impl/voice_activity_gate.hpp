@@ -0,0 +1,300 @@
+#pragma once
+
+#include "../gladiapp_ws.hpp"
+#include "frame_energy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace gladiapp::v2::ws
+{
+    /**
+     * Withholds the silent frames of a session's audio stream, see VoiceActivityGateOptions.
+     * The frames kept are handed to an emit function in stream order, as ranges of the input chunk
+     * when they are contiguous in it.
+     */
+    class VoiceActivityGate
+    {
+    public:
+        VoiceActivityGate(const VoiceActivityGateOptions &options, const audio::AudioFormat &format)
+            : _format(format)
+        {
+            const std::size_t blockAlign = format.bytesPerSample() * static_cast<std::size_t>(std::max(format.channels, 1));
+            _bytesPerSecond = static_cast<std::size_t>(format.sampleRate) * blockAlign;
+            _frameBytes = std::max<std::size_t>(_bytesPerSecond / 100 / blockAlign, 1) * blockAlign;
+            _preRollBytes = bytesFor(options.preRollMs);
+            _hangoverBytes = bytesFor(options.hangoverMs);
+            _keepAliveBytes = bytesFor(options.keepAliveMs);
+
+            double thresholdDb = options.thresholdDb != 0.0 ? options.thresholdDb : thresholdFromSpeechThreshold(0.6);
+            double amplitude = 32768.0 * std::pow(10.0, thresholdDb / 20.0);
+            _speechMeanSquare = amplitude * amplitude;
+        }
+
+        /**
+         * Frame level under which the gate drops audio for a server speech_threshold (0 to 1, higher is
+         * stricter): from -70 dBFS at 0 to -40 dBFS at 1, far below speech levels either way.
+         */
+        static double thresholdFromSpeechThreshold(double speechThreshold)
+        {
+            return -70.0 + 30.0 * std::clamp(speechThreshold, 0.0, 1.0);
+        }
+
+        /**
+         * @param emit bool(const uint8_t *data, std::size_t size), returning false if the audio could not be sent.
+         * @return false if an emit failed.
+         */
+        template <typename Emit>
+        bool process(const uint8_t *data, std::size_t size, Emit &&emit)
+        {
+            std::lock_guard<std::mutex> lock(_processMutex);
+            bool sent = true;
+            std::size_t rangeStart = 0;
+            std::size_t rangeEnd = 0;
+            auto flushRange = [&]()
+            {
+                if (rangeEnd > rangeStart)
+                {
+                    sent = emitCounted(data + rangeStart, rangeEnd - rangeStart, emit) && sent;
+                }
+                rangeStart = rangeEnd;
+            };
+
+            for (std::size_t offset = 0; offset < size; offset += _frameBytes)
+            {
+                const std::size_t length = std::min(_frameBytes, size - offset);
+                const uint8_t *frame = data + offset;
+                bool speech = isSpeech(frame, length);
+                if (speech)
+                {
+                    _hangoverLeft = _hangoverBytes;
+                }
+                else if (_hangoverLeft > 0)
+                {
+                    _hangoverLeft -= std::min(_hangoverLeft, length);
+                    speech = true;
+                }
+
+                if (speech)
+                {
+                    if (_silentRunBytes > 0)
+                    {
+                        // speech resumes: the pre-roll goes out first, the rest of the silent run was dropped
+                        commitGap(_silentRunBytes - _preRoll.size());
+                        if (!_preRoll.empty())
+                        {
+                            sent = emitCounted(_preRoll.data(), _preRoll.size(), emit) && sent;
+                            _preRoll.clear();
+                        }
+                        _silentRunBytes = 0;
+                        _sinceKeepAlive = 0;
+                    }
+                    if (rangeEnd != offset)
+                    {
+                        rangeStart = offset;
+                    }
+                    rangeEnd = offset + length;
+                    continue;
+                }
+
+                flushRange();
+                _silentRunBytes += length;
+                _sinceKeepAlive += length;
+                {
+                    std::lock_guard<std::mutex> lock(_timelineMutex);
+                    _pendingBytes = _silentRunBytes;
+                }
+                if (_keepAliveBytes > 0 && _sinceKeepAlive >= _keepAliveBytes)
+                {
+                    commitGap(_silentRunBytes - length);
+                    sent = emitCounted(frame, length, emit) && sent;
+                    _preRoll.clear();
+                    _silentRunBytes = 0;
+                    _sinceKeepAlive = 0;
+                    continue;
+                }
+                _preRoll.insert(_preRoll.end(), frame, frame + length);
+                if (_preRoll.size() > _preRollBytes)
+                {
+                    _preRoll.erase(_preRoll.begin(), _preRoll.begin() + static_cast<std::ptrdiff_t>(_preRoll.size() - _preRollBytes));
+                }
+            }
+            flushRange();
+            return sent;
+        }
+
+        VoiceActivityGateStats stats() const
+        {
+            std::lock_guard<std::mutex> lock(_timelineMutex);
+            VoiceActivityGateStats stats = _stats;
+            // the current silent run is withheld too, even if part of it may still go out as pre-roll
+            stats.suppressedBytes += _pendingBytes;
+            stats.suppressedSeconds = static_cast<double>(stats.suppressedBytes) / static_cast<double>(_bytesPerSecond);
+            return stats;
+        }
+
+        double toCaptureTime(double sessionSeconds) const
+        {
+            std::lock_guard<std::mutex> lock(_timelineMutex);
+            auto gap = std::upper_bound(_gaps.begin(), _gaps.end(), sessionSeconds,
+                                        [](double time, const Gap &entry)
+                                        { return time < entry.sessionTime; });
+            return gap == _gaps.begin() ? sessionSeconds : sessionSeconds + std::prev(gap)->suppressedBefore;
+        }
+
+    private:
+        struct Gap
+        {
+            /** Position in the audio the server received where silence was taken out. */
+            double sessionTime;
+            /** Total silence taken out up to this position. */
+            double suppressedBefore;
+        };
+
+        std::size_t bytesFor(std::size_t milliseconds) const
+        {
+            return milliseconds * _bytesPerSecond / 1000 / _frameBytes * _frameBytes;
+        }
+
+        template <typename Emit>
+        bool emitCounted(const uint8_t *data, std::size_t size, Emit &emit)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_timelineMutex);
+                _stats.sentBytes += size;
+            }
+            return emit(data, size);
+        }
+
+        void commitGap(std::size_t droppedBytes)
+        {
+            std::lock_guard<std::mutex> lock(_timelineMutex);
+            _pendingBytes = 0;
+            if (droppedBytes == 0)
+            {
+                return;
+            }
+            _stats.suppressedBytes += droppedBytes;
+            _suppressedSeconds += static_cast<double>(droppedBytes) / static_cast<double>(_bytesPerSecond);
+            _gaps.push_back({static_cast<double>(_stats.sentBytes) / static_cast<double>(_bytesPerSecond), _suppressedSeconds});
+        }
+
+        bool isSpeech(const uint8_t *frame, std::size_t length)
+        {
+            decodeMono(frame, length);
+            if (_mono.empty())
+            {
+                return true;
+            }
+            audio_util::FrameEnergy energy = audio_util::measureFrame(_mono.data(), _mono.size());
+            const double count = static_cast<double>(_mono.size());
+            const double meanSquare = static_cast<double>(energy.sumSquares) / count;
+            const double crossingRate = count > 1 ? energy.zeroCrossings / (count - 1) : 0.0;
+            // unvoiced consonants are quiet but cross zero often, they get a 10 dB lower threshold
+            return meanSquare >= _speechMeanSquare || (meanSquare >= _speechMeanSquare / 10.0 && crossingRate >= 0.3);
+        }
+
+        /**
+         * Decodes the whole samples of a frame to 16-bit mono.
+         */
+        void decodeMono(const uint8_t *frame, std::size_t length)
+        {
+            const std::size_t channels = static_cast<std::size_t>(std::max(_format.channels, 1));
+            const std::size_t sampleBytes = _format.bytesPerSample();
+            const std::size_t frames = length / (sampleBytes * channels);
+            _mono.resize(frames);
+            for (std::size_t i = 0; i < frames; ++i)
+            {
+                int sum = 0;
+                for (std::size_t channel = 0; channel < channels; ++channel)
+                {
+                    sum += decodeSample(frame + (i * channels + channel) * sampleBytes);
+                }
+                _mono[i] = static_cast<int16_t>(sum / static_cast<int>(channels));
+            }
+        }
+
+        int decodeSample(const uint8_t *sample) const
+        {
+            switch (_format.encoding)
+            {
+            case audio::AudioFormat::Encoding::ALAW:
+                return companding().alaw[*sample];
+            case audio::AudioFormat::Encoding::ULAW:
+                return companding().ulaw[*sample];
+            case audio::AudioFormat::Encoding::PCM:
+                break;
+            }
+            // little-endian, the two most significant bytes are enough for a level
+            switch (_format.bitDepth)
+            {
+            case 8:
+                return (static_cast<int>(sample[0]) - 128) * 256;
+            case 16:
+                return static_cast<int16_t>(sample[0] | (sample[1] << 8));
+            case 24:
+                return static_cast<int16_t>(sample[1] | (sample[2] << 8));
+            default:
+                return static_cast<int16_t>(sample[2] | (sample[3] << 8));
+            }
+        }
+
+        /**
+         * G.711 decoders, tabulated.
+         */
+        struct CompandingTables
+        {
+            std::array<int16_t, 256> alaw;
+            std::array<int16_t, 256> ulaw;
+
+            CompandingTables()
+            {
+                for (int code = 0; code < 256; ++code)
+                {
+                    int a = code ^ 0x55;
+                    int segment = (a & 0x70) >> 4;
+                    int value = (a & 0x0F) << 4;
+                    value = segment == 0 ? value + 8 : (segment == 1 ? value + 0x108 : (value + 0x108) << (segment - 1));
+                    alaw[code] = static_cast<int16_t>((a & 0x80) ? value : -value);
+
+                    int u = ~code & 0xFF;
+                    int magnitude = (((u & 0x0F) << 3) + 0x84) << ((u & 0x70) >> 4);
+                    ulaw[code] = static_cast<int16_t>((u & 0x80) ? 0x84 - magnitude : magnitude - 0x84);
+                }
+            }
+        };
+
+        static const CompandingTables &companding()
+        {
+            static const CompandingTables tables;
+            return tables;
+        }
+
+    private:
+        audio::AudioFormat _format;
+        std::size_t _bytesPerSecond = 0;
+        std::size_t _frameBytes = 0;
+        std::size_t _preRollBytes = 0;
+        std::size_t _hangoverBytes = 0;
+        std::size_t _keepAliveBytes = 0;
+        double _speechMeanSquare = 0.0;
+
+        // stream state, only touched under _processMutex
+        std::mutex _processMutex;
+        std::size_t _hangoverLeft = 0;
+        std::size_t _silentRunBytes = 0;
+        std::size_t _sinceKeepAlive = 0;
+        std::vector<uint8_t> _preRoll;
+        std::vector<int16_t> _mono;
+
+        // read from the callback threads
+        mutable std::mutex _timelineMutex;
+        VoiceActivityGateStats _stats;
+        std::size_t _pendingBytes = 0;
+        double _suppressedSeconds = 0.0;
+        std::vector<Gap> _gaps;
+    };
+}
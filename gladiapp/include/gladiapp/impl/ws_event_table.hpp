@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../gladiapp_ws.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace gladiapp::v2::ws::events
+{
+    /**
+     * Index of a live event type, used to dispatch messages with a switch instead of string compares.
+     */
+    enum class EventType : std::uint8_t
+    {
+        AUDIO_CHUNK,
+        STOP_RECORDING,
+        SPEECH_START,
+        SPEECH_END,
+        TRANSCRIPT,
+        TRANSLATION,
+        NAMED_ENTITY_RECOGNITION,
+        SENTIMENT_ANALYSIS,
+        POST_TRANSCRIPTION,
+        FINAL_TRANSCRIPTION,
+        CHAPTERIZATION,
+        SUMMARIZATION,
+        START_SESSION,
+        END_SESSION,
+        START_RECORDING,
+        END_RECORDING,
+        UNKNOWN
+    };
+
+    struct EventName
+    {
+        std::string_view name;
+        EventType type;
+    };
+
+    /**
+     * Event names sorted for a binary search, checked at compile time below.
+     */
+    constexpr std::array<EventName, 16> EVENT_TABLE = {{
+        {AUDIO_CHUNK, EventType::AUDIO_CHUNK},
+        {END_RECORDING, EventType::END_RECORDING},
+        {END_SESSION, EventType::END_SESSION},
+        {NAMED_ENTITY_RECOGNITION, EventType::NAMED_ENTITY_RECOGNITION},
+        {CHAPTERIZATION, EventType::CHAPTERIZATION},
+        {FINAL_TRANSCRIPTION, EventType::FINAL_TRANSCRIPTION},
+        {SUMMARIZATION, EventType::SUMMARIZATION},
+        {POST_TRANSCRIPTION, EventType::POST_TRANSCRIPTION},
+        {SENTIMENT_ANALYSIS, EventType::SENTIMENT_ANALYSIS},
+        {SPEECH_END, EventType::SPEECH_END},
+        {SPEECH_START, EventType::SPEECH_START},
+        {START_RECORDING, EventType::START_RECORDING},
+        {START_SESSION, EventType::START_SESSION},
+        {STOP_RECORDING, EventType::STOP_RECORDING},
+        {TRANSCRIPT, EventType::TRANSCRIPT},
+        {TRANSLATION, EventType::TRANSLATION},
+    }};
+
+    constexpr bool isSorted(const std::array<EventName, 16> &table)
+    {
+        for (std::size_t i = 1; i < table.size(); ++i)
+        {
+            if (!(table[i - 1].name < table[i].name))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(isSorted(EVENT_TABLE), "EVENT_TABLE must be sorted by name");
+
+    /**
+     * Looks the event type up without allocating, UNKNOWN for names not in the table.
+     */
+    constexpr EventType eventTypeFromName(std::string_view name)
+    {
+        std::size_t low = 0;
+        std::size_t high = EVENT_TABLE.size();
+        while (low < high)
+        {
+            std::size_t middle = low + (high - low) / 2;
+            int order = EVENT_TABLE[middle].name.compare(name);
+            if (order == 0)
+            {
+                return EVENT_TABLE[middle].type;
+            }
+            if (order < 0)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return EventType::UNKNOWN;
+    }
+
+    static_assert(eventTypeFromName(TRANSCRIPT) == EventType::TRANSCRIPT, "event lookup is broken");
+    static_assert(eventTypeFromName("unknown_event") == EventType::UNKNOWN, "event lookup is broken");
+}
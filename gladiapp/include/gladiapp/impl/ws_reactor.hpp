@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace gladiapp::v2::ws
+{
+    /**
+     * Shared epoll reactor serving the sockets of many live sessions from a fixed number of I/O threads.
+     * Sockets are armed one-shot, so a session is only ever drained by one thread at a time and is rearmed
+     * once its handler returns. Only available on Linux, sessions fall back to their own reception thread otherwise.
+     */
+    class WebsocketReactor
+    {
+    public:
+        // drains the readable socket, returning false once the connection is over
+        using ReadableHandler = std::function<bool()>;
+        using RegistrationId = std::uint64_t;
+
+        explicit WebsocketReactor(std::size_t threadCount)
+        {
+#ifdef __linux__
+            _epollFd = epoll_create1(EPOLL_CLOEXEC);
+            _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = WAKE_ID;
+            if (_epollFd < 0 || _wakeFd < 0 || epoll_ctl(_epollFd, EPOLL_CTL_ADD, _wakeFd, &event) != 0)
+            {
+                spdlog::error("WebSocket reactor: epoll setup failed: {}", std::strerror(errno));
+                closeFds();
+                return;
+            }
+            for (std::size_t i = 0; i < std::max<std::size_t>(threadCount, 1); ++i)
+            {
+                _threads.emplace_back([this]()
+                                      { run(); });
+            }
+#else
+            (void)threadCount;
+#endif
+        }
+
+        ~WebsocketReactor()
+        {
+#ifdef __linux__
+            _stopping = true;
+            if (_wakeFd >= 0)
+            {
+                // the eventfd stays readable, every I/O thread sees it
+                std::uint64_t one = 1;
+                [[maybe_unused]] auto written = write(_wakeFd, &one, sizeof(one));
+            }
+            for (auto &thread : _threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            closeFds();
+#endif
+        }
+
+        bool isRunning() const
+        {
+            return !_threads.empty();
+        }
+
+        /**
+         * Starts watching a socket. The handler is run once right away on an I/O thread, picking up anything
+         * curl already buffered, then each time the socket becomes readable.
+         * @return 0 if the socket could not be added.
+         */
+        RegistrationId add(int fd, ReadableHandler handler)
+        {
+#ifdef __linux__
+            auto registration = std::make_shared<Registration>();
+            registration->fd = fd;
+            registration->handler = std::move(handler);
+
+            std::lock_guard<std::mutex> lock(_registrationsMutex);
+            RegistrationId id = ++_lastId;
+            _registrations.emplace(id, registration);
+            epoll_event event{};
+            // a connected socket is writable, EPOLLOUT makes the first dispatch immediate
+            event.events = EPOLLIN | EPOLLOUT | EPOLLONESHOT;
+            event.data.u64 = id;
+            if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+            {
+                spdlog::error("WebSocket reactor: cannot watch socket {}: {}", fd, std::strerror(errno));
+                _registrations.erase(id);
+                return 0;
+            }
+            return id;
+#else
+            (void)fd;
+            (void)handler;
+            return 0;
+#endif
+        }
+
+        /**
+         * Stops watching a socket. When it returns the handler is not running and will not run again,
+         * except when called from the handler itself. Must be called before the socket is closed.
+         */
+        void remove(RegistrationId id)
+        {
+#ifdef __linux__
+            std::shared_ptr<Registration> registration;
+            {
+                std::lock_guard<std::mutex> lock(_registrationsMutex);
+                auto it = _registrations.find(id);
+                if (it == _registrations.end())
+                {
+                    return;
+                }
+                registration = it->second;
+                _registrations.erase(it);
+            }
+            if (registration->runningThread == std::this_thread::get_id())
+            {
+                registration->closed = true;
+                epoll_ctl(_epollFd, EPOLL_CTL_DEL, registration->fd, nullptr);
+                return;
+            }
+            std::lock_guard<std::mutex> lock(registration->mutex);
+            registration->closed = true;
+            epoll_ctl(_epollFd, EPOLL_CTL_DEL, registration->fd, nullptr);
+#else
+            (void)id;
+#endif
+        }
+
+        std::size_t watchedSockets() const
+        {
+            std::lock_guard<std::mutex> lock(_registrationsMutex);
+            return _registrations.size();
+        }
+
+    private:
+        struct Registration
+        {
+            int fd = -1;
+            ReadableHandler handler;
+            std::mutex mutex;
+            bool closed = false;
+            std::atomic<std::thread::id> runningThread{};
+        };
+
+        static constexpr RegistrationId WAKE_ID = 0;
+        static constexpr int MAX_EVENTS = 64;
+
+#ifdef __linux__
+        void run()
+        {
+            epoll_event events[MAX_EVENTS];
+            while (!_stopping)
+            {
+                int count = epoll_wait(_epollFd, events, MAX_EVENTS, -1);
+                if (count < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    spdlog::error("WebSocket reactor: epoll_wait failed: {}", std::strerror(errno));
+                    break;
+                }
+                for (int i = 0; i < count && !_stopping; ++i)
+                {
+                    if (events[i].data.u64 != WAKE_ID)
+                    {
+                        dispatch(events[i].data.u64);
+                    }
+                }
+            }
+        }
+
+        void dispatch(RegistrationId id)
+        {
+            std::shared_ptr<Registration> registration;
+            {
+                std::lock_guard<std::mutex> lock(_registrationsMutex);
+                auto it = _registrations.find(id);
+                if (it == _registrations.end())
+                {
+                    return;
+                }
+                registration = it->second;
+            }
+
+            std::lock_guard<std::mutex> lock(registration->mutex);
+            if (registration->closed)
+            {
+                return;
+            }
+            bool keepWatching = false;
+            registration->runningThread = std::this_thread::get_id();
+            try
+            {
+                keepWatching = registration->handler();
+            }
+            catch (const std::exception &e)
+            {
+                spdlog::error("Error in WebSocket reactor handler: {}", e.what());
+            }
+            registration->runningThread = std::thread::id();
+            if (registration->closed)
+            {
+                return;
+            }
+
+            if (keepWatching)
+            {
+                epoll_event event{};
+                event.events = EPOLLIN | EPOLLONESHOT;
+                event.data.u64 = id;
+                if (epoll_ctl(_epollFd, EPOLL_CTL_MOD, registration->fd, &event) == 0)
+                {
+                    return;
+                }
+                spdlog::error("WebSocket reactor: cannot rearm socket {}: {}", registration->fd, std::strerror(errno));
+            }
+            registration->closed = true;
+            epoll_ctl(_epollFd, EPOLL_CTL_DEL, registration->fd, nullptr);
+            std::lock_guard<std::mutex> registrationsLock(_registrationsMutex);
+            _registrations.erase(id);
+        }
+
+        void closeFds()
+        {
+            if (_wakeFd >= 0)
+            {
+                close(_wakeFd);
+                _wakeFd = -1;
+            }
+            if (_epollFd >= 0)
+            {
+                close(_epollFd);
+                _epollFd = -1;
+            }
+        }
+#endif
+
+    private:
+        int _epollFd = -1;
+        int _wakeFd = -1;
+        std::atomic<bool> _stopping{false};
+        std::vector<std::thread> _threads;
+
+        mutable std::mutex _registrationsMutex;
+        std::unordered_map<RegistrationId, std::shared_ptr<Registration>> _registrations;
+        RegistrationId _lastId = WAKE_ID;
+    };
+}
@@ -0,0 +1,283 @@
+#pragma once
+
+#include "../gladiapp_ws.hpp"
+#include "mpmc_queue.hpp"
+#include "timer_wheel.hpp"
+#include <curl/curl.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <spdlog/spdlog.h>
+
+namespace gladiapp::v2::ws
+{
+    /**
+     * Outgoing frames of a session: senders only push into a lock-free queue and a writer thread owned
+     * by the session performs the socket writes, in order. Senders take a lock only to wake the writer
+     * when it is asleep, or to wait for a free slot with the BLOCK policy.
+     */
+    class WebsocketSendQueue
+    {
+    public:
+        struct Frame
+        {
+            std::string payload;
+            unsigned int flags = 0;
+            // submitted audio, sent in place of the payload and recycled once the frame is dropped or written
+            AudioBuffer audio;
+            // size of the audio a JSON frame carries, counted in the replay buffer's offsets once written
+            std::size_t audioBytes = 0;
+
+            const char *data() const
+            {
+                return audio ? reinterpret_cast<const char *>(audio.data()) : payload.data();
+            }
+
+            std::size_t size() const
+            {
+                return audio ? audio.size() : payload.size();
+            }
+        };
+
+        using SendFunction = std::function<bool(const Frame &frame)>;
+        using ErrorFunction = std::function<void(const std::string &errorMessage)>;
+        using HighWaterFunction = std::function<void(std::size_t depth)>;
+
+        WebsocketSendQueue(const SendQueueOptions &options, SendFunction send)
+            : _options(options), _queue(options.capacity), _send(std::move(send))
+        {
+            if (_options.highWaterMark == 0 || _options.highWaterMark > _queue.capacity())
+            {
+                _options.highWaterMark = std::max<std::size_t>(_queue.capacity() * 3 / 4, 1);
+            }
+        }
+
+        ~WebsocketSendQueue()
+        {
+            stop();
+        }
+
+        void setErrorFunction(ErrorFunction onError)
+        {
+            _onError = std::move(onError);
+        }
+
+        void setHighWaterFunction(HighWaterFunction onHighWater)
+        {
+            _onHighWater = std::move(onHighWater);
+        }
+
+        void start()
+        {
+            if (_writerThread.joinable())
+            {
+                return;
+            }
+            _running = true;
+            _writerThread = std::thread([this]()
+                                        { run(); });
+        }
+
+        /**
+         * Writes what is still queued, then stops the writer.
+         */
+        void stop()
+        {
+            if (!_writerThread.joinable())
+            {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _running = false;
+            }
+            _writerCondition.notify_all();
+            _spaceCondition.notify_all();
+            if (_writerThread.get_id() == std::this_thread::get_id())
+            {
+                // stopped from a callback run by the writer: it exits once the queue is empty, joined by the destructor
+                return;
+            }
+            _writerThread.join();
+        }
+
+        /**
+         * Queues a frame according to the overflow policy. Control frames (e.g. the stop signal)
+         * always wait for a slot instead of being dropped or refused. Audio queued by a timer task
+         * (coalescer deadline, paced stream) is refused rather than stall the shared timer thread.
+         */
+        bool enqueue(Frame &&frame, bool control = false)
+        {
+            if (!_running)
+            {
+                return false;
+            }
+            auto policy = control ? SendQueueOptions::OverflowPolicy::BLOCK : _options.overflowPolicy;
+            if (policy == SendQueueOptions::OverflowPolicy::BLOCK && !control && TimerWheel::onWheelThread())
+            {
+                policy = SendQueueOptions::OverflowPolicy::FAIL;
+            }
+            while (!_queue.tryPush(std::move(frame)))
+            {
+                if (policy == SendQueueOptions::OverflowPolicy::FAIL)
+                {
+                    ++_rejectedFrames;
+                    return false;
+                }
+                if (policy == SendQueueOptions::OverflowPolicy::DROP_OLDEST)
+                {
+                    // nothing is queued after the stop signal, so the oldest frame is always audio
+                    Frame oldest;
+                    if (_queue.tryPop(oldest))
+                    {
+                        ++_droppedFrames;
+                    }
+                    continue;
+                }
+                if (!waitForSpace())
+                {
+                    return false;
+                }
+            }
+            notifyWriter();
+            checkHighWater();
+            return true;
+        }
+
+        SendQueueStats stats() const
+        {
+            SendQueueStats stats;
+            stats.depth = _queue.sizeApprox();
+            stats.sentFrames = _sentFrames;
+            stats.droppedFrames = _droppedFrames;
+            stats.rejectedFrames = _rejectedFrames;
+            return stats;
+        }
+
+    private:
+        void run()
+        {
+            Frame frame;
+            for (;;)
+            {
+                while (_queue.tryPop(frame))
+                {
+                    notifySpace();
+                    if (_send(frame))
+                    {
+                        ++_sentFrames;
+                    }
+                    else if (_onError)
+                    {
+                        try
+                        {
+                            _onError(frame.flags == CURLWS_BINARY ? "Error sending audio binary data" : "Error sending JSON text data");
+                        }
+                        catch (const std::exception &e)
+                        {
+                            spdlog::error("Error in send queue error callback: {}", e.what());
+                        }
+                    }
+                    frame.payload.clear();
+                    frame.audio = AudioBuffer();
+                }
+                checkLowWater();
+
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (!_running && _queue.sizeApprox() == 0)
+                {
+                    break;
+                }
+                // paired with the check in notifyWriter(): either the sender sees the flag or we see its frame
+                _writerWaiting = true;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                _writerCondition.wait(lock, [this]()
+                                      { return !_running || _queue.sizeApprox() != 0; });
+                _writerWaiting = false;
+            }
+        }
+
+        void notifyWriter()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_writerWaiting)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _writerCondition.notify_one();
+            }
+        }
+
+        bool waitForSpace()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            ++_sendersWaiting;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            _spaceCondition.wait(lock, [this]()
+                                 { return !_running || _queue.sizeApprox() < _queue.capacity(); });
+            --_sendersWaiting;
+            return _running;
+        }
+
+        void notifySpace()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_sendersWaiting != 0)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _spaceCondition.notify_all();
+            }
+        }
+
+        void checkHighWater()
+        {
+            std::size_t depth = _queue.sizeApprox();
+            if (depth < _options.highWaterMark || _aboveHighWater.exchange(true))
+            {
+                return;
+            }
+            if (_onHighWater)
+            {
+                try
+                {
+                    _onHighWater(depth);
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::error("Error in send queue high-water callback: {}", e.what());
+                }
+            }
+        }
+
+        void checkLowWater()
+        {
+            if (_aboveHighWater && _queue.sizeApprox() < _options.highWaterMark / 2 + 1)
+            {
+                _aboveHighWater = false;
+            }
+        }
+
+    private:
+        SendQueueOptions _options;
+        concurrent_util::BoundedMpmcQueue<Frame> _queue;
+        SendFunction _send;
+        ErrorFunction _onError;
+        HighWaterFunction _onHighWater;
+
+        std::mutex _mutex;
+        std::condition_variable _writerCondition;
+        std::condition_variable _spaceCondition;
+        std::atomic<bool> _running{false};
+        std::atomic<bool> _writerWaiting{false};
+        std::atomic<int> _sendersWaiting{0};
+        std::atomic<bool> _aboveHighWater{false};
+        std::thread _writerThread;
+
+        std::atomic<std::uint64_t> _sentFrames{0};
+        std::atomic<std::uint64_t> _droppedFrames{0};
+        std::atomic<std::uint64_t> _rejectedFrames{0};
+    };
+}
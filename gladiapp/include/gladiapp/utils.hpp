@@ -9,7 +9,7 @@ namespace gladiapp
         /**
          * Formats the given byte size into a human-readable string.
          */
-        std::string formatBytes(long long bytes)
+        inline std::string formatBytes(long long bytes)
         {
             const char *units[] = {"bytes", "Kb", "Mb", "Gb", "Tb", "Pb", "Eb"};
             int unitIndex = 0;
@@ -0,0 +1,171 @@
+#include "impl/base64_encoder.hpp"
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GLADIAPP_BASE64_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    /**
+     * Encodes the whole 3-byte groups and the padded tail left by the vectorized loops.
+     */
+    void encodeScalar(const std::uint8_t *data, std::size_t size, char *out)
+    {
+        std::size_t i = 0;
+        for (; i + 3 <= size; i += 3)
+        {
+            std::uint32_t group = (std::uint32_t(data[i]) << 16) | (std::uint32_t(data[i + 1]) << 8) | data[i + 2];
+            *out++ = ALPHABET[(group >> 18) & 0x3f];
+            *out++ = ALPHABET[(group >> 12) & 0x3f];
+            *out++ = ALPHABET[(group >> 6) & 0x3f];
+            *out++ = ALPHABET[group & 0x3f];
+        }
+        if (i < size)
+        {
+            std::uint32_t group = std::uint32_t(data[i]) << 16;
+            if (i + 1 < size)
+            {
+                group |= std::uint32_t(data[i + 1]) << 8;
+            }
+            *out++ = ALPHABET[(group >> 18) & 0x3f];
+            *out++ = ALPHABET[(group >> 12) & 0x3f];
+            *out++ = i + 1 < size ? ALPHABET[(group >> 6) & 0x3f] : '=';
+            *out++ = '=';
+        }
+    }
+
+#ifdef GLADIAPP_BASE64_X86
+    /*
+     * Vectorized encoding after Wojciech Mula and Daniel Lemire ("Faster Base64 Encoding and Decoding
+     * using AVX2 Instructions"): each group of 3 bytes is spread over 4 bytes with a shuffle, the four
+     * 6-bit indices are moved in place with two 16-bit multiplies, and the ASCII offset of each index
+     * range is looked up with a second shuffle.
+     */
+    __attribute__((target("ssse3"))) inline __m128i encodeBlock(__m128i input)
+    {
+        input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        const __m128i high = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        const __m128i low = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(high, low);
+
+        // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                              '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        return _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+    }
+
+    __attribute__((target("ssse3"))) void encodeSsse3(const std::uint8_t *data, std::size_t size, char *out)
+    {
+        // each step reads 16 bytes and consumes 12
+        std::size_t i = 0;
+        for (; i + 16 <= size; i += 12)
+        {
+            __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), encodeBlock(input));
+            out += 16;
+        }
+        encodeScalar(data + i, size - i, out);
+    }
+
+    __attribute__((target("avx2"))) void encodeAvx2(const std::uint8_t *data, std::size_t size, char *out)
+    {
+        const __m256i spread = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                               10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+        const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                 '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                                                 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                 '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+        // each step reads 28 bytes and consumes 24, 12 per 128-bit lane
+        std::size_t i = 0;
+        for (; i + 28 <= size; i += 24)
+        {
+            __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 12));
+            __m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+
+            input = _mm256_shuffle_epi8(input, spread);
+            const __m256i highBits = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+            const __m256i lowBits = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+            const __m256i indices = _mm256_or_si256(highBits, lowBits);
+
+            __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+            range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices));
+            out += 32;
+        }
+        encodeSsse3(data + i, size - i, out);
+    }
+#endif
+
+    using gladiapp::v2::base64_util::EncodeFunction;
+
+    struct Encoder
+    {
+        EncodeFunction function;
+        const char *name;
+    };
+
+    Encoder selectEncoder()
+    {
+#ifdef GLADIAPP_BASE64_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return {encodeAvx2, "avx2"};
+        }
+        if (__builtin_cpu_supports("ssse3"))
+        {
+            return {encodeSsse3, "ssse3"};
+        }
+#endif
+        return {encodeScalar, "scalar"};
+    }
+
+    const Encoder &encoder()
+    {
+        static const Encoder selected = selectEncoder();
+        return selected;
+    }
+}
+
+void gladiapp::v2::base64_util::encode(const std::uint8_t *data, std::size_t size, char *out)
+{
+    encoder().function(data, size, out);
+}
+
+const char *gladiapp::v2::base64_util::encoderName()
+{
+    return encoder().name;
+}
+
+gladiapp::v2::base64_util::EncodeFunction gladiapp::v2::base64_util::encoderFor(const char *name)
+{
+    if (name == nullptr)
+    {
+        return nullptr;
+    }
+    if (std::strcmp(name, "scalar") == 0)
+    {
+        return encodeScalar;
+    }
+#ifdef GLADIAPP_BASE64_X86
+    __builtin_cpu_init();
+    if (std::strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2"))
+    {
+        return encodeAvx2;
+    }
+    if (std::strcmp(name, "ssse3") == 0 && __builtin_cpu_supports("ssse3"))
+    {
+        return encodeSsse3;
+    }
+#endif
+    return nullptr;
+}
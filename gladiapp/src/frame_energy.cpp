@@ -0,0 +1,126 @@
+#include "impl/frame_energy.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GLADIAPP_ENERGY_X86 1
+#include <immintrin.h>
+#endif
+
+using gladiapp::v2::audio_util::FrameEnergy;
+
+namespace
+{
+    FrameEnergy measureScalar(const std::int16_t *samples, std::size_t count)
+    {
+        FrameEnergy energy;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::int64_t sample = samples[i];
+            energy.sumSquares += static_cast<std::uint64_t>(sample * sample);
+            if (i > 0 && ((samples[i - 1] ^ samples[i]) < 0))
+            {
+                ++energy.zeroCrossings;
+            }
+        }
+        return energy;
+    }
+
+#ifdef GLADIAPP_ENERGY_X86
+    __attribute__((target("avx2"))) std::uint32_t sumCrossings(__m256i counters)
+    {
+        alignas(32) std::int32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), _mm256_madd_epi16(counters, _mm256_set1_epi16(1)));
+        std::uint32_t sum = 0;
+        for (std::int32_t lane : lanes)
+        {
+            sum += static_cast<std::uint32_t>(lane);
+        }
+        return sum;
+    }
+
+    /**
+     * 16 samples per step: madd squares and adds pairs (at most 2^31, so the 32-bit lanes are read as
+     * unsigned and widened to 64 bits), the sign changes are counted on 16-bit lanes by comparing each
+     * vector with the same one shifted by a sample.
+     */
+    __attribute__((target("avx2"))) FrameEnergy measureAvx2(const std::int16_t *samples, std::size_t count)
+    {
+        FrameEnergy energy;
+        if (count < 17)
+        {
+            return measureScalar(samples, count);
+        }
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i squares = zero;
+        __m256i crossings = zero;
+        std::size_t i = 1;
+        std::size_t steps = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(samples + i));
+            __m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(samples + i - 1));
+
+            __m256i pairs = _mm256_madd_epi16(current, current);
+            squares = _mm256_add_epi64(squares, _mm256_unpacklo_epi32(pairs, zero));
+            squares = _mm256_add_epi64(squares, _mm256_unpackhi_epi32(pairs, zero));
+
+            // -1 in the lanes where the signs differ
+            crossings = _mm256_sub_epi16(crossings, _mm256_srai_epi16(_mm256_xor_si256(current, previous), 15));
+            if (++steps == 32767)
+            {
+                // flush the 16-bit counters before they can overflow
+                energy.zeroCrossings += sumCrossings(crossings);
+                crossings = zero;
+                steps = 0;
+            }
+        }
+
+        alignas(32) std::uint64_t squareLanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(squareLanes), squares);
+        energy.sumSquares += squareLanes[0] + squareLanes[1] + squareLanes[2] + squareLanes[3];
+        energy.zeroCrossings += sumCrossings(crossings);
+
+        // the first sample and the tail, which overlaps the vector part by one sample for the crossings
+        std::int64_t first = samples[0];
+        energy.sumSquares += static_cast<std::uint64_t>(first * first);
+        FrameEnergy tail = measureScalar(samples + i - 1, count - i + 1);
+        std::int64_t overlap = samples[i - 1];
+        energy.sumSquares += tail.sumSquares - static_cast<std::uint64_t>(overlap * overlap);
+        energy.zeroCrossings += tail.zeroCrossings;
+        return energy;
+    }
+#endif
+
+    struct Kernel
+    {
+        FrameEnergy (*function)(const std::int16_t *, std::size_t);
+        const char *name;
+    };
+
+    Kernel selectKernel()
+    {
+#ifdef GLADIAPP_ENERGY_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return {measureAvx2, "avx2"};
+        }
+#endif
+        return {measureScalar, "scalar"};
+    }
+
+    const Kernel &kernel()
+    {
+        static const Kernel selected = selectKernel();
+        return selected;
+    }
+}
+
+FrameEnergy gladiapp::v2::audio_util::measureFrame(const std::int16_t *samples, std::size_t count)
+{
+    return kernel().function(samples, count);
+}
+
+const char *gladiapp::v2::audio_util::frameEnergyKernelName()
+{
+    return kernel().name;
+}
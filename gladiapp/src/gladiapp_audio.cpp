@@ -0,0 +1,670 @@
+#include "gladiapp_audio.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GLADIAPP_AUDIO_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define GLADIAPP_AUDIO_NEON 1
+#include <arm_neon.h>
+#endif
+
+using namespace gladiapp::v2::audio;
+
+namespace
+{
+    /**
+     * Resampling response, relative to the lower of the two Nyquist frequencies: flat up to PASSBAND_EDGE,
+     * attenuated from the Nyquist frequency on, so that nothing aliases back into the output band.
+     */
+    constexpr double PASSBAND_EDGE = 0.85;
+
+    /**
+     * Transition width of a Blackman-windowed sinc times its length (in cycles per sample), about 74 dB of
+     * stopband attenuation.
+     */
+    constexpr double BLACKMAN_TRANSITION = 5.5;
+
+    /**
+     * The taps of each polyphase branch are a multiple of this, for the vector dot products.
+     */
+    constexpr std::size_t TAPS_ALIGNMENT = 8;
+
+    float dotScalar(const float *a, const float *b, std::size_t count)
+    {
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    void toInt16Scalar(const float *input, int16_t *output, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float scaled = std::nearbyint(input[i] * 32767.0f);
+            output[i] = static_cast<int16_t>(std::clamp(scaled, -32768.0f, 32767.0f));
+        }
+    }
+
+#ifdef GLADIAPP_AUDIO_X86
+    __attribute__((target("avx2,fma"))) float dotAvx2(const float *a, const float *b, std::size_t count)
+    {
+        __m256 sum = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum);
+        }
+        __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+        half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+        return _mm_cvtss_f32(half) + dotScalar(a + i, b + i, count - i);
+    }
+
+    __attribute__((target("avx2"))) void toInt16Avx2(const float *input, int16_t *output, std::size_t count)
+    {
+        const __m256 scale = _mm256_set1_ps(32767.0f);
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            // cvtps rounds to nearest even, packs saturates to the int16 range
+            __m256i low = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(input + i), scale));
+            __m256i high = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(input + i + 8), scale));
+            __m256i packed = _mm256_packs_epi32(low, high);
+            // packs works per 128-bit lane, restore the sample order
+            packed = _mm256_permute4x64_epi64(packed, 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + i), packed);
+        }
+        toInt16Scalar(input + i, output + i, count - i);
+    }
+#endif
+
+#ifdef GLADIAPP_AUDIO_NEON
+    float dotNeon(const float *a, const float *b, std::size_t count)
+    {
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            sum = vmlaq_f32(sum, vld1q_f32(a + i), vld1q_f32(b + i));
+        }
+        float32x2_t pair = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+        return vget_lane_f32(vpadd_f32(pair, pair), 0) + dotScalar(a + i, b + i, count - i);
+    }
+
+    void toInt16Neon(const float *input, int16_t *output, std::size_t count)
+    {
+#if defined(__aarch64__)
+        const float32x4_t scale = vdupq_n_f32(32767.0f);
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            int32x4_t low = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(input + i), scale));
+            int32x4_t high = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(input + i + 4), scale));
+            vst1q_s16(output + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+        }
+        toInt16Scalar(input + i, output + i, count - i);
+#else
+        toInt16Scalar(input, output, count);
+#endif
+    }
+#endif
+
+    struct Kernels
+    {
+        float (*dot)(const float *, const float *, std::size_t);
+        void (*toInt16)(const float *, int16_t *, std::size_t);
+        const char *name;
+    };
+
+    Kernels selectKernels()
+    {
+#ifdef GLADIAPP_AUDIO_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            return {dotAvx2, toInt16Avx2, "avx2"};
+        }
+#endif
+#ifdef GLADIAPP_AUDIO_NEON
+        return {dotNeon, toInt16Neon, "neon"};
+#endif
+        return {dotScalar, toInt16Scalar, "scalar"};
+    }
+
+    const Kernels &kernels()
+    {
+        static const Kernels selected = selectKernels();
+        return selected;
+    }
+
+    /**
+     * G.711 encoders (after the Sun reference implementation), tabulated over all 16-bit samples.
+     */
+    uint8_t linearToAlaw(int pcm)
+    {
+        static constexpr std::array<int, 8> segmentEnds = {0x1F, 0x3F, 0x7F, 0xFF, 0x1FF, 0x3FF, 0x7FF, 0xFFF};
+        pcm >>= 3;
+        int mask = 0xD5;
+        if (pcm < 0)
+        {
+            mask = 0x55;
+            pcm = -pcm - 1;
+        }
+        int segment = static_cast<int>(std::lower_bound(segmentEnds.begin(), segmentEnds.end(), pcm) - segmentEnds.begin());
+        if (segment >= 8)
+        {
+            return static_cast<uint8_t>(0x7F ^ mask);
+        }
+        int value = segment << 4;
+        value |= segment < 2 ? (pcm >> 1) & 0x0F : (pcm >> segment) & 0x0F;
+        return static_cast<uint8_t>(value ^ mask);
+    }
+
+    uint8_t linearToUlaw(int pcm)
+    {
+        static constexpr std::array<int, 8> segmentEnds = {0x3F, 0x7F, 0xFF, 0x1FF, 0x3FF, 0x7FF, 0xFFF, 0x1FFF};
+        pcm >>= 2;
+        int mask = 0xFF;
+        if (pcm < 0)
+        {
+            pcm = -pcm;
+            mask = 0x7F;
+        }
+        pcm = std::min(pcm, 8159) + (0x84 >> 2);
+        int segment = static_cast<int>(std::lower_bound(segmentEnds.begin(), segmentEnds.end(), pcm) - segmentEnds.begin());
+        if (segment >= 8)
+        {
+            return static_cast<uint8_t>(0x7F ^ mask);
+        }
+        int value = (segment << 4) | ((pcm >> (segment + 1)) & 0x0F);
+        return static_cast<uint8_t>(value ^ mask);
+    }
+
+    struct CompandingTables
+    {
+        std::array<uint8_t, 65536> alaw;
+        std::array<uint8_t, 65536> ulaw;
+
+        CompandingTables()
+        {
+            for (int sample = -32768; sample <= 32767; ++sample)
+            {
+                auto index = static_cast<uint16_t>(sample);
+                alaw[index] = linearToAlaw(sample);
+                ulaw[index] = linearToUlaw(sample);
+            }
+        }
+    };
+
+    const CompandingTables &compandingTables()
+    {
+        static const CompandingTables tables;
+        return tables;
+    }
+
+    bool isSupportedRate(int sampleRate)
+    {
+        return sampleRate >= 4000 && sampleRate <= 192000;
+    }
+}
+
+namespace gladiapp
+{
+    namespace v2
+    {
+        namespace audio
+        {
+            class AudioConverterImpl
+            {
+            public:
+                AudioConverterImpl(int inputSampleRate, int inputChannels, const AudioFormat &outputFormat)
+                    : _inputSampleRate(inputSampleRate), _inputChannels(inputChannels), _outputFormat(outputFormat)
+                {
+                    if (!isSupportedRate(inputSampleRate) || !isSupportedRate(outputFormat.sampleRate))
+                    {
+                        throw std::invalid_argument("Unsupported sample rate");
+                    }
+                    if (inputChannels < 1 || (outputFormat.channels != 1 && outputFormat.channels != inputChannels))
+                    {
+                        throw std::invalid_argument("Output channels must be 1 or match the input channels");
+                    }
+                    if (outputFormat.encoding == AudioFormat::Encoding::PCM &&
+                        outputFormat.bitDepth != 8 && outputFormat.bitDepth != 16 &&
+                        outputFormat.bitDepth != 24 && outputFormat.bitDepth != 32)
+                    {
+                        throw std::invalid_argument("Unsupported PCM bit depth " + std::to_string(outputFormat.bitDepth));
+                    }
+                    if (outputFormat.encoding != AudioFormat::Encoding::PCM)
+                    {
+                        _outputFormat.bitDepth = 8;
+                        compandingTables();
+                    }
+
+                    int divisor = std::gcd(inputSampleRate, outputFormat.sampleRate);
+                    _upFactor = static_cast<std::size_t>(outputFormat.sampleRate / divisor);
+                    _downFactor = static_cast<std::size_t>(inputSampleRate / divisor);
+                    if (_upFactor != 1 || _downFactor != 1)
+                    {
+                        designFilter();
+                    }
+                    _channels.resize(static_cast<std::size_t>(outputFormat.channels));
+                    reset();
+                }
+
+                template <typename Sample>
+                std::size_t convert(const Sample *samples, std::size_t frameCount, std::vector<uint8_t> &output)
+                {
+                    mixInput(samples, frameCount);
+                    std::size_t outputFrames = resample();
+                    interleave(outputFrames);
+                    return encode(output);
+                }
+
+                void reset()
+                {
+                    for (auto &channel : _channels)
+                    {
+                        // the history starts silent so that the first output sample is aligned on the first input
+                        channel.input.assign(isResampling() ? _tapsPerPhase - 1 : 0, 0.0f);
+                        channel.output.clear();
+                    }
+                    _phase = 0;
+                    _position = isResampling() ? _tapsPerPhase - 1 : 0;
+                }
+
+                int inputSampleRate() const
+                {
+                    return _inputSampleRate;
+                }
+
+                int inputChannels() const
+                {
+                    return _inputChannels;
+                }
+
+                const AudioFormat &outputFormat() const
+                {
+                    return _outputFormat;
+                }
+
+            private:
+                struct Channel
+                {
+                    std::vector<float> input;
+                    std::vector<float> output;
+                };
+
+                bool isResampling() const
+                {
+                    return !_coefficients.empty();
+                }
+
+                /**
+                 * Windowed-sinc prototype at the upsampled rate, its transition band between PASSBAND_EDGE and
+                 * the lower of the two Nyquist frequencies, split into one reversed branch per phase so each
+                 * output sample is a contiguous dot product with the input history.
+                 * The prototype is sized from that transition width: when decimating, each branch spans
+                 * proportionally more input samples.
+                 */
+                void designFilter()
+                {
+                    const double nyquist = 0.5 / static_cast<double>(std::max(_upFactor, _downFactor));
+                    const double transition = nyquist * (1.0 - PASSBAND_EDGE);
+                    const auto minimumLength = static_cast<std::size_t>(std::ceil(BLACKMAN_TRANSITION / transition));
+                    _tapsPerPhase = (minimumLength + _upFactor - 1) / _upFactor;
+                    _tapsPerPhase = (_tapsPerPhase + TAPS_ALIGNMENT - 1) / TAPS_ALIGNMENT * TAPS_ALIGNMENT;
+
+                    const std::size_t length = _tapsPerPhase * _upFactor;
+                    const double cutoff = nyquist * (1.0 + PASSBAND_EDGE) / 2.0;
+                    const double center = (static_cast<double>(length) - 1.0) / 2.0;
+                    const double pi = 3.14159265358979323846;
+                    std::vector<double> prototype(length);
+                    for (std::size_t j = 0; j < length; ++j)
+                    {
+                        double x = static_cast<double>(j) - center;
+                        double sinc = x == 0.0 ? 2.0 * cutoff : std::sin(2.0 * pi * cutoff * x) / (pi * x);
+                        // Blackman window
+                        double phase = 2.0 * pi * static_cast<double>(j) / (static_cast<double>(length) - 1.0);
+                        double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+                        prototype[j] = sinc * window;
+                    }
+
+                    _coefficients.assign(_upFactor * _tapsPerPhase, 0.0f);
+                    for (std::size_t phase = 0; phase < _upFactor; ++phase)
+                    {
+                        double sum = 0.0;
+                        for (std::size_t k = 0; k < _tapsPerPhase; ++k)
+                        {
+                            sum += prototype[phase + k * _upFactor];
+                        }
+                        for (std::size_t k = 0; k < _tapsPerPhase; ++k)
+                        {
+                            // unit gain per branch, so no phase ripples at DC
+                            double tap = sum != 0.0 ? prototype[phase + k * _upFactor] / sum : 0.0;
+                            _coefficients[phase * _tapsPerPhase + (_tapsPerPhase - 1 - k)] = static_cast<float>(tap);
+                        }
+                    }
+                }
+
+                static float toFloat(float sample)
+                {
+                    return sample;
+                }
+
+                static float toFloat(int16_t sample)
+                {
+                    return static_cast<float>(sample) * (1.0f / 32768.0f);
+                }
+
+                template <typename Sample>
+                void mixInput(const Sample *samples, std::size_t frameCount)
+                {
+                    const std::size_t inputChannels = static_cast<std::size_t>(_inputChannels);
+                    if (_channels.size() == 1 && inputChannels > 1)
+                    {
+                        auto &input = _channels[0].input;
+                        std::size_t start = input.size();
+                        input.resize(start + frameCount);
+                        const float gain = 1.0f / static_cast<float>(inputChannels);
+                        for (std::size_t frame = 0; frame < frameCount; ++frame)
+                        {
+                            float sum = 0.0f;
+                            for (std::size_t channel = 0; channel < inputChannels; ++channel)
+                            {
+                                sum += toFloat(samples[frame * inputChannels + channel]);
+                            }
+                            input[start + frame] = sum * gain;
+                        }
+                        return;
+                    }
+                    for (std::size_t channel = 0; channel < _channels.size(); ++channel)
+                    {
+                        auto &input = _channels[channel].input;
+                        std::size_t start = input.size();
+                        input.resize(start + frameCount);
+                        for (std::size_t frame = 0; frame < frameCount; ++frame)
+                        {
+                            input[start + frame] = toFloat(samples[frame * inputChannels + channel]);
+                        }
+                    }
+                }
+
+                /**
+                 * Runs the polyphase filter over the buffered input of every channel.
+                 * @return number of output frames produced.
+                 */
+                std::size_t resample()
+                {
+                    if (!isResampling())
+                    {
+                        for (auto &channel : _channels)
+                        {
+                            channel.output.swap(channel.input);
+                            channel.input.clear();
+                        }
+                        return _channels[0].output.size();
+                    }
+
+                    const auto dot = kernels().dot;
+                    std::size_t phase = 0;
+                    std::size_t position = 0;
+                    std::size_t produced = 0;
+                    for (auto &channel : _channels)
+                    {
+                        // every channel walks the same positions
+                        phase = _phase;
+                        position = _position;
+                        channel.output.clear();
+                        const float *input = channel.input.data();
+                        while (position < channel.input.size())
+                        {
+                            const float *window = input + position + 1 - _tapsPerPhase;
+                            channel.output.push_back(dot(_coefficients.data() + phase * _tapsPerPhase, window, _tapsPerPhase));
+                            phase += _downFactor;
+                            position += phase / _upFactor;
+                            phase %= _upFactor;
+                        }
+                        produced = channel.output.size();
+                    }
+
+                    // keep the history the next output samples still need, position may be past the end
+                    // of the input when decimating by more than the filter length
+                    std::size_t consumed = std::min(position + 1 - _tapsPerPhase, _channels[0].input.size());
+                    for (auto &channel : _channels)
+                    {
+                        channel.input.erase(channel.input.begin(), channel.input.begin() + static_cast<std::ptrdiff_t>(consumed));
+                    }
+                    _phase = phase;
+                    _position = position - consumed;
+                    return produced;
+                }
+
+                void interleave(std::size_t frameCount)
+                {
+                    const std::size_t channels = _channels.size();
+                    _interleaved.resize(frameCount * channels);
+                    for (std::size_t channel = 0; channel < channels; ++channel)
+                    {
+                        const auto &output = _channels[channel].output;
+                        for (std::size_t frame = 0; frame < frameCount; ++frame)
+                        {
+                            _interleaved[frame * channels + channel] = output[frame];
+                        }
+                    }
+                }
+
+                std::size_t encode(std::vector<uint8_t> &output)
+                {
+                    const std::size_t count = _interleaved.size();
+                    const std::size_t start = output.size();
+                    output.resize(start + count * _outputFormat.bytesPerSample());
+                    uint8_t *out = output.data() + start;
+
+                    if (_outputFormat.encoding != AudioFormat::Encoding::PCM || _outputFormat.bitDepth <= 16)
+                    {
+                        _quantized.resize(count);
+                        kernels().toInt16(_interleaved.data(), _quantized.data(), count);
+                    }
+
+                    switch (_outputFormat.encoding)
+                    {
+                    case AudioFormat::Encoding::ALAW:
+                    case AudioFormat::Encoding::ULAW:
+                    {
+                        const auto &table = _outputFormat.encoding == AudioFormat::Encoding::ALAW ? compandingTables().alaw : compandingTables().ulaw;
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            out[i] = table[static_cast<uint16_t>(_quantized[i])];
+                        }
+                        break;
+                    }
+                    case AudioFormat::Encoding::PCM:
+                        encodePcm(out, count);
+                        break;
+                    }
+                    return output.size() - start;
+                }
+
+                void encodePcm(uint8_t *out, std::size_t count) const
+                {
+                    switch (_outputFormat.bitDepth)
+                    {
+                    case 8:
+                        // 8-bit WAV samples are unsigned
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            out[i] = static_cast<uint8_t>((_quantized[i] >> 8) + 128);
+                        }
+                        break;
+                    case 16:
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            auto sample = static_cast<uint16_t>(_quantized[i]);
+                            out[2 * i] = static_cast<uint8_t>(sample);
+                            out[2 * i + 1] = static_cast<uint8_t>(sample >> 8);
+                        }
+                        break;
+                    case 24:
+                    case 32:
+                    {
+                        const std::size_t bytes = static_cast<std::size_t>(_outputFormat.bitDepth / 8);
+                        const double scale = _outputFormat.bitDepth == 24 ? 8388607.0 : 2147483647.0;
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            double scaled = std::nearbyint(std::clamp(static_cast<double>(_interleaved[i]), -1.0, 1.0) * scale);
+                            auto sample = static_cast<uint32_t>(static_cast<int32_t>(scaled));
+                            for (std::size_t b = 0; b < bytes; ++b)
+                            {
+                                out[i * bytes + b] = static_cast<uint8_t>(sample >> (8 * b));
+                            }
+                        }
+                        break;
+                    }
+                    }
+                }
+
+            private:
+                int _inputSampleRate;
+                int _inputChannels;
+                AudioFormat _outputFormat;
+
+                std::size_t _upFactor = 1;
+                std::size_t _downFactor = 1;
+                std::size_t _tapsPerPhase = 0;
+                std::vector<float> _coefficients;
+                std::size_t _phase = 0;
+                // index in each channel's input of the newest sample under the filter
+                std::size_t _position = 0;
+
+                std::vector<Channel> _channels;
+                std::vector<float> _interleaved;
+                std::vector<int16_t> _quantized;
+            };
+        }
+    }
+}
+
+/**************************************************************************************************************************************
+ * AudioFormat
+ **************************************************************************************************************************************/
+
+AudioFormat gladiapp::v2::audio::AudioFormat::fromSessionRequest(const ws::request::InitializeSessionRequest &request)
+{
+    using Request = ws::request::InitializeSessionRequest;
+    AudioFormat format;
+    switch (request.encoding)
+    {
+    case Request::Encoding::WAV_PCM:
+        format.encoding = Encoding::PCM;
+        break;
+    case Request::Encoding::WAV_ALAW:
+        format.encoding = Encoding::ALAW;
+        break;
+    case Request::Encoding::WAV_ULAW:
+        format.encoding = Encoding::ULAW;
+        break;
+    }
+    switch (request.bit_depth)
+    {
+    case Request::BitDepth::BIT_DEPTH_8:
+        format.bitDepth = 8;
+        break;
+    case Request::BitDepth::BIT_DEPTH_16:
+        format.bitDepth = 16;
+        break;
+    case Request::BitDepth::BIT_DEPTH_24:
+        format.bitDepth = 24;
+        break;
+    case Request::BitDepth::BIT_DEPTH_32:
+        format.bitDepth = 32;
+        break;
+    }
+    switch (request.sample_rate)
+    {
+    case Request::SampleRate::SAMPLE_RATE_8000:
+        format.sampleRate = 8000;
+        break;
+    case Request::SampleRate::SAMPLE_RATE_16000:
+        format.sampleRate = 16000;
+        break;
+    case Request::SampleRate::SAMPLE_RATE_32000:
+        format.sampleRate = 32000;
+        break;
+    case Request::SampleRate::SAMPLE_RATE_44100:
+        format.sampleRate = 44100;
+        break;
+    case Request::SampleRate::SAMPLE_RATE_48000:
+        format.sampleRate = 48000;
+        break;
+    }
+    format.channels = request.channels;
+    return format;
+}
+
+std::size_t gladiapp::v2::audio::AudioFormat::bytesPerSample() const
+{
+    return encoding == Encoding::PCM ? static_cast<std::size_t>(bitDepth / 8) : 1;
+}
+
+std::size_t gladiapp::v2::audio::AudioFormat::bytesPerSecond() const
+{
+    return bytesPerSample() * static_cast<std::size_t>(std::max(channels, 1)) * static_cast<std::size_t>(sampleRate);
+}
+
+/**************************************************************************************************************************************
+ * AudioConverter
+ **************************************************************************************************************************************/
+
+gladiapp::v2::audio::AudioConverter::AudioConverter(int inputSampleRate, int inputChannels, const AudioFormat &outputFormat)
+    : _impl(std::make_unique<AudioConverterImpl>(inputSampleRate, inputChannels, outputFormat))
+{
+}
+
+gladiapp::v2::audio::AudioConverter::~AudioConverter()
+{
+}
+
+std::size_t gladiapp::v2::audio::AudioConverter::convert(const float *samples, std::size_t frameCount, std::vector<uint8_t> &output)
+{
+    return _impl->convert(samples, frameCount, output);
+}
+
+std::size_t gladiapp::v2::audio::AudioConverter::convert(const int16_t *samples, std::size_t frameCount, std::vector<uint8_t> &output)
+{
+    return _impl->convert(samples, frameCount, output);
+}
+
+void gladiapp::v2::audio::AudioConverter::reset()
+{
+    _impl->reset();
+}
+
+int gladiapp::v2::audio::AudioConverter::inputSampleRate() const
+{
+    return _impl->inputSampleRate();
+}
+
+int gladiapp::v2::audio::AudioConverter::inputChannels() const
+{
+    return _impl->inputChannels();
+}
+
+const AudioFormat &gladiapp::v2::audio::AudioConverter::outputFormat() const
+{
+    return _impl->outputFormat();
+}
+
+const char *gladiapp::v2::audio::AudioConverter::kernelName()
+{
+    return kernels().name;
+}
@@ -15,9 +15,13 @@ void gladiapp::v2::response::TranscriptionError::reset()
 
 // TranscriptionError implementations
 TranscriptionError TranscriptionError::fromJson(const std::string &jsonString)
+{
+    return fromJsonDocument(nlohmann::json::parse(jsonString));
+}
+
+TranscriptionError TranscriptionError::fromJsonDocument(const nlohmann::json &json)
 {
     TranscriptionError error;
-    auto json = nlohmann::json::parse(jsonString);
 
     error.timestamp = json.value("timestamp", "");
     error.path = json.value("path", "");
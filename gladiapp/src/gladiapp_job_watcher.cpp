@@ -0,0 +1,38 @@
+#include "../include/gladiapp/gladiapp_job_watcher.hpp"
+#include "../include/gladiapp/impl/gladia_job_watcher_impl.hpp"
+
+gladiapp::v2::JobWatcher::JobWatcher(const GladiaRestClient &client, const JobWatcherOptions &options)
+{
+    _jobWatcherImpl = std::make_unique<JobWatcherImpl>(client, options);
+}
+
+gladiapp::v2::JobWatcher::~JobWatcher()
+{
+}
+
+std::future<response::TranscriptionResult> gladiapp::v2::JobWatcher::watch(const std::string &id,
+                                                                           double audioDuration,
+                                                                           const CompletionCallback &callback)
+{
+    return _jobWatcherImpl->watch(id, audioDuration, callback);
+}
+
+bool gladiapp::v2::JobWatcher::unwatch(const std::string &id)
+{
+    return _jobWatcherImpl->unwatch(id);
+}
+
+bool gladiapp::v2::JobWatcher::notifyResult(const response::TranscriptionResult &result)
+{
+    return _jobWatcherImpl->notifyResult(result);
+}
+
+std::size_t gladiapp::v2::JobWatcher::pendingJobs() const
+{
+    return _jobWatcherImpl->pendingJobs();
+}
+
+gladiapp::v2::JobWatcherStats gladiapp::v2::JobWatcher::getStats() const
+{
+    return _jobWatcherImpl->getStats();
+}
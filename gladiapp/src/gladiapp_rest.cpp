@@ -6,6 +6,11 @@ gladiapp::v2::GladiaRestClient::GladiaRestClient(const std::string &apiKey, cons
     _restClientImpl = std::make_unique<GladiaRestClientImpl>(apiKey, caFilePath);
 }
 
+gladiapp::v2::GladiaRestClient::GladiaRestClient(const std::string &apiKey, const std::string &caFilePath, const TransportOptions &options)
+{
+    _restClientImpl = std::make_unique<GladiaRestClientImpl>(apiKey, caFilePath, options);
+}
+
 gladiapp::v2::GladiaRestClient::~GladiaRestClient()
 {
 }
@@ -32,7 +37,80 @@ response::TranscriptionListResults gladiapp::v2::GladiaRestClient::getResults(co
 {
     return _restClientImpl->getResults(query, transcriptionError);
 }
+response::TranscriptionListResults gladiapp::v2::GladiaRestClient::getResultsStreaming(const request::ListResultsQuery &query,
+                                                                                  const ResultItemCallback &onItem,
+                                                                                  response::TranscriptionError *transcriptionError) const
+{
+    return _restClientImpl->getResultsStreaming(query, onItem, transcriptionError);
+}
+
 void gladiapp::v2::GladiaRestClient::deleteResult(const std::string &id, response::TranscriptionError *transcriptionError) const
 {
     _restClientImpl->deleteResult(id, transcriptionError);
+}
+
+std::future<response::UploadResponse> gladiapp::v2::GladiaRestClient::uploadAsync(const std::string &filePath,
+                                                                                  response::TranscriptionError *transcriptionError) const
+{
+    return _restClientImpl->uploadAsync(filePath, transcriptionError);
+}
+
+void gladiapp::v2::GladiaRestClient::uploadAsync(const std::string &filePath, const UploadCallback &callback) const
+{
+    _restClientImpl->uploadAsync(filePath, callback);
+}
+
+std::future<response::TranscriptionJobResponse> gladiapp::v2::GladiaRestClient::preRecordedAsync(const request::TranscriptionRequest &transcriptionRequest,
+                                                                                                 response::TranscriptionError *transcriptionError) const
+{
+    return _restClientImpl->preRecordedAsync(transcriptionRequest, transcriptionError);
+}
+
+void gladiapp::v2::GladiaRestClient::preRecordedAsync(const request::TranscriptionRequest &transcriptionRequest,
+                                                      const PreRecordedCallback &callback) const
+{
+    _restClientImpl->preRecordedAsync(transcriptionRequest, callback);
+}
+
+std::future<response::TranscriptionResult> gladiapp::v2::GladiaRestClient::getResultAsync(const std::string &id,
+                                                                                          response::TranscriptionError *transcriptionError) const
+{
+    return _restClientImpl->getResultAsync(id, transcriptionError);
+}
+
+void gladiapp::v2::GladiaRestClient::getResultAsync(const std::string &id, const ResultCallback &callback) const
+{
+    _restClientImpl->getResultAsync(id, callback);
+}
+
+std::future<response::TranscriptionListResults> gladiapp::v2::GladiaRestClient::getResultsAsync(const request::ListResultsQuery &query,
+                                                                                                response::TranscriptionError *transcriptionError) const
+{
+    return _restClientImpl->getResultsAsync(query, transcriptionError);
+}
+
+void gladiapp::v2::GladiaRestClient::getResultsAsync(const request::ListResultsQuery &query, const ResultsCallback &callback) const
+{
+    _restClientImpl->getResultsAsync(query, callback);
+}
+
+std::future<void> gladiapp::v2::GladiaRestClient::deleteResultAsync(const std::string &id,
+                                                                    response::TranscriptionError *transcriptionError) const
+{
+    return _restClientImpl->deleteResultAsync(id, transcriptionError);
+}
+
+void gladiapp::v2::GladiaRestClient::deleteResultAsync(const std::string &id, const DeleteCallback &callback) const
+{
+    _restClientImpl->deleteResultAsync(id, callback);
+}
+
+void gladiapp::v2::GladiaRestClient::setMaxConcurrentTransfers(size_t maxConcurrentTransfers)
+{
+    _restClientImpl->setMaxConcurrentTransfers(maxConcurrentTransfers);
+}
+
+gladiapp::v2::ConnectionPoolStats gladiapp::v2::GladiaRestClient::getConnectionPoolStats() const
+{
+    return _restClientImpl->getConnectionPoolStats();
 }
\ No newline at end of file
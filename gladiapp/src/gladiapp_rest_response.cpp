@@ -1,4 +1,5 @@
 #include "gladiapp/gladiapp_rest_response.hpp"
+#include "gladiapp/impl/simdjson_result_parser.hpp"
 #include <algorithm>
 
 namespace gladiapp
@@ -8,10 +9,9 @@ namespace gladiapp
         namespace response
         {
             // AudioMetadata implementations
-            UploadResponse::AudioMetadata UploadResponse::AudioMetadata::fromJson(const std::string &jsonString)
+            UploadResponse::AudioMetadata UploadResponse::AudioMetadata::fromJsonDocument(const nlohmann::json &json)
             {
                 AudioMetadata metadata;
-                auto json = nlohmann::json::parse(jsonString);
 
                 metadata.id = json.value("id", "");
                 metadata.filename = json.value("filename", "");
@@ -23,6 +23,11 @@ namespace gladiapp
                 return metadata;
             }
 
+            UploadResponse::AudioMetadata UploadResponse::AudioMetadata::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             std::string UploadResponse::AudioMetadata::toString() const
             {
                 nlohmann::json j;
@@ -36,21 +41,25 @@ namespace gladiapp
             }
 
             // UploadResponse implementations
-            UploadResponse UploadResponse::fromJson(const std::string &jsonString)
+            UploadResponse UploadResponse::fromJsonDocument(const nlohmann::json &json)
             {
                 UploadResponse response;
-                auto json = nlohmann::json::parse(jsonString);
 
                 response.audio_url = json.value("audio_url", "");
 
                 if (json.contains("audio_metadata"))
                 {
-                    response.audio_metadata = AudioMetadata::fromJson(json["audio_metadata"].dump());
+                    response.audio_metadata = AudioMetadata::fromJsonDocument(json["audio_metadata"]);
                 }
 
                 return response;
             }
 
+            UploadResponse UploadResponse::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             std::string UploadResponse::toString() const
             {
                 nlohmann::json j;
@@ -60,15 +69,19 @@ namespace gladiapp
             }
 
             // TranscriptionJobResponse implementations
-            TranscriptionJobResponse TranscriptionJobResponse::fromJson(const std::string &jsonString)
+            TranscriptionJobResponse TranscriptionJobResponse::fromJsonDocument(const nlohmann::json &json)
             {
                 TranscriptionJobResponse response;
-                auto json = nlohmann::json::parse(jsonString);
                 response.id = json.value("id", "");
                 response.result_url = json.value("result_url", "");
                 return response;
             }
 
+            TranscriptionJobResponse TranscriptionJobResponse::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             std::string TranscriptionJobResponse::toString() const
             {
                 nlohmann::json j;
@@ -90,10 +103,9 @@ namespace gladiapp
             }
 
             // TranscriptionFile implementations
-            TranscriptionFile TranscriptionFile::fromJson(const std::string &jsonString)
+            TranscriptionFile TranscriptionFile::fromJsonDocument(const nlohmann::json &json)
             {
                 TranscriptionFile file;
-                auto json = nlohmann::json::parse(jsonString);
 
                 file.id = json.value("id", "");
                 file.filename = json.value("filename", "");
@@ -113,6 +125,11 @@ namespace gladiapp
                 return file;
             }
 
+            TranscriptionFile TranscriptionFile::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             std::string TranscriptionFile::toString() const
             {
                 nlohmann::json j;
@@ -125,10 +142,9 @@ namespace gladiapp
             }
 
             // SentenceError implementations
-            SentenceError SentenceError::fromJson(const std::string &jsonString)
+            SentenceError SentenceError::fromJsonDocument(const nlohmann::json &json)
             {
                 SentenceError error;
-                auto json = nlohmann::json::parse(jsonString);
 
                 error.status_code = json.value("status_code", 0);
                 error.exception = json.value("exception", "");
@@ -137,6 +153,11 @@ namespace gladiapp
                 return error;
             }
 
+            SentenceError SentenceError::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             std::string SentenceError::toString() const
             {
                 nlohmann::json j;
@@ -147,10 +168,9 @@ namespace gladiapp
             }
 
             // Word implementations
-            TranscriptionResult::TranscriptionObject::Result::Utterance::Word TranscriptionResult::TranscriptionObject::Result::Utterance::Word::fromJson(const std::string &jsonString)
+            TranscriptionResult::TranscriptionObject::Result::Utterance::Word TranscriptionResult::TranscriptionObject::Result::Utterance::Word::fromJsonDocument(const nlohmann::json &json)
             {
                 Word word;
-                auto json = nlohmann::json::parse(jsonString);
 
                 word.word = json.value("word", "");
                 word.start = json.value("start", 0.0);
@@ -160,6 +180,11 @@ namespace gladiapp
                 return word;
             }
 
+            TranscriptionResult::TranscriptionObject::Result::Utterance::Word TranscriptionResult::TranscriptionObject::Result::Utterance::Word::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             std::string TranscriptionResult::TranscriptionObject::Result::Utterance::Word::toString() const
             {
                 nlohmann::json j;
@@ -171,10 +196,9 @@ namespace gladiapp
             }
 
             // Utterance implementations
-            TranscriptionResult::TranscriptionObject::Result::Utterance TranscriptionResult::TranscriptionObject::Result::Utterance::fromJson(const std::string &jsonString)
+            TranscriptionResult::TranscriptionObject::Result::Utterance TranscriptionResult::TranscriptionObject::Result::Utterance::fromJsonDocument(const nlohmann::json &json)
             {
                 Utterance utterance;
-                auto json = nlohmann::json::parse(jsonString);
 
                 utterance.language = json.value("language", "");
                 utterance.start = json.value("start", 0.0);
@@ -183,9 +207,10 @@ namespace gladiapp
                 utterance.channel = json.value("channel", 0);
                 if (json.contains("words"))
                 {
+                    utterance.words.reserve(json["words"].size());
                     for (const auto &wordJson : json["words"])
                     {
-                        utterance.words.push_back(Word::fromJson(wordJson.dump()));
+                        utterance.words.push_back(Word::fromJsonDocument(wordJson));
                     }
                 }
                 utterance.text = json.value("text", "");
@@ -194,6 +219,11 @@ namespace gladiapp
                 return utterance;
             }
 
+            TranscriptionResult::TranscriptionObject::Result::Utterance TranscriptionResult::TranscriptionObject::Result::Utterance::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             std::string TranscriptionResult::TranscriptionObject::Result::Utterance::toString() const
             {
                 nlohmann::json j;
@@ -213,18 +243,25 @@ namespace gladiapp
             }
 
             // Subtitle implementations
-            TranscriptionResult::TranscriptionObject::Result::Subtitle TranscriptionResult::TranscriptionObject::Result::Subtitle::fromJson(const std::string &jsonString)
+            TranscriptionResult::TranscriptionObject::Result::Subtitle TranscriptionResult::TranscriptionObject::Result::Subtitle::fromJsonDocument(const nlohmann::json &json)
             {
                 Subtitle subtitle;
-                auto json = nlohmann::json::parse(jsonString);
+
+                subtitle.format = json.value("format", "");
+                subtitle.subtitles = json.value("subtitles", "");
+
                 return subtitle;
             }
 
+            TranscriptionResult::TranscriptionObject::Result::Subtitle TranscriptionResult::TranscriptionObject::Result::Subtitle::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             // Result implementations
-            TranscriptionResult::TranscriptionObject::Result TranscriptionResult::TranscriptionObject::Result::fromJson(const std::string &jsonString)
+            TranscriptionResult::TranscriptionObject::Result TranscriptionResult::TranscriptionObject::Result::fromJsonDocument(const nlohmann::json &json)
             {
                 Result result;
-                auto json = nlohmann::json::parse(jsonString);
                 if (json.contains("full_transcript"))
                 {
                     result.full_transcript = json.value("full_transcript", "");
@@ -235,26 +272,31 @@ namespace gladiapp
                 }
                 if (json.contains("utterances"))
                 {
+                    result.utterances.reserve(json["utterances"].size());
                     for (const auto &utteranceJson : json["utterances"])
                     {
-                        result.utterances.push_back(Utterance::fromJson(utteranceJson.dump()));
+                        result.utterances.push_back(Utterance::fromJsonDocument(utteranceJson));
                     }
                 }
                 if (json.contains("subtitles"))
                 {
                     for (const auto &subtitleJson : json["subtitles"])
                     {
-                        result.subtitles.push_back(Subtitle::fromJson(subtitleJson.dump()));
+                        result.subtitles.push_back(Subtitle::fromJsonDocument(subtitleJson));
                     }
                 }
                 return result;
             }
 
+            TranscriptionResult::TranscriptionObject::Result TranscriptionResult::TranscriptionObject::Result::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             // Metadata implementations
-            Metadata Metadata::fromJson(const std::string &jsonString)
+            Metadata Metadata::fromJsonDocument(const nlohmann::json &json)
             {
                 Metadata metadata;
-                auto json = nlohmann::json::parse(jsonString);
 
                 metadata.audio_duration = json.value("audio_duration", 0.0);
                 metadata.number_of_distinct_channels = json.value("number_of_distinct_channels", 0);
@@ -264,27 +306,35 @@ namespace gladiapp
                 return metadata;
             }
 
+            Metadata Metadata::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             // TranscriptionObject implementations
-            TranscriptionResult::TranscriptionObject TranscriptionResult::TranscriptionObject::fromJson(const std::string &jsonString)
+            TranscriptionResult::TranscriptionObject TranscriptionResult::TranscriptionObject::fromJsonDocument(const nlohmann::json &json)
             {
                 TranscriptionObject obj;
-                auto json = nlohmann::json::parse(jsonString);
                 if (json.contains("metadata"))
                 {
-                    obj.metadata = Metadata::fromJson(json["metadata"].dump());
+                    obj.metadata = Metadata::fromJsonDocument(json["metadata"]);
                 }
                 if (json.contains("transcription"))
                 {
-                    obj.result = Result::fromJson(json["transcription"].dump());
+                    obj.result = Result::fromJsonDocument(json["transcription"]);
                 }
                 return obj;
             }
 
+            TranscriptionResult::TranscriptionObject TranscriptionResult::TranscriptionObject::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             // Moderation implementations
-            TranscriptionResult::Moderation TranscriptionResult::Moderation::fromJson(const std::string &jsonString)
+            TranscriptionResult::Moderation TranscriptionResult::Moderation::fromJsonDocument(const nlohmann::json &json)
             {
                 Moderation moderation;
-                auto json = nlohmann::json::parse(jsonString);
                 moderation.success = json.value("success", false);
                 moderation.is_empty = json.value("is_empty", false);
                 moderation.results = json.value("results", "");
@@ -296,11 +346,15 @@ namespace gladiapp
                 return moderation;
             }
 
+            TranscriptionResult::Moderation TranscriptionResult::Moderation::fromJson(const std::string &jsonString)
+            {
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
+
             // TranscriptionResult implementations
-            TranscriptionResult TranscriptionResult::fromJson(const std::string &jsonString)
+            TranscriptionResult TranscriptionResult::fromJsonDocument(const nlohmann::json &json)
             {
                 TranscriptionResult result;
-                auto json = nlohmann::json::parse(jsonString);
                 if (json.contains("id"))
                 {
                     result.id = json.value("id", "");
@@ -335,7 +389,7 @@ namespace gladiapp
                 }
                 if (json.contains("file") && json["file"].is_object())
                 {
-                    result.file = TranscriptionFile::fromJson(json["file"].dump());
+                    result.file = TranscriptionFile::fromJsonDocument(json["file"]);
                 }
                 if (json.contains("request_params") && json["request_params"].is_object())
                 {
@@ -347,28 +401,52 @@ namespace gladiapp
                 }
                 if (json.contains("result") && json["result"].is_object())
                 {
-                    result.result = TranscriptionObject::fromJson(json["result"].dump());
+                    result.result = TranscriptionObject::fromJsonDocument(json["result"]);
                 }
                 return result;
             }
+
+            TranscriptionResult TranscriptionResult::fromJson(const std::string &jsonString)
+            {
+#ifdef GLADIAPP_USE_SIMDJSON
+                TranscriptionResult result;
+                if (simdjson_util::parse(jsonString, result))
+                {
+                    return result;
+                }
+#endif
+                return fromJsonDocument(nlohmann::json::parse(jsonString));
+            }
         }
     }
 }
 
-gladiapp::v2::response::TranscriptionListResults gladiapp::v2::response::TranscriptionListResults::fromJson(const std::string &jsonString)
+gladiapp::v2::response::TranscriptionListResults gladiapp::v2::response::TranscriptionListResults::fromJsonDocument(const nlohmann::json &json)
 {
     TranscriptionListResults results;
-    auto json = nlohmann::json::parse(jsonString);
     results.first = json.value("first", "");
     results.current = json.value("current", "");
     if(json.contains("next") && !json["next"].is_null()) {
         results.next = json.value("next", "");
     }
     if(json.contains("items") && json["items"].is_array()) {
+        results.items.reserve(json["items"].size());
         for (const auto &item : json["items"])
         {
-            results.items.push_back(TranscriptionResult::fromJson(item.dump()));
+            results.items.push_back(TranscriptionResult::fromJsonDocument(item));
         }
     }
     return results;
+}
+
+gladiapp::v2::response::TranscriptionListResults gladiapp::v2::response::TranscriptionListResults::fromJson(const std::string &jsonString)
+{
+#ifdef GLADIAPP_USE_SIMDJSON
+    TranscriptionListResults results;
+    if (gladiapp::v2::simdjson_util::parse(jsonString, results))
+    {
+        return results;
+    }
+#endif
+    return fromJsonDocument(nlohmann::json::parse(jsonString));
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "../include/gladiapp/gladiapp_webhook.hpp"
+#include "../include/gladiapp/impl/gladia_webhook_receiver_impl.hpp"
+
+gladiapp::v2::WebhookReceiver::WebhookReceiver(const WebhookReceiverOptions &options)
+{
+    _webhookReceiverImpl = std::make_unique<WebhookReceiverImpl>(options);
+}
+
+gladiapp::v2::WebhookReceiver::~WebhookReceiver()
+{
+}
+
+bool gladiapp::v2::WebhookReceiver::start()
+{
+    return _webhookReceiverImpl->start();
+}
+
+void gladiapp::v2::WebhookReceiver::stop()
+{
+    _webhookReceiverImpl->stop();
+}
+
+std::uint16_t gladiapp::v2::WebhookReceiver::port() const
+{
+    return _webhookReceiverImpl->port();
+}
+
+std::string gladiapp::v2::WebhookReceiver::callbackPath() const
+{
+    return _webhookReceiverImpl->callbackPath();
+}
+
+std::future<response::TranscriptionResult> gladiapp::v2::WebhookReceiver::expect(const std::string &id)
+{
+    return _webhookReceiverImpl->expect(id);
+}
+
+void gladiapp::v2::WebhookReceiver::setOnResultCallback(const ResultCallback &callback)
+{
+    _webhookReceiverImpl->setOnResultCallback(callback);
+}
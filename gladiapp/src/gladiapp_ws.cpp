@@ -2,9 +2,16 @@
 #include "gladiapp_ws_request.hpp"
 #include "gladiapp_ws_response.hpp"
 #include "impl/gladia_ws_client_curl_impl.hpp"
+#include "impl/ws_event_table.hpp"
+#include "impl/json_scan.hpp"
+#include "impl/base64_encoder.hpp"
+#include "impl/voice_activity_gate.hpp"
+#include "impl/audio_pacer.hpp"
+#include "impl/live_event_stream.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
-#include <base64.hpp>
+#include <cstring>
+#include <fstream>
 
 using namespace gladiapp::v2::ws::response;
 using namespace gladiapp::v2::ws::request;
@@ -19,6 +26,12 @@ gladiapp::v2::ws::GladiaWebsocketClient::GladiaWebsocketClient(const std::string
 {
 }
 
+gladiapp::v2::ws::GladiaWebsocketClient::GladiaWebsocketClient(const std::string &apiKey, const std::string &caFilePath,
+                                                               const WebsocketClientOptions &options)
+    : _wsClientImpl(std::make_unique<GladiaWebsocketClientImpl>(apiKey, caFilePath, options)), _caFilePath(caFilePath)
+{
+}
+
 gladiapp::v2::ws::GladiaWebsocketClient::~GladiaWebsocketClient()
 {
 }
@@ -26,23 +39,45 @@ gladiapp::v2::ws::GladiaWebsocketClient::~GladiaWebsocketClient()
 GladiaWebsocketClientSession *gladiapp::v2::ws::GladiaWebsocketClient::connect(const request::InitializeSessionRequest &initRequest,
                                                                                gladiapp::v2::response::TranscriptionError *error) const
 {
-    auto initSessionResponse = _wsClientImpl->connect(initRequest, error);
+    SessionStartTiming timing;
+    std::unique_ptr<gladiapp::v2::curl_util::PreconnectedSocket> preconnectedSocket;
+    auto initSessionResponse = _wsClientImpl->connect(initRequest, error, &timing, &preconnectedSocket);
     if (error != nullptr && error->status_code != 0)
     {
         return nullptr;
     }
-    return new GladiaWebsocketClientSession(initSessionResponse, _caFilePath);
+    auto *session = new GladiaWebsocketClientSession(initSessionResponse, _caFilePath, _wsClientImpl->reactor(), _wsClientImpl->options());
+    session->_wsClientSessionImpl->setSessionCaches(_wsClientImpl->sessionCaches());
+    session->_wsClientSessionImpl->setStartTiming(timing);
+    session->_wsClientSessionImpl->setPreconnectedSocket(std::move(preconnectedSocket));
+    session->_wsClientSessionImpl->setCallbackExecutor(_wsClientImpl->callbackExecutor());
+    session->setAudioFormat(audio::AudioFormat::fromSessionRequest(initRequest));
+    VoiceActivityGateOptions gateOptions = _wsClientImpl->options().voiceActivityGate;
+    if (gateOptions.enabled)
+    {
+        if (gateOptions.thresholdDb == 0.0)
+        {
+            double speechThreshold = initRequest.pre_processing.value_or(request::InitializeSessionRequest::PreProcessing{}).speech_threshold;
+            gateOptions.thresholdDb = VoiceActivityGate::thresholdFromSpeechThreshold(speechThreshold);
+        }
+        session->enableVoiceActivityGate(gateOptions);
+    }
+    if (_wsClientImpl->options().eventStream.enabled)
+    {
+        session->enableEventStream(_wsClientImpl->options().eventStream);
+    }
+    return session;
 }
 
 response::LiveTranscriptionResult gladiapp::v2::ws::GladiaWebsocketClient::getResult(const std::string &id,
                                                                        gladiapp::v2::response::TranscriptionError *transcriptionError) const
 {
-    nlohmann::json outputJson;
-    if (_wsClientImpl->getResultById(id, outputJson, transcriptionError))
+    std::string outputBody;
+    if (_wsClientImpl->getResultById(id, outputBody, transcriptionError))
     {
         try
         {
-            return response::LiveTranscriptionResult::fromJson(outputJson);
+            return response::LiveTranscriptionResult::fromJsonString(outputBody);
         }
         catch (const std::exception &e)
         {
@@ -57,6 +92,90 @@ bool gladiapp::v2::ws::GladiaWebsocketClient::deleteResult(const std::string &id
     return _wsClientImpl->deleteResultById(id, transcriptionError);
 }
 
+gladiapp::v2::ConnectionPoolStats gladiapp::v2::ws::GladiaWebsocketClient::getConnectionPoolStats() const
+{
+    return _wsClientImpl->getConnectionPoolStats();
+}
+
+CallbackExecutorStats gladiapp::v2::ws::GladiaWebsocketClient::getCallbackExecutorStats() const
+{
+    auto executor = _wsClientImpl->callbackExecutor();
+    return executor != nullptr ? executor->stats() : CallbackExecutorStats{};
+}
+
+/**************************************************************************************************************************************
+ * AudioBuffer
+ **************************************************************************************************************************************/
+
+gladiapp::v2::ws::AudioBuffer::AudioBuffer() = default;
+
+gladiapp::v2::ws::AudioBuffer::AudioBuffer(std::unique_ptr<std::vector<uint8_t>> storage, std::shared_ptr<AudioBufferPool> pool)
+    : _storage(std::move(storage)), _pool(std::move(pool))
+{
+}
+
+gladiapp::v2::ws::AudioBuffer::AudioBuffer(AudioBuffer &&other) noexcept = default;
+
+AudioBuffer &gladiapp::v2::ws::AudioBuffer::operator=(AudioBuffer &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        _storage = std::move(other._storage);
+        _pool = std::move(other._pool);
+    }
+    return *this;
+}
+
+gladiapp::v2::ws::AudioBuffer::~AudioBuffer()
+{
+    release();
+}
+
+void gladiapp::v2::ws::AudioBuffer::release()
+{
+    if (_storage != nullptr && _pool != nullptr)
+    {
+        _pool->give(std::move(_storage));
+    }
+    _storage.reset();
+    _pool.reset();
+}
+
+uint8_t *gladiapp::v2::ws::AudioBuffer::data()
+{
+    return _storage != nullptr ? _storage->data() : nullptr;
+}
+
+const uint8_t *gladiapp::v2::ws::AudioBuffer::data() const
+{
+    return _storage != nullptr ? _storage->data() : nullptr;
+}
+
+std::size_t gladiapp::v2::ws::AudioBuffer::size() const
+{
+    return _storage != nullptr ? _storage->size() : 0;
+}
+
+std::size_t gladiapp::v2::ws::AudioBuffer::capacity() const
+{
+    return _storage != nullptr ? _storage->capacity() : 0;
+}
+
+void gladiapp::v2::ws::AudioBuffer::resize(std::size_t size)
+{
+    if (_storage == nullptr)
+    {
+        _storage = std::make_unique<std::vector<uint8_t>>();
+    }
+    _storage->resize(size);
+}
+
+gladiapp::v2::ws::AudioBuffer::operator bool() const
+{
+    return _storage != nullptr;
+}
+
 /**************************************************************************************************************************************
  * GladiaWebsocketClientSession
  **************************************************************************************************************************************/
@@ -68,10 +187,39 @@ gladiapp::v2::ws::GladiaWebsocketClientSession::GladiaWebsocketClientSession(con
 {
 }
 
+gladiapp::v2::ws::GladiaWebsocketClientSession::GladiaWebsocketClientSession(const response::InitializeSessionResponse &initResponse,
+                                                                             const std::string &caFilePath,
+                                                                             std::shared_ptr<WebsocketReactor> reactor,
+                                                                             const WebsocketClientOptions &options)
+    : _wsClientSessionImpl(std::make_unique<GladiaWebsocketClientSessionImpl>(initResponse.url, caFilePath, std::move(reactor), options)),
+      _sessionInfo(initResponse)
+{
+    _wsClientSessionImpl->setSendQueueHighWaterCallback([this](std::size_t depth)
+                                                        {
+                                                            if (this->_onSendQueueHighWaterCallback)
+                                                            {
+                                                                this->_onSendQueueHighWaterCallback(depth);
+                                                            } });
+    _wsClientSessionImpl->setReconnectedCallback([this]()
+                                                 {
+                                                     if (this->_onReconnectedCallback)
+                                                     {
+                                                         this->_onReconnectedCallback();
+                                                     } });
+}
+
 gladiapp::v2::ws::GladiaWebsocketClientSession::~GladiaWebsocketClientSession()
 {
+    if (_eventStream != nullptr)
+    {
+        // nobody polls any more, a full stream must not hold the dispatching thread
+        _eventStream->close();
+    }
+    stopStreaming();
     sendStopSignal();
     disconnect();
+    // the threads delivering events are stopped before the callbacks and the event stream they use are destroyed
+    _wsClientSessionImpl.reset();
 }
 
 InitializeSessionResponse gladiapp::v2::ws::GladiaWebsocketClientSession::getSessionInfo() const
@@ -86,179 +234,313 @@ bool gladiapp::v2::ws::GladiaWebsocketClientSession::connectAndStart()
         spdlog::warn("WebSocket is already connected.");
         return true;
     }
-    return _wsClientSessionImpl->connectAndStart([this](const std::string &message)
-                                                 { this->processDataMessage(message); },
-                                                 [this]()
-                                                 {
-                                                     if (this->_onConnectedCallback)
-                                                     {
-                                                         this->_onConnectedCallback();
-                                                     }
-                                                 },
-                                                 [this](const std::string &message)
-                                                 {
-                                                     if (this->_onDisconnectedCallback)
-                                                     {
-                                                         this->_onDisconnectedCallback();
-                                                     }
-                                                 },
-                                                 [this](const std::string &errorMessage)
+    auto onConnected = [this]()
+    {
+        if (this->_onConnectedCallback)
+        {
+            this->_onConnectedCallback();
+        }
+        this->streamConnectionEvent(ConnectionEvent::Kind::CONNECTED, {});
+    };
+    auto onDisconnected = [this](const std::string &message)
+    {
+        if (this->_onDisconnectedCallback)
+        {
+            this->_onDisconnectedCallback();
+        }
+        this->streamConnectionEvent(ConnectionEvent::Kind::DISCONNECTED, message);
+    };
+    auto onError = [this](const std::string &errorMessage)
+    {
+        if (this->_onErrorCallback)
+        {
+            this->_onErrorCallback(errorMessage);
+        }
+        this->streamConnectionEvent(ConnectionEvent::Kind::ERROR, errorMessage);
+    };
+
+    auto strand = _wsClientSessionImpl->openCallbackStrand();
+    if (strand == nullptr)
+    {
+        return _wsClientSessionImpl->connectAndStart([this](const std::string &message)
+                                                     { this->processDataMessage(message); },
+                                                     onConnected, onDisconnected, onError);
+    }
+    // the thread draining the socket only filters and copies the messages, parsing runs with the callbacks
+    return _wsClientSessionImpl->connectAndStart([this, strand](const std::string &message)
                                                  {
-                                                     if (this->_onErrorCallback)
+                                                     if (this->acceptsMessage(message))
                                                      {
-                                                         this->_onErrorCallback(errorMessage);
-                                                     }
-                                                 });
-}
+                                                         strand->post([this, message]()
+                                                                      { this->dispatchMessage(message); }, true);
+                                                     } },
+                                                 [strand, onConnected]()
+                                                 { strand->post(onConnected, false); },
+                                                 [strand, onDisconnected](const std::string &message)
+                                                 { strand->post([onDisconnected, message]()
+                                                                { onDisconnected(message); }, false); },
+                                                 [strand, onError](const std::string &errorMessage)
+                                                 { strand->post([onError, errorMessage]()
+                                                                { onError(errorMessage); }, false); });
+}
+
+namespace
+{
+    template <typename Event, typename Callback>
+    void dispatchEvent(const nlohmann::json &json, const Callback &callback, LiveEventStream *stream)
+    {
+        Event event = Event::fromJson(json);
+        if (callback)
+        {
+            callback(event);
+        }
+        if (stream != nullptr)
+        {
+            stream->push(LiveEvent(std::move(event)));
+        }
+    }
 
-void gladiapp::v2::ws::GladiaWebsocketClientSession::processDataMessage(const std::string &message) const
-{
-    try
+    std::uint32_t readLittleEndian(const char *bytes, std::size_t count)
     {
-        nlohmann::json json = nlohmann::json::parse(message);
-        if (json.contains("type"))
+        std::uint32_t value = 0;
+        for (std::size_t i = 0; i < count; ++i)
         {
-            std::string type = json["type"];
-            // Acknowledgment events
-            if (type == events::AUDIO_CHUNK)
-            {
-                response::AudioChunkAcknowledgment ack = response::AudioChunkAcknowledgment::fromJson(json);
-                if (_onAudioChunkAcknowledgedCallback)
-                {
-                    _onAudioChunkAcknowledgedCallback(ack);
-                }
-            }
-            else if (type == events::STOP_RECORDING)
-            {
-                response::StopRecordingAcknowledgment ack = response::StopRecordingAcknowledgment::fromJson(json);
-                if (_onStopRecordingAcknowledgmentCallback)
-                {
-                    _onStopRecordingAcknowledgmentCallback(ack);
-                }
-            }
-            // Speech event types
-            else if (type == events::SPEECH_START)
-            {
-                response::SpeechStarted event = response::SpeechStarted::fromJson(json);
-                if (_onSpeechStartedCallback)
-                {
-                    _onSpeechStartedCallback(event);
-                }
-            }
-            else if (type == events::SPEECH_END)
-            {
-                response::SpeechEnded event = response::SpeechEnded::fromJson(json);
-                if (_onSpeechEndedCallback)
-                {
-                    _onSpeechEndedCallback(event);
-                }
-            }
-            else if (type == events::TRANSCRIPT)
-            {
-                response::Transcript transcript = response::Transcript::fromJson(json);
-                if (_onTranscriptCallback)
-                {
-                    _onTranscriptCallback(transcript);
-                }
-            }
-            else if (type == events::TRANSLATION)
-            {
-                response::Translation translation = response::Translation::fromJson(json);
-                if (_onTranslationCallback)
-                {
-                    _onTranslationCallback(translation);
-                }
-            }
-            else if (type == events::NAMED_ENTITY_RECOGNITION)
-            {
-                response::NamedEntityRecognition ner = response::NamedEntityRecognition::fromJson(json);
-                if (_onNamedEntityRecognitionCallback)
-                {
-                    _onNamedEntityRecognitionCallback(ner);
-                }
-            }
-            else if (type == events::SENTIMENT_ANALYSIS)
-            {
-                response::SentimentAnalysis analysis = response::SentimentAnalysis::fromJson(json);
-                if (_onSentimentAnalysisCallback)
-                {
-                    _onSentimentAnalysisCallback(analysis);
-                }
-            }
-            // Post-processing event types
-            else if (type == events::POST_TRANSCRIPTION)
-            {
-                response::PostTranscript postTranscript = response::PostTranscript::fromJson(json);
-                if (_onPostTranscriptCallback)
-                {
-                    _onPostTranscriptCallback(postTranscript);
-                }
-            }
-            else if (type == events::FINAL_TRANSCRIPTION)
-            {
-                response::FinalTranscript finalTranscript = response::FinalTranscript::fromJson(json);
-                if (_onFinalTranscriptCallback)
-                {
-                    _onFinalTranscriptCallback(finalTranscript);
-                }
-            }
-            else if (type == events::CHAPTERIZATION)
-            {
-                response::Chapterization chapterization = response::Chapterization::fromJson(json);
-                if (_onChapterizationCallback)
-                {
-                    _onChapterizationCallback(chapterization);
-                }
-            }
-            else if (type == events::SUMMARIZATION)
+            value |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    /**
+     * Positions a WAV file on its audio data, warning when its format is not the session's.
+     * Files without a RIFF header are taken as raw audio.
+     */
+    bool skipWavHeader(std::istream &file, const gladiapp::v2::audio::AudioFormat &format)
+    {
+        char riff[12];
+        if (!file.read(riff, sizeof(riff)) || std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0)
+        {
+            file.clear();
+            file.seekg(0);
+            return static_cast<bool>(file);
+        }
+        char header[8];
+        while (file.read(header, sizeof(header)))
+        {
+            std::uint32_t size = readLittleEndian(header + 4, 4);
+            if (std::memcmp(header, "data", 4) == 0)
             {
-                response::Summarization summarization = response::Summarization::fromJson(json);
-                if (_onSummarizationCallback)
-                {
-                    _onSummarizationCallback(summarization);
-                }
+                return true;
             }
-            // Lifecycle event types
-            else if (type == events::START_SESSION)
+            if (std::memcmp(header, "fmt ", 4) == 0 && size >= 16)
             {
-                response::StartSession event = response::StartSession::fromJson(json);
-                if (_onStartSessionCallback)
+                char fmt[16];
+                if (!file.read(fmt, sizeof(fmt)))
                 {
-                    _onStartSessionCallback(event);
+                    return false;
                 }
-            }
-            else if (type == events::END_SESSION)
-            {
-                response::EndSession event = response::EndSession::fromJson(json);
-                if (_onEndSessionCallback)
+                int channels = static_cast<int>(readLittleEndian(fmt + 2, 2));
+                int sampleRate = static_cast<int>(readLittleEndian(fmt + 4, 4));
+                int bitDepth = static_cast<int>(readLittleEndian(fmt + 14, 2));
+                if (channels != format.channels || sampleRate != format.sampleRate || bitDepth != format.bitDepth)
                 {
-                    _onEndSessionCallback(event);
+                    spdlog::warn("WAV file is {} Hz, {} bits, {} channels but the session expects {} Hz, {} bits, {} channels",
+                                 sampleRate, bitDepth, channels, format.sampleRate, format.bitDepth, format.channels);
                 }
+                size -= 16;
             }
-            else if (type == events::START_RECORDING)
+            // chunks are padded to an even size
+            file.seekg(static_cast<std::streamoff>(size + (size & 1)), std::ios::cur);
+        }
+        return false;
+    }
+}
+
+void gladiapp::v2::ws::GladiaWebsocketClientSession::updateSubscription(events::EventType eventType, bool subscribed)
+{
+    std::uint32_t bit = 1u << static_cast<unsigned>(eventType);
+    if (subscribed)
+    {
+        _subscribedEvents.fetch_or(bit, std::memory_order_relaxed);
+    }
+    else
+    {
+        _subscribedEvents.fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::isSubscribed(events::EventType eventType) const
+{
+    return (_subscribedEvents.load(std::memory_order_relaxed) & (1u << static_cast<unsigned>(eventType))) != 0;
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::isStreamed(events::EventType eventType) const
+{
+    return (_streamedEvents & (1u << static_cast<unsigned>(eventType))) != 0;
+}
+
+void gladiapp::v2::ws::GladiaWebsocketClientSession::streamConnectionEvent(ConnectionEvent::Kind kind, const std::string &message) const
+{
+    if (_eventStream != nullptr)
+    {
+        _eventStream->push(LiveEvent(ConnectionEvent{kind, message}), true);
+    }
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::enableEventStream(const EventStreamOptions &options)
+{
+    if (_wsClientSessionImpl->isConnected())
+    {
+        spdlog::warn("The event stream must be enabled before connecting.");
+        return false;
+    }
+    std::uint32_t streamedEvents = 0;
+    for (const auto &name : options.eventTypes)
+    {
+        auto eventType = events::eventTypeFromName(name);
+        if (eventType == events::EventType::UNKNOWN)
+        {
+            spdlog::warn("Unknown event type {} ignored by the event stream.", name);
+            continue;
+        }
+        streamedEvents |= 1u << static_cast<unsigned>(eventType);
+    }
+    _streamedEvents = options.eventTypes.empty() ? (1u << static_cast<unsigned>(events::EventType::UNKNOWN)) - 1 : streamedEvents;
+    _eventStream = std::make_unique<LiveEventStream>(options);
+    return true;
+}
+
+std::size_t gladiapp::v2::ws::GladiaWebsocketClientSession::poll(LiveEvent *events, std::size_t maxEvents)
+{
+    return _eventStream != nullptr ? _eventStream->poll(events, maxEvents) : 0;
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::waitFor(std::chrono::milliseconds timeout)
+{
+    return _eventStream != nullptr && _eventStream->waitFor(timeout);
+}
+
+void gladiapp::v2::ws::GladiaWebsocketClientSession::takeNextEvent(std::function<void(LiveEvent &&event)> onEvent)
+{
+    if (_eventStream == nullptr)
+    {
+        onEvent(ConnectionEvent{ConnectionEvent::Kind::DISCONNECTED, "event stream disabled"});
+        return;
+    }
+    _eventStream->takeNext(std::move(onEvent));
+}
+
+EventStreamStats gladiapp::v2::ws::GladiaWebsocketClientSession::getEventStreamStats() const
+{
+    return _eventStream != nullptr ? _eventStream->stats() : EventStreamStats{};
+}
+
+void gladiapp::v2::ws::GladiaWebsocketClientSession::processDataMessage(const std::string &message) const
+{
+    if (acceptsMessage(message))
+    {
+        dispatchMessage(message);
+    }
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::acceptsMessage(const std::string &message) const
+{
+    // events nobody listens to are dropped before the DOM parse, unknown or unreadable types are parsed to be reported
+    std::string_view scannedType;
+    if (!json_util::TopLevelScanner(message).findString("type", scannedType))
+    {
+        return true;
+    }
+    auto eventType = events::eventTypeFromName(scannedType);
+    // acknowledgments release the replay buffer even without a callback
+    bool tracked = eventType == events::EventType::AUDIO_CHUNK && _wsClientSessionImpl->replaysAudio();
+    return eventType == events::EventType::UNKNOWN || isSubscribed(eventType) || isStreamed(eventType) || tracked;
+}
+
+void gladiapp::v2::ws::GladiaWebsocketClientSession::dispatchMessage(const std::string &message) const
+{
+    try
+    {
+        nlohmann::json json = nlohmann::json::parse(message);
+        auto typeField = json.find("type");
+        if (typeField == json.end())
+        {
+            spdlog::warn("Received message without 'type' field: {}", message);
+            return;
+        }
+        const std::string &type = typeField->get_ref<const std::string &>();
+        const auto eventType = events::eventTypeFromName(type);
+        LiveEventStream *stream = isStreamed(eventType) ? _eventStream.get() : nullptr;
+        switch (eventType)
+        {
+        // Acknowledgment events
+        case events::EventType::AUDIO_CHUNK:
+        {
+            auto acknowledgment = response::AudioChunkAcknowledgment::fromJson(json);
+            if (acknowledgment.acknowledged && acknowledgment.data.has_value() && acknowledgment.data->byte_range.size() == 2)
             {
-                response::StartRecording event = response::StartRecording::fromJson(json);
-                if (_onStartRecordingCallback)
-                {
-                    _onStartRecordingCallback(event);
-                }
+                _wsClientSessionImpl->acknowledgeAudio(static_cast<std::uint64_t>(acknowledgment.data->byte_range[1]));
             }
-            else if (type == events::END_RECORDING)
+            if (_onAudioChunkAcknowledgedCallback)
             {
-                response::EndRecording event = response::EndRecording::fromJson(json);
-                if (_onEndRecordingCallback)
-                {
-                    _onEndRecordingCallback(event);
-                }
+                _onAudioChunkAcknowledgedCallback(acknowledgment);
             }
-            else
+            if (stream != nullptr)
             {
-                spdlog::warn("Unknown event type received: {}", type);
+                stream->push(LiveEvent(std::move(acknowledgment)));
             }
+            break;
         }
-        else
-        {
-            spdlog::warn("Received message without 'type' field: {}", message);
+        case events::EventType::STOP_RECORDING:
+            dispatchEvent<response::StopRecordingAcknowledgment>(json, _onStopRecordingAcknowledgmentCallback, stream);
+            break;
+        // Speech event types
+        case events::EventType::SPEECH_START:
+            dispatchEvent<response::SpeechStarted>(json, _onSpeechStartedCallback, stream);
+            break;
+        case events::EventType::SPEECH_END:
+            dispatchEvent<response::SpeechEnded>(json, _onSpeechEndedCallback, stream);
+            break;
+        case events::EventType::TRANSCRIPT:
+            dispatchEvent<response::Transcript>(json, _onTranscriptCallback, stream);
+            break;
+        case events::EventType::TRANSLATION:
+            dispatchEvent<response::Translation>(json, _onTranslationCallback, stream);
+            break;
+        case events::EventType::NAMED_ENTITY_RECOGNITION:
+            dispatchEvent<response::NamedEntityRecognition>(json, _onNamedEntityRecognitionCallback, stream);
+            break;
+        case events::EventType::SENTIMENT_ANALYSIS:
+            dispatchEvent<response::SentimentAnalysis>(json, _onSentimentAnalysisCallback, stream);
+            break;
+        // Post-processing event types
+        case events::EventType::POST_TRANSCRIPTION:
+            dispatchEvent<response::PostTranscript>(json, _onPostTranscriptCallback, stream);
+            break;
+        case events::EventType::FINAL_TRANSCRIPTION:
+            dispatchEvent<response::FinalTranscript>(json, _onFinalTranscriptCallback, stream);
+            break;
+        case events::EventType::CHAPTERIZATION:
+            dispatchEvent<response::Chapterization>(json, _onChapterizationCallback, stream);
+            break;
+        case events::EventType::SUMMARIZATION:
+            dispatchEvent<response::Summarization>(json, _onSummarizationCallback, stream);
+            break;
+        // Lifecycle event types
+        case events::EventType::START_SESSION:
+            dispatchEvent<response::StartSession>(json, _onStartSessionCallback, stream);
+            break;
+        case events::EventType::END_SESSION:
+            dispatchEvent<response::EndSession>(json, _onEndSessionCallback, stream);
+            break;
+        case events::EventType::START_RECORDING:
+            dispatchEvent<response::StartRecording>(json, _onStartRecordingCallback, stream);
+            break;
+        case events::EventType::END_RECORDING:
+            dispatchEvent<response::EndRecording>(json, _onEndRecordingCallback, stream);
+            break;
+        case events::EventType::UNKNOWN:
+            spdlog::warn("Unknown event type received: {}", type);
+            break;
         }
     }
     catch (const nlohmann::json::exception &e)
@@ -278,9 +560,72 @@ bool gladiapp::v2::ws::GladiaWebsocketClientSession::sendStopSignal()
         spdlog::warn("WebSocket is not connected. Cannot send stop signal.");
         return false;
     }
-    nlohmann::json stopJson;
-    stopJson["type"] = "stop_recording";
-    return _wsClientSessionImpl->sendTextJson(stopJson.dump());
+    // sent once, queued behind the pending audio when the session has a send queue
+    return _wsClientSessionImpl->sendStopSignal();
+}
+
+AudioBuffer gladiapp::v2::ws::GladiaWebsocketClientSession::acquireAudioBuffer() const
+{
+    return _wsClientSessionImpl->acquireAudioBuffer();
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::submit(AudioBuffer &&buffer) const
+{
+    if (!_wsClientSessionImpl->isConnected())
+    {
+        spdlog::warn("WebSocket is not connected. Cannot submit audio buffer.");
+        return false;
+    }
+    auto onError = [this](const std::string &errorMessage)
+    {
+        if (this->_onErrorCallback)
+        {
+            this->_onErrorCallback(errorMessage);
+        }
+    };
+    if (_voiceActivityGate != nullptr && buffer)
+    {
+        // the buffer is only submitted as is when the gate keeps all of it, the parts kept otherwise are copied
+        bool keptWhole = false;
+        bool sent = _voiceActivityGate->process(buffer.data(), buffer.size(), [&](const uint8_t *data, std::size_t size)
+                                                {
+                                                    if (data == buffer.data() && size == buffer.size())
+                                                    {
+                                                        keptWhole = true;
+                                                        return true;
+                                                    }
+                                                    return _wsClientSessionImpl->sendAudioBinary(data, static_cast<int>(size), onError); });
+        if (!keptWhole)
+        {
+            return sent;
+        }
+    }
+    return _wsClientSessionImpl->submitAudio(std::move(buffer), onError);
+}
+
+SendQueueStats gladiapp::v2::ws::GladiaWebsocketClientSession::getSendQueueStats() const
+{
+    return _wsClientSessionImpl->getSendQueueStats();
+}
+
+void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnSendQueueHighWaterCallback(const OnSendQueueHighWaterCallback &callback)
+{
+    _onSendQueueHighWaterCallback = callback;
+}
+
+ReconnectStats gladiapp::v2::ws::GladiaWebsocketClientSession::getReconnectStats() const
+{
+    return _wsClientSessionImpl->getReconnectStats();
+}
+
+SessionStartTiming gladiapp::v2::ws::GladiaWebsocketClientSession::getStartTiming() const
+{
+    return _wsClientSessionImpl->getStartTiming();
+}
+
+CallbackExecutorStats gladiapp::v2::ws::GladiaWebsocketClientSession::getCallbackExecutorStats() const
+{
+    return _wsClientSessionImpl->getCallbackExecutorStats();
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::disconnect()
@@ -300,12 +645,57 @@ bool gladiapp::v2::ws::GladiaWebsocketClientSession::sendAudioBinary(const uint8
         spdlog::warn("WebSocket is not connected. Cannot send audio binary.");
         return false;
     }
-    return _wsClientSessionImpl->sendAudioBinary(audioData, size, [this](const std::string &errorMessage)
-                                                 {
-                                                         if (this->_onErrorCallback)
-                                                         {
-                                                             this->_onErrorCallback(errorMessage);
-                                                         } });
+    auto onError = [this](const std::string &errorMessage)
+    {
+        if (this->_onErrorCallback)
+        {
+            this->_onErrorCallback(errorMessage);
+        }
+    };
+    if (_voiceActivityGate != nullptr && size > 0)
+    {
+        return _voiceActivityGate->process(audioData, static_cast<std::size_t>(size), [&](const uint8_t *data, std::size_t length)
+                                           { return _wsClientSessionImpl->sendAudioBinary(data, static_cast<int>(length), onError); });
+    }
+    return _wsClientSessionImpl->sendAudioBinary(audioData, size, onError);
+}
+
+void gladiapp::v2::ws::GladiaWebsocketClientSession::setAudioFormat(const audio::AudioFormat &format)
+{
+    _audioFormat = format;
+    _audioConverter.reset();
+    _wsClientSessionImpl->setAudioBytesPerSecond(format.bytesPerSecond());
+    if (_voiceActivityGate != nullptr)
+    {
+        _voiceActivityGate = std::make_unique<VoiceActivityGate>(_voiceActivityGateOptions, _audioFormat);
+    }
+}
+
+const gladiapp::v2::audio::AudioFormat &gladiapp::v2::ws::GladiaWebsocketClientSession::getAudioFormat() const
+{
+    return _audioFormat;
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::sendAudioFloat(const float *samples, std::size_t frameCount, int sampleRate, int channels)
+{
+    if (!_audioConverter || _audioConverter->inputSampleRate() != sampleRate || _audioConverter->inputChannels() != channels)
+    {
+        try
+        {
+            _audioConverter = std::make_unique<audio::AudioConverter>(sampleRate, channels, _audioFormat);
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("Cannot convert audio to the session format: {}", e.what());
+            return false;
+        }
+    }
+    _convertedAudio.clear();
+    if (_audioConverter->convert(samples, frameCount, _convertedAudio) == 0)
+    {
+        return true;
+    }
+    return sendAudioBinary(_convertedAudio.data(), static_cast<int>(_convertedAudio.size()));
 }
 
 bool gladiapp::v2::ws::GladiaWebsocketClientSession::sendAudioJson(const uint8_t *audioData, int size) const
@@ -315,68 +705,180 @@ bool gladiapp::v2::ws::GladiaWebsocketClientSession::sendAudioJson(const uint8_t
         spdlog::warn("WebSocket is not connected. Cannot send audio JSON.");
         return false;
     }
-    nlohmann::json audioJson;
-    audioJson["type"] = "audio_chunk";
-    std::string binaryData(reinterpret_cast<const char *>(audioData), size);
-    nlohmann::json chunk;
-    chunk["chunk"] = base64::to_base64(binaryData);
-    audioJson["data"] = chunk;
-    return _wsClientSessionImpl->sendTextJson(audioJson.dump(), [this](const std::string &errorMessage)
+    if (size < 0)
+    {
+        spdlog::warn("Invalid audio size: {}", size);
+        return false;
+    }
+    if (_voiceActivityGate != nullptr && size > 0)
+    {
+        return _voiceActivityGate->process(audioData, static_cast<std::size_t>(size), [this](const uint8_t *data, std::size_t length)
+                                           { return sendAudioJsonChunk(data, static_cast<int>(length)); });
+    }
+    return sendAudioJsonChunk(audioData, size);
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::streamAudio(std::vector<uint8_t> audio, const AudioPacingOptions &options,
+                                                                 const OnStreamFinishedCallback &onFinished)
+{
+    return startPacer(options, onFinished, [&audio](AudioPacer &pacer)
+                      { pacer.start(std::move(audio)); });
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::streamAudioFile(const std::string &filePath, const AudioPacingOptions &options,
+                                                                     const OnStreamFinishedCallback &onFinished)
+{
+    auto file = std::make_unique<std::ifstream>(filePath, std::ios::binary);
+    if (!*file)
+    {
+        spdlog::error("Cannot open audio file: {}", filePath);
+        return false;
+    }
+    if (!skipWavHeader(*file, _audioFormat))
+    {
+        spdlog::error("Invalid WAV file: {}", filePath);
+        return false;
+    }
+    return startPacer(options, onFinished, [&file](AudioPacer &pacer)
+                      { pacer.start(std::move(file)); });
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::startPacer(const AudioPacingOptions &options, const OnStreamFinishedCallback &onFinished,
+                                                                const std::function<void(AudioPacer &)> &startSource)
+{
+    if (!_wsClientSessionImpl->isConnected())
+    {
+        spdlog::warn("WebSocket is not connected. Cannot stream audio.");
+        return false;
+    }
+    if (!(options.speed > 0.0) || options.chunkMs == 0)
+    {
+        spdlog::warn("Invalid audio pacing: speed {}, chunk {} ms", options.speed, options.chunkMs);
+        return false;
+    }
+    stopStreaming();
+    // the chunks are sent from the shared timer thread, which only hands them to the writer
+    _wsClientSessionImpl->ensureSendQueue();
+
+    const std::size_t blockAlign = _audioFormat.bytesPerSample() * static_cast<std::size_t>(std::max(_audioFormat.channels, 1));
+    const std::size_t bytesPerSecond = _audioFormat.bytesPerSecond();
+    const std::size_t chunkBytes = std::max<std::size_t>(bytesPerSecond * options.chunkMs / 1000 / blockAlign, 1) * blockAlign;
+    const std::chrono::duration<double> interval(static_cast<double>(chunkBytes) / static_cast<double>(bytesPerSecond) / options.speed);
+    _audioPacer = std::make_shared<AudioPacer>(TimerWheel::shared(), chunkBytes, interval,
+                                               [this](const uint8_t *data, std::size_t size)
+                                               { return sendAudioBinary(data, static_cast<int>(size)); },
+                                               onFinished);
+    startSource(*_audioPacer);
+    return true;
+}
+
+void gladiapp::v2::ws::GladiaWebsocketClientSession::stopStreaming()
+{
+    if (_audioPacer != nullptr)
+    {
+        _audioPacer->stop();
+    }
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::isStreaming() const
+{
+    return _audioPacer != nullptr && _audioPacer->isRunning();
+}
+
+void gladiapp::v2::ws::GladiaWebsocketClientSession::enableVoiceActivityGate(const VoiceActivityGateOptions &options)
+{
+    _voiceActivityGateOptions = options;
+    _voiceActivityGate = std::make_unique<VoiceActivityGate>(options, _audioFormat);
+}
+
+VoiceActivityGateStats gladiapp::v2::ws::GladiaWebsocketClientSession::getVoiceActivityGateStats() const
+{
+    return _voiceActivityGate != nullptr ? _voiceActivityGate->stats() : VoiceActivityGateStats{};
+}
+
+double gladiapp::v2::ws::GladiaWebsocketClientSession::toCaptureTime(double sessionSeconds) const
+{
+    return _voiceActivityGate != nullptr ? _voiceActivityGate->toCaptureTime(sessionSeconds) : sessionSeconds;
+}
+
+bool gladiapp::v2::ws::GladiaWebsocketClientSession::sendAudioJsonChunk(const uint8_t *audioData, int size) const
+{
+    // the envelope is written around the encoded chunk in one pass, in a buffer reused by the calling thread
+    static constexpr std::string_view prefix = R"({"type":"audio_chunk","data":{"chunk":")";
+    static constexpr std::string_view suffix = R"("}})";
+    thread_local std::string frame;
+    std::size_t encodedSize = base64_util::encodedLength(static_cast<std::size_t>(size));
+    frame.resize(prefix.size() + encodedSize + suffix.size());
+    prefix.copy(frame.data(), prefix.size());
+    base64_util::encode(audioData, static_cast<std::size_t>(size), frame.data() + prefix.size());
+    suffix.copy(frame.data() + prefix.size() + encodedSize, suffix.size());
+    return _wsClientSessionImpl->sendTextJson(frame, [this](const std::string &errorMessage)
                                               {
                                                          if (this->_onErrorCallback)
                                                          {
                                                              this->_onErrorCallback(errorMessage);
-                                                         } });
+                                                         } },
+                                              static_cast<std::size_t>(size));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnPostTranscriptCallback(const OnPostTranscriptCallback &callback)
 {
     _onPostTranscriptCallback = callback;
+    updateSubscription(events::EventType::POST_TRANSCRIPTION, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnFinalTranscriptCallback(const OnFinalTranscriptCallback &callback)
 {
     _onFinalTranscriptCallback = callback;
+    updateSubscription(events::EventType::FINAL_TRANSCRIPTION, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnChapterizationCallback(const OnChapterizationCallback &callback)
 {
     _onChapterizationCallback = callback;
+    updateSubscription(events::EventType::CHAPTERIZATION, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnSummarizationCallback(const OnSummarizationCallback &callback)
 {
     _onSummarizationCallback = callback;
+    updateSubscription(events::EventType::SUMMARIZATION, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnAudioChunkAcknowledgedCallback(const OnAudioChunkAcknowledgedCallback &callback)
 {
     _onAudioChunkAcknowledgedCallback = callback;
+    updateSubscription(events::EventType::AUDIO_CHUNK, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnStopRecordingAcknowledgedCallback(const OnStopRecordingAcknowledgmentCallback &callback)
 {
     _onStopRecordingAcknowledgmentCallback = callback;
+    updateSubscription(events::EventType::STOP_RECORDING, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnStartSessionCallback(const OnStartSessionCallback &callback)
 {
     _onStartSessionCallback = callback;
+    updateSubscription(events::EventType::START_SESSION, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnStartRecordingCallback(const OnStartRecordingCallback &callback)
 {
     _onStartRecordingCallback = callback;
+    updateSubscription(events::EventType::START_RECORDING, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnEndRecordingCallback(const OnEndRecordingCallback &callback)
 {
     _onEndRecordingCallback = callback;
+    updateSubscription(events::EventType::END_RECORDING, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnEndSessionCallback(const OnEndSessionCallback &callback)
 {
     _onEndSessionCallback = callback;
+    updateSubscription(events::EventType::END_SESSION, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnConnectedCallback(const OnConnectivityCallback &callback)
@@ -389,6 +891,11 @@ void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnDisconnectedCallback(c
     _onDisconnectedCallback = callback;
 }
 
+void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnReconnectedCallback(const OnConnectivityCallback &callback)
+{
+    _onReconnectedCallback = callback;
+}
+
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnErrorCallback(const OnErrorCallback &callback)
 {
     _onErrorCallback = callback;
@@ -397,24 +904,35 @@ void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnErrorCallback(const On
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnSpeechStartedCallback(const OnSpeechEventCallback &callback)
 {
     _onSpeechStartedCallback = callback;
+    updateSubscription(events::EventType::SPEECH_START, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnSpeechEndedCallback(const OnSpeechEventCallback &callback)
 {
     _onSpeechEndedCallback = callback;
+    updateSubscription(events::EventType::SPEECH_END, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnTranscriptCallback(const OnTranscriptCallback &callback)
 {
     _onTranscriptCallback = callback;
+    updateSubscription(events::EventType::TRANSCRIPT, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnTranslationCallback(const OnTranslationCallback &callback)
 {
     _onTranslationCallback = callback;
+    updateSubscription(events::EventType::TRANSLATION, static_cast<bool>(callback));
 }
 
 void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnNamedEntityRecognitionCallback(const OnNamedEntityRecognitionCallback &callback)
 {
     _onNamedEntityRecognitionCallback = callback;
+    updateSubscription(events::EventType::NAMED_ENTITY_RECOGNITION, static_cast<bool>(callback));
+}
+
+void gladiapp::v2::ws::GladiaWebsocketClientSession::setOnSentimentAnalysisCallback(const OnSentimentAnalysisCallback &callback)
+{
+    _onSentimentAnalysisCallback = callback;
+    updateSubscription(events::EventType::SENTIMENT_ANALYSIS, static_cast<bool>(callback));
 }
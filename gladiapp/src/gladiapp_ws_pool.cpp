@@ -0,0 +1,27 @@
+#include "../include/gladiapp/gladiapp_ws_pool.hpp"
+#include "../include/gladiapp/impl/gladia_ws_pool_impl.hpp"
+
+gladiapp::v2::ws::LiveSessionPool::LiveSessionPool(const GladiaWebsocketClient &client, const LiveSessionPoolOptions &options)
+{
+    _sessionPoolImpl = std::make_unique<LiveSessionPoolImpl>(client, options);
+}
+
+gladiapp::v2::ws::LiveSessionPool::~LiveSessionPool()
+{
+}
+
+void gladiapp::v2::ws::LiveSessionPool::prewarm(const request::InitializeSessionRequest &initRequest)
+{
+    _sessionPoolImpl->prewarm(initRequest);
+}
+
+std::unique_ptr<gladiapp::v2::ws::GladiaWebsocketClientSession> gladiapp::v2::ws::LiveSessionPool::acquire(const request::InitializeSessionRequest &initRequest,
+                                                                                                          gladiapp::v2::response::TranscriptionError *error)
+{
+    return _sessionPoolImpl->acquire(initRequest, error);
+}
+
+gladiapp::v2::ws::LiveSessionPoolStats gladiapp::v2::ws::LiveSessionPool::getStats() const
+{
+    return _sessionPoolImpl->getStats();
+}
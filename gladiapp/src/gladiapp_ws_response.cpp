@@ -1,4 +1,5 @@
 #include "gladiapp_ws_response.hpp"
+#include "impl/simdjson_result_parser.hpp"
 #include <spdlog/spdlog.h>
 
 using namespace gladiapp::v2::ws::response;
@@ -756,6 +757,18 @@ gladiapp::v2::ws::response::LiveTranscriptionResult gladiapp::v2::ws::response::
     return liveTranscriptionResult;
 }
 
+gladiapp::v2::ws::response::LiveTranscriptionResult gladiapp::v2::ws::response::LiveTranscriptionResult::fromJsonString(const std::string &jsonString)
+{
+#ifdef GLADIAPP_USE_SIMDJSON
+    LiveTranscriptionResult liveTranscriptionResult;
+    if (gladiapp::v2::simdjson_util::parse(jsonString, liveTranscriptionResult))
+    {
+        return liveTranscriptionResult;
+    }
+#endif
+    return fromJson(nlohmann::json::parse(jsonString));
+}
+
 gladiapp::v2::ws::response::LiveTranscriptionResult::Result::TranslationResult::Result gladiapp::v2::ws::response::LiveTranscriptionResult::Result::TranslationResult::Result::fromJson(const nlohmann::json &json)
 {
     Result result;
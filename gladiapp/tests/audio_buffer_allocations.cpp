@@ -0,0 +1,158 @@
+/**
+ * Heap allocations of the pooled audio path: after a warm-up, chunks filled through acquireAudioBuffer() and
+ * sent with submit() must not allocate, whether written synchronously or through a send queue. Every C++
+ * allocation of the process is counted (the session's threads included) by replacing operator new; libcurl's
+ * own mallocs are not.
+ * Usage: audio_buffer_allocations
+ */
+#include "gladiapp_ws.hpp"
+#include "loopback_websocket_server.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+
+namespace
+{
+    std::atomic<std::size_t> allocations{0};
+}
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    if (void *memory = std::malloc(size != 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    ++allocations;
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void *memory = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+using namespace gladiapp::v2::ws;
+
+namespace
+{
+    int failures = 0;
+
+    constexpr std::size_t CHUNK_BYTES = 3200;
+    constexpr std::size_t WARM_UP_CHUNKS = 256;
+    constexpr std::size_t MEASURED_CHUNKS = 2000;
+
+    void check(const std::string &what, bool condition)
+    {
+        if (!condition)
+        {
+            std::cerr << "failed: " << what << std::endl;
+            ++failures;
+        }
+    }
+
+    bool submitChunks(GladiaWebsocketClientSession &session, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            AudioBuffer buffer = session.acquireAudioBuffer();
+            buffer.resize(CHUNK_BYTES);
+            std::memset(buffer.data(), static_cast<int>(i), CHUNK_BYTES);
+            if (!session.submit(std::move(buffer)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Waits for the server to have read every submitted byte, so that the writer thread is done too.
+     */
+    bool waitForBytes(const gladiapp_tests::LoopbackWebsocketServer &server, std::size_t bytes)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (server.binaryBytes() < bytes)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    void measure(const std::string &mode, std::size_t queueCapacity)
+    {
+        gladiapp_tests::LoopbackWebsocketServer server;
+        WebsocketClientOptions options;
+        options.sendQueue.capacity = queueCapacity;
+        response::InitializeSessionResponse initResponse;
+        initResponse.id = "allocations";
+        initResponse.url = server.url();
+        GladiaWebsocketClientSession session(initResponse, "", nullptr, options);
+        if (!session.connectAndStart())
+        {
+            check(mode + ": connect to the loopback server", false);
+            return;
+        }
+
+        check(mode + ": warm-up chunks submitted", submitChunks(session, WARM_UP_CHUNKS));
+        check(mode + ": warm-up chunks received", waitForBytes(server, WARM_UP_CHUNKS * CHUNK_BYTES));
+
+        const std::size_t before = allocations;
+        const bool submitted = submitChunks(session, MEASURED_CHUNKS);
+        const bool received = waitForBytes(server, (WARM_UP_CHUNKS + MEASURED_CHUNKS) * CHUNK_BYTES);
+        const std::size_t allocated = allocations - before;
+
+        check(mode + ": chunks submitted", submitted);
+        check(mode + ": chunks received", received);
+        std::cout << mode << ": " << allocated << " allocation(s) for " << MEASURED_CHUNKS << " chunks" << std::endl;
+        check(mode + ": no allocation per chunk", allocated == 0);
+    }
+}
+
+int main()
+{
+    measure("synchronous", 0);
+    measure("send queue", 64);
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * Offsets of the reconnection replay buffer: acknowledged byte ranges release the right bytes when binary audio,
+ * audio sent as JSON (skipped, not kept) and ring overflow are mixed, and a replay sends the unacknowledged bytes
+ * held in order, counts the others as lost and numbers the stream from the last acknowledgment again.
+ * Usage: audio_replay_buffer
+ */
+#include "impl/audio_replay_buffer.hpp"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace gladiapp::v2::ws;
+
+namespace
+{
+    int failures = 0;
+
+    void check(const std::string &what, bool condition)
+    {
+        if (!condition)
+        {
+            std::cerr << "failed: " << what << std::endl;
+            ++failures;
+        }
+    }
+
+    /**
+     * Bytes of the test stream, their value derived from their offset.
+     */
+    std::vector<uint8_t> streamBytes(std::uint64_t offset, std::size_t size)
+    {
+        std::vector<uint8_t> bytes(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            bytes[i] = static_cast<uint8_t>((offset + i) % 251);
+        }
+        return bytes;
+    }
+
+    void append(AudioReplayBuffer &buffer, std::uint64_t offset, std::size_t size)
+    {
+        auto bytes = streamBytes(offset, size);
+        buffer.append(bytes.data(), bytes.size());
+    }
+
+    std::vector<uint8_t> replay(AudioReplayBuffer &buffer, std::size_t frameBytes = 7)
+    {
+        std::vector<uint8_t> sent;
+        buffer.replay(frameBytes, [&sent](const uint8_t *data, std::size_t size)
+                      {
+                          sent.insert(sent.end(), data, data + size);
+                          return true; });
+        return sent;
+    }
+
+    void binaryOnly()
+    {
+        AudioReplayBuffer buffer(1000);
+        append(buffer, 0, 300);
+        append(buffer, 300, 300);
+        buffer.acknowledge(250);
+        check("binary: the unacknowledged bytes are replayed", replay(buffer) == streamBytes(250, 350));
+        check("binary: nothing lost", buffer.lostBytes() == 0);
+        buffer.acknowledge(600);
+        check("binary: nothing left after the last acknowledgment", replay(buffer).empty());
+        check("binary: replayed bytes counted", buffer.replayedBytes() == 350);
+    }
+
+    void jsonBetweenBinary()
+    {
+        AudioReplayBuffer buffer(1000);
+        append(buffer, 0, 100);
+        buffer.skip(50);
+        append(buffer, 150, 100);
+        // the server's range covers the JSON audio: the first binary frame and part of the JSON one
+        buffer.acknowledge(120);
+        check("json: the binary audio after the JSON audio is kept", replay(buffer) == streamBytes(150, 100));
+        check("json: the unacknowledged JSON audio is lost", buffer.lostBytes() == 30);
+
+        // the server numbers the replayed bytes from 120
+        append(buffer, 250, 20);
+        buffer.acknowledge(220);
+        check("json: offsets follow the server after a replay", replay(buffer) == streamBytes(250, 20));
+        buffer.acknowledge(240);
+        check("json: released by the server's next range", replay(buffer).empty());
+    }
+
+    void jsonAcknowledged()
+    {
+        AudioReplayBuffer buffer(1000);
+        buffer.skip(64);
+        buffer.skip(64);
+        append(buffer, 128, 200);
+        buffer.acknowledge(128);
+        check("json first: the binary audio is replayed whole", replay(buffer) == streamBytes(128, 200));
+        check("json first: nothing lost once the JSON audio is acknowledged", buffer.lostBytes() == 0);
+    }
+
+    void overflow()
+    {
+        AudioReplayBuffer buffer(100);
+        append(buffer, 0, 60);
+        buffer.skip(20);
+        append(buffer, 80, 60);
+        // 20 bytes of the first frame made room: 20 dropped and 20 skipped bytes lost
+        check("overflow: the bytes held are replayed", replay(buffer) == [] {
+            auto bytes = streamBytes(20, 40);
+            auto tail = streamBytes(80, 60);
+            bytes.insert(bytes.end(), tail.begin(), tail.end());
+            return bytes; }());
+        check("overflow: dropped and skipped bytes lost", buffer.lostBytes() == 40);
+
+        // the server received the 100 bytes replayed as [0, 100)
+        append(buffer, 140, 20);
+        buffer.acknowledge(100);
+        check("overflow: offsets follow the server after a replay", replay(buffer) == streamBytes(140, 20));
+        check("overflow: nothing more lost", buffer.lostBytes() == 40);
+
+        AudioReplayBuffer small(10);
+        append(small, 0, 25);
+        check("larger than the ring: its end is held", replay(small) == streamBytes(15, 10));
+        check("larger than the ring: its start is lost", small.lostBytes() == 15);
+    }
+
+    void resize()
+    {
+        AudioReplayBuffer buffer(100);
+        append(buffer, 0, 40);
+        buffer.skip(10);
+        append(buffer, 50, 40);
+        buffer.setCapacity(50);
+        buffer.acknowledge(30);
+        check("resize: the most recent bytes are kept", replay(buffer) == [] {
+            auto bytes = streamBytes(30, 10);
+            auto tail = streamBytes(50, 40);
+            bytes.insert(bytes.end(), tail.begin(), tail.end());
+            return bytes; }());
+        check("resize: skipped bytes lost", buffer.lostBytes() == 10);
+    }
+}
+
+int main()
+{
+    binaryOnly();
+    jsonBetweenBinary();
+    jsonAcknowledged();
+    overflow();
+    resize();
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
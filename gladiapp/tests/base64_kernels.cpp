@@ -0,0 +1,121 @@
+/**
+ * Differential test of the base64 encoders: the AVX2, SSSE3 and scalar kernels (those this CPU has) and the
+ * runtime-selected encode() are compared with a byte-at-a-time reference on every length from 0 to
+ * MAX_LENGTH, from aligned and unaligned input, and must not write past encodedLength().
+ * Usage: base64_kernels
+ */
+#include "impl/base64_encoder.hpp"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gladiapp::v2;
+
+namespace
+{
+    int failures = 0;
+
+    constexpr std::size_t MAX_LENGTH = 1024;
+    constexpr std::size_t GUARD_BYTES = 64;
+    constexpr char GUARD = '\x7f';
+
+    std::string reference(const std::uint8_t *data, std::size_t size)
+    {
+        static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        std::uint32_t bits = 0;
+        int pending = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            bits = bits << 8 | data[i];
+            pending += 8;
+            while (pending >= 6)
+            {
+                pending -= 6;
+                out += alphabet[(bits >> pending) & 63];
+            }
+        }
+        if (pending > 0)
+        {
+            out += alphabet[(bits << (6 - pending)) & 63];
+        }
+        while (out.size() % 4 != 0)
+        {
+            out += '=';
+        }
+        return out;
+    }
+
+    void checkEncoder(const std::string &name, base64_util::EncodeFunction encode, const std::vector<std::uint8_t> &input)
+    {
+        std::vector<char> out;
+        for (std::size_t offset = 0; offset < 2; ++offset)
+        {
+            for (std::size_t length = 0; length <= MAX_LENGTH; ++length)
+            {
+                const std::uint8_t *data = input.data() + offset;
+                const std::size_t encoded = base64_util::encodedLength(length);
+                out.assign(encoded + GUARD_BYTES, GUARD);
+                encode(data, length, out.data());
+                const std::string expected = reference(data, length);
+                bool matches = expected.size() == encoded && std::string(out.data(), encoded) == expected;
+                bool guarded = true;
+                for (std::size_t i = encoded; i < out.size(); ++i)
+                {
+                    guarded = guarded && out[i] == GUARD;
+                }
+                if (!matches || !guarded)
+                {
+                    std::cerr << "failed: " << name << ", " << length << " bytes at offset " << offset
+                              << (matches ? " wrote past the encoding" : " differs from the reference") << std::endl;
+                    ++failures;
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::vector<std::uint8_t> input(MAX_LENGTH + 1);
+    std::mt19937 random(20260917);
+    for (auto &byte : input)
+    {
+        byte = static_cast<std::uint8_t>(random());
+    }
+    // every byte value in the first blocks, so each alphabet entry and both ends of the ranges are hit
+    for (std::size_t i = 0; i < 256; ++i)
+    {
+        input[i] = static_cast<std::uint8_t>(i);
+    }
+
+    if (reference(reinterpret_cast<const std::uint8_t *>("foobar"), 6) != "Zm9vYmFy" ||
+        reference(reinterpret_cast<const std::uint8_t *>("fooba"), 5) != "Zm9vYmE=" ||
+        reference(reinterpret_cast<const std::uint8_t *>("foob"), 4) != "Zm9vYg==")
+    {
+        std::cerr << "failed: reference encoder against RFC 4648 vectors" << std::endl;
+        ++failures;
+    }
+
+    for (const char *name : {"scalar", "ssse3", "avx2"})
+    {
+        base64_util::EncodeFunction encode = base64_util::encoderFor(name);
+        if (encode == nullptr)
+        {
+            std::cout << name << ": not available, skipped" << std::endl;
+            continue;
+        }
+        checkEncoder(name, encode, input);
+        std::cout << name << ": checked" << std::endl;
+    }
+    checkEncoder(std::string("encode() (") + base64_util::encoderName() + ")", base64_util::encode, input);
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " encoding(s) differ from the reference" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,326 @@
+#pragma once
+
+/**
+ * Minimal WebSocket server on 127.0.0.1 for the session tests: it answers the opening handshake, reads the
+ * client's frames (counting the binary payload bytes) and answers a close frame, unless built to ignore it
+ * like a stalled peer. It never sends data frames, so an open connection stays idle. Reading a frame does not allocate once the largest frame has been seen.
+ * POSIX sockets only.
+ */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace gladiapp_tests
+{
+    namespace detail
+    {
+        inline std::array<uint8_t, 20> sha1(const std::string &message)
+        {
+            uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+            std::vector<uint8_t> data(message.begin(), message.end());
+            const uint64_t bitLength = static_cast<uint64_t>(data.size()) * 8;
+            data.push_back(0x80);
+            while (data.size() % 64 != 56)
+            {
+                data.push_back(0);
+            }
+            for (int shift = 56; shift >= 0; shift -= 8)
+            {
+                data.push_back(static_cast<uint8_t>(bitLength >> shift));
+            }
+            auto rotl = [](uint32_t value, int bits)
+            { return (value << bits) | (value >> (32 - bits)); };
+            for (std::size_t block = 0; block < data.size(); block += 64)
+            {
+                uint32_t w[80];
+                for (int i = 0; i < 16; ++i)
+                {
+                    w[i] = static_cast<uint32_t>(data[block + 4 * i]) << 24 | static_cast<uint32_t>(data[block + 4 * i + 1]) << 16 |
+                           static_cast<uint32_t>(data[block + 4 * i + 2]) << 8 | static_cast<uint32_t>(data[block + 4 * i + 3]);
+                }
+                for (int i = 16; i < 80; ++i)
+                {
+                    w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+                }
+                uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+                for (int i = 0; i < 80; ++i)
+                {
+                    uint32_t f, k;
+                    if (i < 20)
+                    {
+                        f = (b & c) | (~b & d);
+                        k = 0x5A827999;
+                    }
+                    else if (i < 40)
+                    {
+                        f = b ^ c ^ d;
+                        k = 0x6ED9EBA1;
+                    }
+                    else if (i < 60)
+                    {
+                        f = (b & c) | (b & d) | (c & d);
+                        k = 0x8F1BBCDC;
+                    }
+                    else
+                    {
+                        f = b ^ c ^ d;
+                        k = 0xCA62C1D6;
+                    }
+                    uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+                    e = d;
+                    d = c;
+                    c = rotl(b, 30);
+                    b = a;
+                    a = temp;
+                }
+                h[0] += a;
+                h[1] += b;
+                h[2] += c;
+                h[3] += d;
+                h[4] += e;
+            }
+            std::array<uint8_t, 20> digest{};
+            for (int i = 0; i < 20; ++i)
+            {
+                digest[i] = static_cast<uint8_t>(h[i / 4] >> (24 - 8 * (i % 4)));
+            }
+            return digest;
+        }
+
+        inline std::string base64(const uint8_t *data, std::size_t size)
+        {
+            static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            std::string out;
+            for (std::size_t i = 0; i < size; i += 3)
+            {
+                uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+                if (i + 1 < size)
+                {
+                    group |= static_cast<uint32_t>(data[i + 1]) << 8;
+                }
+                if (i + 2 < size)
+                {
+                    group |= data[i + 2];
+                }
+                out += alphabet[(group >> 18) & 63];
+                out += alphabet[(group >> 12) & 63];
+                out += i + 1 < size ? alphabet[(group >> 6) & 63] : '=';
+                out += i + 2 < size ? alphabet[group & 63] : '=';
+            }
+            return out;
+        }
+    }
+
+    class LoopbackWebsocketServer
+    {
+    public:
+        explicit LoopbackWebsocketServer(bool answerClose = true)
+            : _answerClose(answerClose)
+        {
+            _listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t length = sizeof(address);
+            if (_listenFd < 0 || ::bind(_listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+                ::listen(_listenFd, 64) != 0 || ::getsockname(_listenFd, reinterpret_cast<sockaddr *>(&address), &length) != 0)
+            {
+                throw std::runtime_error("cannot listen on 127.0.0.1");
+            }
+            _port = ntohs(address.sin_port);
+            _acceptThread = std::thread([this]()
+                                        { acceptLoop(); });
+        }
+
+        ~LoopbackWebsocketServer()
+        {
+            _running = false;
+            ::shutdown(_listenFd, SHUT_RDWR);
+            _acceptThread.join();
+            ::close(_listenFd);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (int fd : _connections)
+                {
+                    ::shutdown(fd, SHUT_RDWR);
+                }
+            }
+            for (auto &thread : _connectionThreads)
+            {
+                thread.join();
+            }
+        }
+
+        std::string url() const
+        {
+            return "ws://127.0.0.1:" + std::to_string(_port) + "/";
+        }
+
+        std::size_t binaryBytes() const
+        {
+            return _binaryBytes;
+        }
+
+        std::size_t handshakes() const
+        {
+            return _handshakes;
+        }
+
+    private:
+        void acceptLoop()
+        {
+            while (_running)
+            {
+                int fd = ::accept(_listenFd, nullptr, nullptr);
+                if (fd < 0)
+                {
+                    if (!_running)
+                    {
+                        return;
+                    }
+                    continue;
+                }
+                std::lock_guard<std::mutex> lock(_mutex);
+                _connections.push_back(fd);
+                _connectionThreads.emplace_back([this, fd]()
+                                                { serve(fd); });
+            }
+        }
+
+        bool readFully(int fd, uint8_t *data, std::size_t size)
+        {
+            while (size > 0)
+            {
+                ssize_t received = ::recv(fd, data, size, 0);
+                if (received <= 0)
+                {
+                    return false;
+                }
+                data += received;
+                size -= static_cast<std::size_t>(received);
+            }
+            return true;
+        }
+
+        bool handshake(int fd)
+        {
+            std::string request;
+            char buffer[1024];
+            while (request.find("\r\n\r\n") == std::string::npos)
+            {
+                ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+                if (received <= 0)
+                {
+                    return false;
+                }
+                request.append(buffer, static_cast<std::size_t>(received));
+            }
+            std::string lowered = request;
+            std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char c)
+                           { return static_cast<char>(std::tolower(c)); });
+            const std::string header = "sec-websocket-key:";
+            std::size_t start = lowered.find(header);
+            if (start == std::string::npos)
+            {
+                return false;
+            }
+            start += header.size();
+            std::size_t end = request.find("\r\n", start);
+            std::string key = request.substr(start, end - start);
+            key.erase(0, key.find_first_not_of(' '));
+            key.erase(key.find_last_not_of(' ') + 1);
+            auto digest = detail::sha1(key + "258EAFA5-E914-47DA-95CA-C5AB0DC11B85");
+            std::string response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                   "Sec-WebSocket-Accept: " +
+                                   detail::base64(digest.data(), digest.size()) + "\r\n\r\n";
+            return ::send(fd, response.data(), response.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(response.size());
+        }
+
+        void serve(int fd)
+        {
+            if (!handshake(fd))
+            {
+                return;
+            }
+            ++_handshakes;
+            std::vector<uint8_t> payload;
+            uint8_t header[14];
+            while (readFully(fd, header, 2))
+            {
+                const int opcode = header[0] & 0x0F;
+                uint64_t length = header[1] & 0x7F;
+                if (length == 126)
+                {
+                    if (!readFully(fd, header + 2, 2))
+                    {
+                        break;
+                    }
+                    length = static_cast<uint64_t>(header[2]) << 8 | header[3];
+                }
+                else if (length == 127)
+                {
+                    if (!readFully(fd, header + 2, 8))
+                    {
+                        break;
+                    }
+                    length = 0;
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        length = length << 8 | header[2 + i];
+                    }
+                }
+                uint8_t mask[4] = {0, 0, 0, 0};
+                if ((header[1] & 0x80) != 0 && !readFully(fd, mask, 4))
+                {
+                    break;
+                }
+                if (payload.size() < length)
+                {
+                    payload.resize(static_cast<std::size_t>(length));
+                }
+                if (!readFully(fd, payload.data(), static_cast<std::size_t>(length)))
+                {
+                    break;
+                }
+                if (opcode == 0x8 && _answerClose)
+                {
+                    const uint8_t close[2] = {0x88, 0x00};
+                    ::send(fd, close, sizeof(close), MSG_NOSIGNAL);
+                    break;
+                }
+                if (opcode == 0x2 || opcode == 0x0)
+                {
+                    _binaryBytes += static_cast<std::size_t>(length);
+                }
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            _connections.erase(std::remove(_connections.begin(), _connections.end(), fd), _connections.end());
+            ::close(fd);
+        }
+
+    private:
+        const bool _answerClose;
+        int _listenFd = -1;
+        int _port = 0;
+        std::atomic<bool> _running{true};
+        std::atomic<std::size_t> _binaryBytes{0};
+        std::atomic<std::size_t> _handshakes{0};
+        std::mutex _mutex;
+        std::vector<int> _connections;
+        std::vector<std::thread> _connectionThreads;
+        std::thread _acceptThread;
+    };
+}
@@ -0,0 +1,163 @@
+/**
+ * Frequency response of the AudioConverter resampler: tones are streamed through it in 10 ms chunks and the
+ * level of the output at the expected (or aliased) frequency is measured. Tones in the passband must come out
+ * unchanged, tones above the output Nyquist frequency (and the images of an upsampled input) must not alias
+ * back into the output band.
+ * Usage: resampler_response
+ */
+#include "gladiapp_audio.hpp"
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace gladiapp::v2::audio;
+
+namespace
+{
+    int failures = 0;
+
+    constexpr double PI = 3.14159265358979323846;
+
+    /**
+     * Passband tones must stay within this many dB of their input level.
+     */
+    constexpr double PASSBAND_TOLERANCE_DB = 0.5;
+
+    /**
+     * Aliases and images must be at least this far below the input level.
+     */
+    constexpr double STOPBAND_ATTENUATION_DB = -60.0;
+
+    /**
+     * Output frequency a tone of the input lands on once sampled at outputRate.
+     */
+    double aliasOf(double frequency, int outputRate)
+    {
+        double folded = std::fmod(frequency, static_cast<double>(outputRate));
+        return folded > outputRate / 2.0 ? outputRate - folded : folded;
+    }
+
+    /**
+     * Streams one second of a full-scale tone and returns the output level at probeFrequency, in dB relative
+     * to the input, measured with a Hann-windowed DFT bin once the filter has settled.
+     */
+    double levelDb(int inputRate, int outputRate, double toneFrequency, double probeFrequency)
+    {
+        AudioFormat format;
+        format.sampleRate = outputRate;
+        format.bitDepth = 32;
+        AudioConverter converter(inputRate, 1, format);
+
+        const std::size_t chunkFrames = static_cast<std::size_t>(inputRate / 100);
+        std::vector<float> chunk(chunkFrames);
+        std::vector<uint8_t> encoded;
+        std::vector<double> output;
+        for (std::size_t start = 0; start < static_cast<std::size_t>(inputRate); start += chunkFrames)
+        {
+            for (std::size_t i = 0; i < chunkFrames; ++i)
+            {
+                chunk[i] = static_cast<float>(std::sin(2.0 * PI * toneFrequency * static_cast<double>(start + i) / inputRate));
+            }
+            encoded.clear();
+            converter.convert(chunk.data(), chunkFrames, encoded);
+            for (std::size_t offset = 0; offset + 4 <= encoded.size(); offset += 4)
+            {
+                uint32_t bits = static_cast<uint32_t>(encoded[offset]) | static_cast<uint32_t>(encoded[offset + 1]) << 8 |
+                                static_cast<uint32_t>(encoded[offset + 2]) << 16 | static_cast<uint32_t>(encoded[offset + 3]) << 24;
+                output.push_back(static_cast<int32_t>(bits) / 2147483648.0);
+            }
+        }
+
+        // skip the first 100 ms, the history starts silent
+        const std::size_t skip = static_cast<std::size_t>(outputRate / 10);
+        const std::size_t length = output.size() - skip;
+        std::complex<double> bin = 0.0;
+        double windowSum = 0.0;
+        for (std::size_t n = 0; n < length; ++n)
+        {
+            double window = 0.5 - 0.5 * std::cos(2.0 * PI * static_cast<double>(n) / static_cast<double>(length - 1));
+            bin += output[skip + n] * window * std::polar(1.0, -2.0 * PI * probeFrequency * static_cast<double>(n) / outputRate);
+            windowSum += window;
+        }
+        double amplitude = 2.0 * std::abs(bin) / windowSum;
+        return 20.0 * std::log10(std::max(amplitude, 1e-12));
+    }
+
+    void checkPassband(int inputRate, int outputRate, double frequency)
+    {
+        double level = levelDb(inputRate, outputRate, frequency, frequency);
+        if (std::abs(level) > PASSBAND_TOLERANCE_DB)
+        {
+            std::cerr << "failed: " << inputRate << " -> " << outputRate << " Hz, " << frequency
+                      << " Hz passes at " << level << " dB" << std::endl;
+            ++failures;
+        }
+    }
+
+    void checkStopband(int inputRate, int outputRate, double frequency)
+    {
+        double alias = aliasOf(frequency, outputRate);
+        double level = levelDb(inputRate, outputRate, frequency, alias);
+        if (level > STOPBAND_ATTENUATION_DB)
+        {
+            std::cerr << "failed: " << inputRate << " -> " << outputRate << " Hz, " << frequency
+                      << " Hz aliases to " << alias << " Hz at " << level << " dB" << std::endl;
+            ++failures;
+        }
+    }
+
+    void checkImage(int inputRate, int outputRate, double frequency)
+    {
+        double image = inputRate - frequency;
+        double level = levelDb(inputRate, outputRate, frequency, image);
+        if (level > STOPBAND_ATTENUATION_DB)
+        {
+            std::cerr << "failed: " << inputRate << " -> " << outputRate << " Hz, " << frequency
+                      << " Hz leaves an image at " << image << " Hz at " << level << " dB" << std::endl;
+            ++failures;
+        }
+    }
+}
+
+int main()
+{
+    // decimation by an integer factor
+    checkPassband(48000, 16000, 1000.0);
+    checkPassband(48000, 16000, 6000.0);
+    checkStopband(48000, 16000, 8200.0);
+    checkStopband(48000, 16000, 9000.0);
+    checkStopband(48000, 16000, 10000.0);
+    checkStopband(48000, 16000, 20000.0);
+
+    checkPassband(48000, 8000, 300.0);
+    checkPassband(48000, 8000, 3000.0);
+    checkStopband(48000, 8000, 4200.0);
+    checkStopband(48000, 8000, 5000.0);
+    checkStopband(48000, 8000, 12000.0);
+
+    checkPassband(16000, 8000, 3000.0);
+    checkStopband(16000, 8000, 5000.0);
+
+    // fractional ratio
+    checkPassband(44100, 16000, 1000.0);
+    checkPassband(44100, 16000, 6000.0);
+    checkStopband(44100, 16000, 8500.0);
+    checkStopband(44100, 16000, 15000.0);
+
+    // interpolation, the images of the input must be removed
+    checkPassband(8000, 16000, 3000.0);
+    checkImage(8000, 16000, 3000.0);
+    checkPassband(22050, 48000, 9000.0);
+    checkImage(22050, 48000, 9000.0);
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " resampler response check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "resampler passband and stopband within bounds" << std::endl;
+    return 0;
+}
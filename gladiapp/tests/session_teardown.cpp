@@ -0,0 +1,82 @@
+/**
+ * Teardown latency of live sessions: idle sessions connected to a loopback WebSocket listener that never
+ * answers the close frame are destroyed one by one. Each destructor must return well within the former 200 ms
+ * polling period of the reception thread, with a dedicated reception thread per session and with a shared
+ * reactor.
+ * Usage: session_teardown
+ */
+#include "gladiapp_ws.hpp"
+#include "impl/ws_reactor.hpp"
+#include "loopback_websocket_server.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gladiapp::v2::ws;
+
+namespace
+{
+    int failures = 0;
+
+    constexpr std::size_t SESSION_COUNT = 10;
+    constexpr int TEARDOWN_LIMIT_MS = 50;
+
+    void check(const std::string &what, bool condition)
+    {
+        if (!condition)
+        {
+            std::cerr << "failed: " << what << std::endl;
+            ++failures;
+        }
+    }
+
+    void measure(const std::string &mode, std::size_t reactorThreads)
+    {
+        // nothing wakes the reception thread but the session itself
+        gladiapp_tests::LoopbackWebsocketServer server(false);
+        std::shared_ptr<WebsocketReactor> reactor = reactorThreads > 0 ? std::make_shared<WebsocketReactor>(reactorThreads) : nullptr;
+        WebsocketClientOptions options;
+        options.reactorThreads = reactorThreads;
+        response::InitializeSessionResponse initResponse;
+        initResponse.url = server.url();
+
+        std::vector<std::unique_ptr<GladiaWebsocketClientSession>> sessions;
+        for (std::size_t i = 0; i < SESSION_COUNT; ++i)
+        {
+            initResponse.id = "teardown-" + std::to_string(i);
+            sessions.push_back(std::make_unique<GladiaWebsocketClientSession>(initResponse, "", reactor, options));
+            check(mode + ": session " + std::to_string(i) + " connected", sessions.back()->connectAndStart());
+        }
+        // let every reception thread (or the reactor) settle into its wait
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+        double slowestMs = 0.0;
+        for (auto &session : sessions)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            session.reset();
+            slowestMs = std::max(slowestMs, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::cout << mode << ": slowest of " << SESSION_COUNT << " teardowns took " << slowestMs << " ms" << std::endl;
+        check(mode + ": teardown within " + std::to_string(TEARDOWN_LIMIT_MS) + " ms", slowestMs < TEARDOWN_LIMIT_MS);
+    }
+}
+
+int main()
+{
+    measure("reception threads", 0);
+#ifdef __linux__
+    measure("reactor", 2);
+#endif
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * Differential test of the simdjson backend: the same fixture is parsed with simdjson on-demand
+ * and with nlohmann alone, and the resulting structs are compared field by field.
+ * Usage: simdjson_parity <path to transcription_result.json>
+ */
+#include "gladiapp_rest_response.hpp"
+#include "gladiapp_ws_response.hpp"
+#include "impl/simdjson_result_parser.hpp"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace gladiapp::v2;
+
+namespace
+{
+    int failures = 0;
+
+    template <typename T>
+    void check(const std::string &field, const T &simd, const T &reference)
+    {
+        if (!(simd == reference))
+        {
+            std::cerr << "mismatch: " << field << std::endl;
+            ++failures;
+        }
+    }
+
+    void check(const std::string &field, bool condition)
+    {
+        if (!condition)
+        {
+            std::cerr << "failed: " << field << std::endl;
+            ++failures;
+        }
+    }
+
+    template <typename Word>
+    void compareWords(const std::string &path, const std::vector<Word> &simd, const std::vector<Word> &reference)
+    {
+        check(path + ".size", simd.size(), reference.size());
+        for (size_t i = 0; i < simd.size() && i < reference.size(); ++i)
+        {
+            const std::string wordPath = path + "[" + std::to_string(i) + "]";
+            check(wordPath + ".word", simd[i].word, reference[i].word);
+            check(wordPath + ".start", simd[i].start, reference[i].start);
+            check(wordPath + ".end", simd[i].end, reference[i].end);
+            check(wordPath + ".confidence", simd[i].confidence, reference[i].confidence);
+        }
+    }
+
+    template <typename Utterance>
+    void compareUtterances(const std::string &path, const std::vector<Utterance> &simd, const std::vector<Utterance> &reference)
+    {
+        check(path + ".size", simd.size(), reference.size());
+        for (size_t i = 0; i < simd.size() && i < reference.size(); ++i)
+        {
+            const std::string utterancePath = path + "[" + std::to_string(i) + "]";
+            check(utterancePath + ".language", simd[i].language, reference[i].language);
+            check(utterancePath + ".start", simd[i].start, reference[i].start);
+            check(utterancePath + ".end", simd[i].end, reference[i].end);
+            check(utterancePath + ".confidence", simd[i].confidence, reference[i].confidence);
+            check(utterancePath + ".channel", simd[i].channel, reference[i].channel);
+            check(utterancePath + ".text", simd[i].text, reference[i].text);
+            check(utterancePath + ".speaker", simd[i].speaker, reference[i].speaker);
+            compareWords(utterancePath + ".words", simd[i].words, reference[i].words);
+        }
+    }
+
+    template <typename Subtitle>
+    void compareSubtitles(const std::string &path, const std::vector<Subtitle> &simd, const std::vector<Subtitle> &reference)
+    {
+        check(path + ".size", simd.size(), reference.size());
+        for (size_t i = 0; i < simd.size() && i < reference.size(); ++i)
+        {
+            const std::string subtitlePath = path + "[" + std::to_string(i) + "]";
+            check(subtitlePath + ".format", simd[i].format, reference[i].format);
+            check(subtitlePath + ".subtitles", simd[i].subtitles, reference[i].subtitles);
+        }
+    }
+
+    template <typename Metadata>
+    void compareMetadata(const std::string &path, const Metadata &simd, const Metadata &reference)
+    {
+        check(path + ".audio_duration", simd.audio_duration, reference.audio_duration);
+        check(path + ".number_of_distinct_channels", simd.number_of_distinct_channels, reference.number_of_distinct_channels);
+        check(path + ".billing_time", simd.billing_time, reference.billing_time);
+        check(path + ".transcription_time", simd.transcription_time, reference.transcription_time);
+    }
+
+    void compareFile(const std::string &path, const response::TranscriptionFile &simd, const response::TranscriptionFile &reference)
+    {
+        check(path + ".id", simd.id, reference.id);
+        check(path + ".filename", simd.filename, reference.filename);
+        check(path + ".source", simd.source, reference.source);
+        check(path + ".duration", simd.duration, reference.duration);
+        check(path + ".number_of_channels", simd.number_of_channels, reference.number_of_channels);
+    }
+
+    void compare(const std::string &path, const response::TranscriptionResult &simd, const response::TranscriptionResult &reference)
+    {
+        check(path + ".id", simd.id, reference.id);
+        check(path + ".request_id", simd.request_id, reference.request_id);
+        check(path + ".version", simd.version, reference.version);
+        check(path + ".status", simd.status, reference.status);
+        check(path + ".created_at", simd.created_at, reference.created_at);
+        check(path + ".kind", simd.kind, reference.kind);
+        check(path + ".completed_at", simd.completed_at, reference.completed_at);
+        check(path + ".error_code", simd.error_code, reference.error_code);
+        check(path + ".file", simd.file.has_value(), reference.file.has_value());
+        if (simd.file && reference.file)
+        {
+            compareFile(path + ".file", *simd.file, *reference.file);
+        }
+        check(path + ".request_params", simd.request_params, reference.request_params);
+        check(path + ".custom_metadata", simd.custom_metadata, reference.custom_metadata);
+        compareMetadata(path + ".result.metadata", simd.result.metadata, reference.result.metadata);
+        const auto &simdResult = simd.result.result;
+        const auto &referenceResult = reference.result.result;
+        check(path + ".result.full_transcript", simdResult.full_transcript, referenceResult.full_transcript);
+        check(path + ".result.languages", simdResult.languages, referenceResult.languages);
+        compareUtterances(path + ".result.utterances", simdResult.utterances, referenceResult.utterances);
+        compareSubtitles(path + ".result.subtitles", simdResult.subtitles, referenceResult.subtitles);
+    }
+
+    void compare(const std::string &path, const ws::response::LiveTranscriptionResult &simd, const ws::response::LiveTranscriptionResult &reference)
+    {
+        check(path + ".id", simd.id, reference.id);
+        check(path + ".request_id", simd.request_id, reference.request_id);
+        check(path + ".status", simd.status, reference.status);
+        check(path + ".created_at", simd.created_at, reference.created_at);
+        check(path + ".completed_at", simd.completed_at, reference.completed_at);
+        check(path + ".kind", simd.kind, reference.kind);
+        check(path + ".custom_metadata", simd.custom_metadata, reference.custom_metadata);
+        check(path + ".error_code", simd.error_code, reference.error_code);
+        compareFile(path + ".file", simd.file, reference.file);
+        compareMetadata(path + ".result.metadata", simd.result.metadata, reference.result.metadata);
+        check(path + ".result.messages", simd.result.messages, reference.result.messages);
+        check(path + ".result.transcription", simd.result.transcription.has_value(), reference.result.transcription.has_value());
+        if (simd.result.transcription && reference.result.transcription)
+        {
+            const auto &simdTranscription = *simd.result.transcription;
+            const auto &referenceTranscription = *reference.result.transcription;
+            check(path + ".result.transcription.full_transcript", simdTranscription.full_transcript, referenceTranscription.full_transcript);
+            check(path + ".result.transcription.languages", simdTranscription.languages, referenceTranscription.languages);
+            compareUtterances(path + ".result.transcription.utterances", simdTranscription.utterances, referenceTranscription.utterances);
+            compareSubtitles(path + ".result.transcription.subtitles", simdTranscription.subtitles, referenceTranscription.subtitles);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <transcription_result.json>" << std::endl;
+        return 2;
+    }
+    std::ifstream fixtureFile(argv[1]);
+    if (!fixtureFile)
+    {
+        std::cerr << "cannot open " << argv[1] << std::endl;
+        return 2;
+    }
+    std::stringstream buffer;
+    buffer << fixtureFile.rdbuf();
+    const nlohmann::json fixture = nlohmann::json::parse(buffer.str());
+
+    // pre-recorded result
+    const std::string restBody = fixture.dump();
+    response::TranscriptionResult restSimd;
+    check("TranscriptionResult parsed by simdjson", simdjson_util::parse(restBody, restSimd));
+    compare("TranscriptionResult", restSimd, response::TranscriptionResult::fromJsonDocument(nlohmann::json::parse(restBody)));
+    check("TranscriptionResult has utterances", !restSimd.result.result.utterances.empty());
+
+    // paginated list of results
+    nlohmann::json list = {{"first", "https://api.gladia.io/v2/pre-recorded?offset=0&limit=2"},
+                           {"current", "https://api.gladia.io/v2/pre-recorded?offset=0&limit=2"},
+                           {"next", "https://api.gladia.io/v2/pre-recorded?offset=2&limit=2"},
+                           {"items", {fixture, fixture}}};
+    const std::string listBody = list.dump();
+    response::TranscriptionListResults listSimd;
+    check("TranscriptionListResults parsed by simdjson", simdjson_util::parse(listBody, listSimd));
+    const auto listReference = response::TranscriptionListResults::fromJsonDocument(nlohmann::json::parse(listBody));
+    check("TranscriptionListResults.first", listSimd.first, listReference.first);
+    check("TranscriptionListResults.current", listSimd.current, listReference.current);
+    check("TranscriptionListResults.next", listSimd.next, listReference.next);
+    check("TranscriptionListResults.items.size", listSimd.items.size(), listReference.items.size());
+    for (size_t i = 0; i < listSimd.items.size() && i < listReference.items.size(); ++i)
+    {
+        compare("TranscriptionListResults.items[" + std::to_string(i) + "]", listSimd.items[i], listReference.items[i]);
+    }
+
+    // live result
+    nlohmann::json live = fixture;
+    live["kind"] = "live";
+    const std::string liveBody = live.dump();
+    ws::response::LiveTranscriptionResult liveSimd;
+    check("LiveTranscriptionResult parsed by simdjson", simdjson_util::parse(liveBody, liveSimd));
+    compare("LiveTranscriptionResult", liveSimd, ws::response::LiveTranscriptionResult::fromJson(nlohmann::json::parse(liveBody)));
+    check("LiveTranscriptionResult has utterances", liveSimd.result.transcription && !liveSimd.result.transcription->utterances.empty());
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " field(s) differ between the simdjson and nlohmann backends" << std::endl;
+        return 1;
+    }
+    std::cout << "simdjson and nlohmann backends agree" << std::endl;
+    return 0;
+}